@@ -0,0 +1,225 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+
+#include <algorithm>
+#include "nmv-disassembly-cache.h"
+#include "nmv-address.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+NEMIVER_BEGIN_NAMESPACE (common)
+
+DisassemblyCache::DisassemblyCache ()
+{
+}
+
+/// Add the result of the disassembling of a range of addresses to
+/// the cache.
+///
+/// \param a_start the start of the range that was disassembled.
+///
+/// \param a_end the end of the range that was disassembled.  It's
+/// not included in the range.
+///
+/// \param a_instrs the instructions that resulted from the
+/// disassembling of the range.
+///
+/// \param a_pure_asm true if the instructions are pure asm, false
+/// if they are mixed with source code.  Only pure asm ranges are
+/// merged with the known ones.
+void
+DisassemblyCache::add (size_t a_start,
+                       size_t a_end,
+                       const std::list<Asm> &a_instrs,
+                       bool a_pure_asm)
+{
+    if (a_start >= a_end)
+        return;
+
+    if (!a_pure_asm) {
+        m_mixed_ranges[std::make_pair (a_start, a_end)] = a_instrs;
+        return;
+    }
+
+    // Merge [a_start, a_end) with the known ranges it overlaps or
+    // touches.
+    size_t start = a_start, end = a_end;
+    std::map<size_t, size_t>::iterator it = m_ranges.upper_bound (start);
+    if (it != m_ranges.begin ()) {
+        std::map<size_t, size_t>::iterator prev = it;
+        --prev;
+        if (prev->second >= start)
+            it = prev;
+    }
+    while (it != m_ranges.end () && it->first <= end) {
+        start = std::min (start, it->first);
+        end = std::max (end, it->second);
+        m_ranges.erase (it++);
+    }
+    m_ranges[start] = end;
+
+    std::list<Asm>::const_iterator i;
+    for (i = a_instrs.begin (); i != a_instrs.end (); ++i) {
+        if (i->empty ())
+            continue;
+        size_t addr = Address (i->instr ().address ());
+        std::pair<std::map<size_t, Asm>::iterator, bool> where =
+            m_instrs.insert (std::make_pair (addr, *i));
+        if (!where.second)
+            where.first->second = *i;
+    }
+}
+
+/// Look up the instructions of a range of addresses.
+///
+/// \param a_start the start of the range to look up.
+///
+/// \param a_end the end of the range to look up.  It's not included
+/// in the range.
+///
+/// \param a_pure_asm true if pure asm instructions are wanted, false
+/// if instructions mixed with source code are wanted.  The latter
+/// are only found for a range that was added as is.
+///
+/// \param a_info out parameter.  Set to the start and end addresses
+/// of the instructions found.
+///
+/// \param a_instrs out parameter.  Set to the instructions found.
+///
+/// \return true if the whole range was disassembled already, and
+/// contains instructions.
+bool
+DisassemblyCache::lookup (size_t a_start,
+                          size_t a_end,
+                          bool a_pure_asm,
+                          DisassembleInfo &a_info,
+                          std::list<Asm> &a_instrs) const
+{
+    if (a_start >= a_end)
+        return false;
+
+    std::list<Asm> instrs;
+    if (!a_pure_asm) {
+        MixedRanges::const_iterator r =
+            m_mixed_ranges.find (std::make_pair (a_start, a_end));
+        if (r == m_mixed_ranges.end ())
+            return false;
+        instrs = r->second;
+    } else if (!lookup_pure_asm (a_start, a_end, instrs)) {
+        return false;
+    }
+    if (instrs.empty ())
+        return false;
+
+    a_info.start_address (instrs.front ().instr ().address ());
+    a_info.end_address (instrs.back ().instr ().address ());
+    a_instrs.swap (instrs);
+    return true;
+}
+
+/// Look up the pure asm instructions of a range of addresses.
+///
+/// \param a_start the start of the range to look up.
+///
+/// \param a_end the end of the range to look up.  It's not included
+/// in the range.
+///
+/// \param a_instrs out parameter.  Set to the instructions found.
+///
+/// \return true if the whole range was disassembled already.
+bool
+DisassemblyCache::lookup_pure_asm (size_t a_start,
+                                   size_t a_end,
+                                   std::list<Asm> &a_instrs) const
+{
+    if (m_ranges.empty ())
+        return false;
+
+    std::map<size_t, size_t>::const_iterator it =
+        m_ranges.upper_bound (a_start);
+    if (it == m_ranges.begin ())
+        return false;
+    --it;
+    if (it->second < a_end)
+        return false;
+
+    std::map<size_t, Asm>::const_iterator i;
+    for (i = m_instrs.lower_bound (a_start);
+         i != m_instrs.end () && i->first < a_end;
+         ++i)
+        a_instrs.push_back (i->second);
+    return true;
+}
+
+/// Forget about the known ranges that overlap a given range of
+/// addresses, e.g because the memory there was written to.
+///
+/// \param a_start the start of the range to consider.
+///
+/// \param a_end the end of the range to consider.  It's not included
+/// in the range.
+void
+DisassemblyCache::invalidate (size_t a_start, size_t a_end)
+{
+    std::map<size_t, size_t>::iterator it = m_ranges.upper_bound (a_start);
+    if (it != m_ranges.begin ()) {
+        std::map<size_t, size_t>::iterator prev = it;
+        --prev;
+        if (prev->second > a_start)
+            it = prev;
+    }
+    while (it != m_ranges.end () && it->first < a_end) {
+        m_instrs.erase (m_instrs.lower_bound (it->first),
+                        m_instrs.lower_bound (it->second));
+        m_ranges.erase (it++);
+    }
+
+    // The mixed ranges may overlap each other, so look at them all.
+    MixedRanges::iterator r = m_mixed_ranges.begin ();
+    while (r != m_mixed_ranges.end () && r->first.first < a_end) {
+        if (r->first.second > a_start)
+            m_mixed_ranges.erase (r++);
+        else
+            ++r;
+    }
+}
+
+/// Forget about everything that was disassembled.
+void
+DisassemblyCache::clear ()
+{
+    m_ranges.clear ();
+    m_instrs.clear ();
+    m_mixed_ranges.clear ();
+}
+
+/// \return true if nothing is known about the disassembled code.
+bool
+DisassemblyCache::empty () const
+{
+    return m_ranges.empty () && m_mixed_ranges.empty ();
+}
+
+NEMIVER_END_NAMESPACE (common)
+NEMIVER_END_NAMESPACE (nemiver)
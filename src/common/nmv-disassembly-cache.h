@@ -0,0 +1,92 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#ifndef __NMV_DISASSEMBLY_CACHE_H__
+#define __NMV_DISASSEMBLY_CACHE_H__
+
+#include <map>
+#include <list>
+#include "nmv-asm-instr.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+NEMIVER_BEGIN_NAMESPACE (common)
+
+/// A cache of the instructions disassembled from an inferior, keyed
+/// by address.
+///
+/// For pure asm, the cache remembers the address ranges that were
+/// disassembled, and merges them as new ranges are added.  A request
+/// for a range of addresses that is entirely contained in a known
+/// range can then be served without asking the debugger again.
+/// Instructions mixed with source come in blocks of source lines
+/// that can't be cut at any address, so the ranges disassembled that
+/// way are kept as they came, and only served again as a whole.
+///
+/// The cache doesn't know when the code of the inferior changes.  It
+/// is up to its owner to call invalidate or clear when, e.g, the
+/// inferior is re-run, shared libraries get loaded or unloaded,
+/// memory is written or the flavor of the disassembly changes.
+class NEMIVER_API DisassemblyCache {
+    // The ranges [start, end) of addresses that were disassembled in
+    // pure asm, keyed by their start.  These ranges never overlap or
+    // touch.
+    std::map<size_t, size_t> m_ranges;
+    // The pure asm instructions, keyed by their address.
+    std::map<size_t, Asm> m_instrs;
+    // The instructions of the ranges disassembled mixed with
+    // source, keyed by the whole range [start, end).
+    typedef std::map<std::pair<size_t, size_t>, std::list<Asm> >
+                                                        MixedRanges;
+    MixedRanges m_mixed_ranges;
+
+    bool lookup_pure_asm (size_t a_start,
+                          size_t a_end,
+                          std::list<Asm> &a_instrs) const;
+
+public:
+
+    DisassemblyCache ();
+
+    void add (size_t a_start,
+              size_t a_end,
+              const std::list<Asm> &a_instrs,
+              bool a_pure_asm);
+
+    bool lookup (size_t a_start,
+                 size_t a_end,
+                 bool a_pure_asm,
+                 DisassembleInfo &a_info,
+                 std::list<Asm> &a_instrs) const;
+
+    void invalidate (size_t a_start, size_t a_end);
+
+    void clear ();
+
+    bool empty () const;
+};//end class DisassemblyCache
+
+NEMIVER_END_NAMESPACE (common)
+NEMIVER_END_NAMESPACE (nemiver)
+
+#endif //__NMV_DISASSEMBLY_CACHE_H__
@@ -43,7 +43,13 @@ class UString;
 class NEMIVER_API Object {
     friend struct ObjectPriv;
 
+    long m_refcount;
+    bool m_refcount_enabled;
+
 protected:
+    // Holds the objects attached to this one.  It is only allocated
+    // upon the first call to attach_object, as most objects never
+    // have anything attached to them.
     SafePtr<ObjectPriv> m_priv;
 
 public:
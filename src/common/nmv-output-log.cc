@@ -0,0 +1,434 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#include "config.h"
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <glibmm/fileutils.h>
+#include "nmv-output-log.h"
+#include "nmv-exception.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+NEMIVER_BEGIN_NAMESPACE (common)
+
+/// Create the file the output is spooled to.  It's unlinked as soon
+/// as it's created, so that it goes away with the process.
+///
+/// \return the file descriptor of the file, or -1 upon failure.
+static int
+open_spool_file ()
+{
+    std::string path;
+    int fd = -1;
+    try {
+        fd = Glib::file_open_tmp (path, "nemiver-output");
+    } catch (Glib::FileError &e) {
+        LOG_ERROR ("could not create output log: " << e.what ());
+        return -1;
+    }
+    unlink (path.c_str ());
+    return fd;
+}
+
+/// Write a buffer to a file descriptor, retrying on interruptions.
+///
+/// \return the number of bytes written.
+static size_t
+write_all (int a_fd, const char *a_data, size_t a_len)
+{
+    size_t written = 0;
+    while (written < a_len) {
+        ssize_t n = write (a_fd, a_data + written, a_len - written);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            LOG_ERROR ("could not write to output log: "
+                       << strerror (errno));
+            break;
+        }
+        written += n;
+    }
+    return written;
+}
+
+struct OutputLog::Priv {
+    // The file the output is spooled to.
+    int fd;
+    size_t size;
+    size_t max_size;
+    // The offset of the beginning of each line of the log.  The
+    // first line always begins at offset 0.
+    std::vector<size_t> line_offsets;
+    // The size of the log at each stop of the inferior.
+    std::vector<size_t> stop_offsets;
+    // What was discarded from the beginning of the log so far.
+    size_t num_discarded_bytes;
+    size_t num_discarded_stops;
+    // The read-only memory mapping of the file, and its size.
+    mutable void *map;
+    mutable size_t map_size;
+
+    Priv (size_t a_max_size) :
+        fd (-1),
+        size (0),
+        max_size (a_max_size),
+        num_discarded_bytes (0),
+        num_discarded_stops (0),
+        map (0),
+        map_size (0)
+    {
+        line_offsets.push_back (0);
+    }
+
+    ~Priv ()
+    {
+        unmap ();
+        if (fd >= 0) {
+            close (fd);
+            fd = -1;
+        }
+    }
+
+    bool ensure_open ()
+    {
+        if (fd >= 0)
+            return true;
+        fd = open_spool_file ();
+        return fd >= 0;
+    }
+
+    void unmap () const
+    {
+        if (map) {
+            munmap (map, map_size);
+            map = 0;
+            map_size = 0;
+        }
+    }
+
+    /// \return a pointer to the content of the log, or NULL if the
+    /// log is empty or could not be mapped.
+    const char* data () const
+    {
+        if (map && map_size == size)
+            return static_cast<const char*> (map);
+
+        unmap ();
+        if (fd < 0 || size == 0)
+            return 0;
+
+        void *m = mmap (0, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (m == MAP_FAILED) {
+            LOG_ERROR ("could not map output log: " << strerror (errno));
+            return 0;
+        }
+        map = m;
+        map_size = size;
+        return static_cast<const char*> (map);
+    }
+
+    /// Discard the oldest part of the log, so that about half of
+    /// max_size bytes are left, and rebase the offsets on the
+    /// beginning of what is left.  Whole lines are discarded
+    /// whenever possible.
+    void trim ()
+    {
+        size_t from = size - max_size / 2;
+        std::vector<size_t>::iterator line =
+            std::lower_bound (line_offsets.begin (),
+                              line_offsets.end (),
+                              from);
+        if (line != line_offsets.end ())
+            from = *line;
+
+        const char *content = data ();
+        if (!content)
+            return;
+        int new_fd = open_spool_file ();
+        if (new_fd < 0)
+            return;
+        if (write_all (new_fd, content + from, size - from) != size - from) {
+            close (new_fd);
+            return;
+        }
+        unmap ();
+        close (fd);
+        fd = new_fd;
+
+        line_offsets.erase (line_offsets.begin (), line);
+        for (line = line_offsets.begin (); line != line_offsets.end (); ++line)
+            *line -= from;
+        if (line_offsets.empty () || line_offsets.front () != 0)
+            line_offsets.insert (line_offsets.begin (), 0);
+
+        std::vector<size_t>::iterator stop =
+            std::lower_bound (stop_offsets.begin (),
+                              stop_offsets.end (),
+                              from);
+        num_discarded_stops += stop - stop_offsets.begin ();
+        stop_offsets.erase (stop_offsets.begin (), stop);
+        for (stop = stop_offsets.begin (); stop != stop_offsets.end (); ++stop)
+            *stop -= from;
+
+        num_discarded_bytes += from;
+        size -= from;
+    }
+};//end struct OutputLog::Priv
+
+/// \param a_max_size the size past which the oldest part of the log
+/// is discarded.
+OutputLog::OutputLog (size_t a_max_size) :
+    m_priv (new Priv (a_max_size))
+{
+}
+
+OutputLog::~OutputLog ()
+{
+}
+
+/// Append some output to the log.
+///
+/// \param a_data the output to append.
+///
+/// \param a_len the size of a_data.
+///
+/// \return true upon successful completion, false otherwise.
+bool
+OutputLog::append (const char *a_data, size_t a_len)
+{
+    THROW_IF_FAIL (m_priv);
+
+    if (!a_data || !a_len)
+        return true;
+    if (!m_priv->ensure_open ())
+        return false;
+
+    size_t written = write_all (m_priv->fd, a_data, a_len);
+
+    // Index the beginning of the lines that were written.
+    const char *cur = a_data, *end = a_data + written;
+    while (cur < end
+           && (cur = static_cast<const char*>
+                            (memchr (cur, '\n', end - cur))) != 0) {
+        ++cur;
+        m_priv->line_offsets.push_back (m_priv->size + (cur - a_data));
+    }
+    m_priv->size += written;
+    if (m_priv->size > m_priv->max_size)
+        m_priv->trim ();
+    return written == a_len;
+}
+
+/// \return the size of the log, in bytes.
+size_t
+OutputLog::size () const
+{
+    THROW_IF_FAIL (m_priv);
+    return m_priv->size;
+}
+
+/// \return the number of bytes discarded from the beginning of the
+/// log since it was created or last cleared.  Adding it to an offset
+/// in the log gives an offset that is not affected by later
+/// discards.
+size_t
+OutputLog::num_discarded_bytes () const
+{
+    THROW_IF_FAIL (m_priv);
+    return m_priv->num_discarded_bytes;
+}
+
+/// \return the number of lines of the log.  The last line is the
+/// one that is being written to; it can be empty.
+size_t
+OutputLog::num_lines () const
+{
+    THROW_IF_FAIL (m_priv);
+    return m_priv->line_offsets.size ();
+}
+
+/// \param a_line a line number, starting from 0.
+///
+/// \return the offset of the beginning of line a_line, or the size
+/// of the log if there is no such line.
+size_t
+OutputLog::line_offset (size_t a_line) const
+{
+    THROW_IF_FAIL (m_priv);
+    if (a_line >= m_priv->line_offsets.size ())
+        return m_priv->size;
+    return m_priv->line_offsets[a_line];
+}
+
+/// \param a_offset an offset in the log.
+///
+/// \return the number of the line that contains a_offset.
+size_t
+OutputLog::offset_to_line (size_t a_offset) const
+{
+    THROW_IF_FAIL (m_priv);
+    std::vector<size_t>::const_iterator it =
+        std::upper_bound (m_priv->line_offsets.begin (),
+                          m_priv->line_offsets.end (),
+                          a_offset);
+    return (it - m_priv->line_offsets.begin ()) - 1;
+}
+
+/// Read a part of the log.
+///
+/// \param a_offset the offset to start reading from.
+///
+/// \param a_len the number of bytes to read.  Fewer bytes are read
+/// if the log ends before.
+///
+/// \param a_result out parameter.  Set to the bytes read.
+///
+/// \return true upon successful completion, false otherwise.
+bool
+OutputLog::read (size_t a_offset, size_t a_len, std::string &a_result) const
+{
+    THROW_IF_FAIL (m_priv);
+
+    a_result.clear ();
+    if (a_offset >= m_priv->size)
+        return a_offset == m_priv->size;
+    a_len = std::min (a_len, m_priv->size - a_offset);
+
+    const char *data = m_priv->data ();
+    if (!data)
+        return false;
+    a_result.assign (data + a_offset, a_len);
+    return true;
+}
+
+/// Look for a piece of text in the log.
+///
+/// \param a_text the text to look for.
+///
+/// \param a_from_line the number of the line to start looking from.
+///
+/// \param a_line out parameter.  Set to the number of the first
+/// line containing a_text, starting from a_from_line.
+///
+/// \return true if a_text was found, false otherwise.
+bool
+OutputLog::find (const std::string &a_text,
+                 size_t a_from_line,
+                 size_t &a_line) const
+{
+    THROW_IF_FAIL (m_priv);
+
+    if (a_text.empty ())
+        return false;
+    const char *data = m_priv->data ();
+    if (!data)
+        return false;
+
+    const char *cur = data + line_offset (a_from_line);
+    const char *end = data + m_priv->size;
+    size_t len = a_text.size ();
+    while (static_cast<size_t> (end - cur) >= len
+           && (cur = static_cast<const char*>
+                          (memchr (cur, a_text[0], end - cur))) != 0) {
+        if (static_cast<size_t> (end - cur) < len)
+            break;
+        if (!memcmp (cur, a_text.data (), len)) {
+            a_line = offset_to_line (cur - data);
+            return true;
+        }
+        ++cur;
+    }
+    return false;
+}
+
+/// Record that the inferior stopped, so that the output it emits
+/// from now on can be found again with stop_to_line.
+///
+/// \return the number of the stop, starting from 0.
+size_t
+OutputLog::mark_stop ()
+{
+    THROW_IF_FAIL (m_priv);
+    m_priv->stop_offsets.push_back (m_priv->size);
+    return m_priv->num_discarded_stops + m_priv->stop_offsets.size () - 1;
+}
+
+/// \return the number of stops recorded by mark_stop, including
+/// the ones whose output was discarded since.
+size_t
+OutputLog::num_stops () const
+{
+    THROW_IF_FAIL (m_priv);
+    return m_priv->num_discarded_stops + m_priv->stop_offsets.size ();
+}
+
+/// Get the first line of the output emitted after a given stop.
+///
+/// \param a_stop the number of the stop, as returned by mark_stop.
+///
+/// \param a_line out parameter.  Set to the number of the line the
+/// output was at when the inferior stopped.
+///
+/// \return true if a_stop was found, false otherwise, e.g. if the
+/// output of that stop was discarded.
+bool
+OutputLog::stop_to_line (size_t a_stop, size_t &a_line) const
+{
+    THROW_IF_FAIL (m_priv);
+    if (a_stop < m_priv->num_discarded_stops)
+        return false;
+    a_stop -= m_priv->num_discarded_stops;
+    if (a_stop >= m_priv->stop_offsets.size ())
+        return false;
+    a_line = offset_to_line (m_priv->stop_offsets[a_stop]);
+    return true;
+}
+
+/// Forget about the whole content of the log.
+void
+OutputLog::clear ()
+{
+    THROW_IF_FAIL (m_priv);
+
+    m_priv->unmap ();
+    if (m_priv->fd >= 0) {
+        if (ftruncate (m_priv->fd, 0) || lseek (m_priv->fd, 0, SEEK_SET))
+            LOG_ERROR ("could not truncate output log: "
+                       << strerror (errno));
+    }
+    m_priv->size = 0;
+    m_priv->line_offsets.clear ();
+    m_priv->line_offsets.push_back (0);
+    m_priv->stop_offsets.clear ();
+    m_priv->num_discarded_bytes = 0;
+    m_priv->num_discarded_stops = 0;
+}
+
+NEMIVER_END_NAMESPACE (common)
+NEMIVER_END_NAMESPACE (nemiver)
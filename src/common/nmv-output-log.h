@@ -0,0 +1,95 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#ifndef __NMV_OUTPUT_LOG_H__
+#define __NMV_OUTPUT_LOG_H__
+
+#include <string>
+#include "nmv-object.h"
+#include "nmv-safe-ptr-utils.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+NEMIVER_BEGIN_NAMESPACE (common)
+
+/// An append-only log of the output of an inferior.
+///
+/// The output is spooled to an anonymous temporary file rather than
+/// kept in memory, so that chatty inferiors don't make the memory
+/// footprint grow without bounds.  The log maintains an index of the
+/// beginning of each line, and records the line at which the output
+/// was when the inferior stopped, so that the output emitted after a
+/// given stop can be found quickly.  Reading and searching the log
+/// is done through a read-only memory mapping of the file.
+///
+/// The log is capped: once it grows past its maximum size, its
+/// oldest part is discarded and the offsets and line numbers are
+/// rebased on what is left.  Stop numbers are never rebased.
+class NEMIVER_API OutputLog : public Object {
+    //non copyable
+    OutputLog (const OutputLog&);
+    OutputLog& operator= (const OutputLog&);
+
+    struct Priv;
+    SafePtr<Priv> m_priv;
+
+public:
+
+    enum {
+        DEFAULT_MAX_SIZE = 64 * 1024 * 1024
+    };
+
+    explicit OutputLog (size_t a_max_size = DEFAULT_MAX_SIZE);
+    virtual ~OutputLog ();
+
+    bool append (const char *a_data, size_t a_len);
+
+    size_t size () const;
+
+    size_t num_discarded_bytes () const;
+
+    size_t num_lines () const;
+
+    size_t line_offset (size_t a_line) const;
+
+    size_t offset_to_line (size_t a_offset) const;
+
+    bool read (size_t a_offset, size_t a_len, std::string &a_result) const;
+
+    bool find (const std::string &a_text,
+               size_t a_from_line,
+               size_t &a_line) const;
+
+    size_t mark_stop ();
+
+    size_t num_stops () const;
+
+    bool stop_to_line (size_t a_stop, size_t &a_line) const;
+
+    void clear ();
+};//end class OutputLog
+
+NEMIVER_END_NAMESPACE (common)
+NEMIVER_END_NAMESPACE (nemiver)
+
+#endif //__NMV_OUTPUT_LOG_H__
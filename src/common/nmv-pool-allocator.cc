@@ -0,0 +1,184 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+
+#include <map>
+#include <new>
+#include "nmv-pool-allocator.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+NEMIVER_BEGIN_NAMESPACE (common)
+
+/// \param a_block_size the size of the blocks handed out by the
+/// allocator.
+///
+/// \param a_blocks_per_chunk the number of blocks that are reserved
+/// at once whenever the allocator runs out of free blocks.
+PoolAllocator::PoolAllocator (size_t a_block_size,
+                              size_t a_blocks_per_chunk) :
+    m_block_size (a_block_size),
+    m_blocks_per_chunk (a_blocks_per_chunk ? a_blocks_per_chunk : 1),
+    m_free_list (0),
+    m_num_allocated (0),
+    m_release_pending (false),
+    m_on_release (0)
+{
+    // A free block must be able to hold the link to the next free
+    // block, and every block must be suitably aligned for any type.
+    size_t align = sizeof (void*) > sizeof (long double)
+        ? sizeof (void*)
+        : sizeof (long double);
+    if (m_block_size < sizeof (FreeBlock))
+        m_block_size = sizeof (FreeBlock);
+    m_block_size = (m_block_size + align - 1) / align * align;
+}
+
+PoolAllocator::~PoolAllocator ()
+{
+    release_chunks ();
+}
+
+/// \return the allocator shared by all the pooled classes which
+/// instances are a_block_size bytes long.  The allocator is created
+/// upon the first call and lives until the program exits.
+///
+/// This looks the allocator up in a map, so callers on a hot path
+/// should keep the returned reference around rather than calling
+/// this for each allocation.
+PoolAllocator&
+PoolAllocator::get (size_t a_block_size)
+{
+    static std::map<size_t, PoolAllocator*> allocators;
+
+    std::map<size_t, PoolAllocator*>::iterator it =
+        allocators.find (a_block_size);
+    if (it != allocators.end ())
+        return *it->second;
+    PoolAllocator *allocator = new PoolAllocator (a_block_size);
+    allocators[a_block_size] = allocator;
+    return *allocator;
+}
+
+/// Reserve a new chunk of blocks and thread them onto the free list.
+void
+PoolAllocator::add_chunk ()
+{
+    char *chunk =
+        static_cast<char*> (::operator new (m_block_size
+                                            * m_blocks_per_chunk));
+    m_chunks.push_back (chunk);
+    for (size_t i = m_blocks_per_chunk; i > 0; --i) {
+        FreeBlock *block =
+            reinterpret_cast<FreeBlock*> (chunk + (i - 1) * m_block_size);
+        block->next = m_free_list;
+        m_free_list = block;
+    }
+}
+
+/// Give all the chunks back to the system.  No block must be in use.
+void
+PoolAllocator::release_chunks ()
+{
+    std::vector<char*>::iterator it;
+    for (it = m_chunks.begin (); it != m_chunks.end (); ++it)
+        ::operator delete (*it);
+    m_chunks.clear ();
+    m_free_list = 0;
+}
+
+/// Allocate a block of memory.
+///
+/// \param a_size the size of the block to allocate.  If it is bigger
+/// than the blocks of this allocator, the block is allocated with the
+/// global operator new.
+///
+/// \return the new block.  Throws std::bad_alloc if the memory is
+/// exhausted.
+void*
+PoolAllocator::allocate (size_t a_size)
+{
+    if (a_size > m_block_size)
+        return ::operator new (a_size);
+
+    if (!m_free_list)
+        add_chunk ();
+    FreeBlock *block = m_free_list;
+    m_free_list = block->next;
+    ++m_num_allocated;
+    return block;
+}
+
+/// Give back a block allocated by PoolAllocator::allocate.
+///
+/// \param a_block the block to deallocate.  Can be nil.
+///
+/// \param a_size the size that was passed to PoolAllocator::allocate
+/// for that block.
+void
+PoolAllocator::deallocate (void *a_block, size_t a_size)
+{
+    if (!a_block)
+        return;
+    if (a_size > m_block_size) {
+        ::operator delete (a_block);
+        return;
+    }
+    FreeBlock *block = static_cast<FreeBlock*> (a_block);
+    block->next = m_free_list;
+    m_free_list = block;
+    if (--m_num_allocated == 0 && m_release_pending)
+        release_when_unused (m_on_release);
+}
+
+/// Give the memory reserved by the allocator back to the system as
+/// soon as no block is in use anymore, i.e, right away if no block is
+/// in use, or upon the deallocation of the last block in use
+/// otherwise.  The allocator remains usable; it reserves new chunks
+/// when needed.
+///
+/// \param a_on_release if non nil, a function to call once the
+/// memory has been released.
+void
+PoolAllocator::release_when_unused (void (*a_on_release) ())
+{
+    m_on_release = a_on_release;
+    m_release_pending = m_num_allocated != 0;
+    if (m_release_pending)
+        return;
+    release_chunks ();
+    m_on_release = 0;
+    if (a_on_release)
+        a_on_release ();
+}
+
+/// \return the number of blocks reserved by the allocator, be they
+/// in use or free.
+size_t
+PoolAllocator::num_reserved () const
+{
+    return m_chunks.size () * m_blocks_per_chunk;
+}
+
+NEMIVER_END_NAMESPACE (common)
+NEMIVER_END_NAMESPACE (nemiver)
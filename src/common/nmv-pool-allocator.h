@@ -0,0 +1,91 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#ifndef __NMV_POOL_ALLOCATOR_H__
+#define __NMV_POOL_ALLOCATOR_H__
+
+#include <cstddef>
+#include <vector>
+#include "nmv-api-macros.h"
+#include "nmv-namespace.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+NEMIVER_BEGIN_NAMESPACE (common)
+
+/// An allocator of fixed size blocks of memory.
+///
+/// Blocks are carved out of big chunks and recycled through a free
+/// list when they are deallocated, rather than being handed back to
+/// the system.  This is meant to back the operator new and operator
+/// delete of classes that are instantiated by the hundreds of
+/// thousands, like IDebugger::Variable, so that each instance
+/// doesn't pay for the bookkeeping of a separate heap allocation.
+///
+/// A request for a block which size is not the size the pool was
+/// created for is forwarded to the global operator new.  That can
+/// happen for an instance of a class deriving from the pooled class.
+///
+/// Like the rest of the engine, this is not thread safe.
+class NEMIVER_API PoolAllocator {
+    // non copyable
+    PoolAllocator (const PoolAllocator&);
+    PoolAllocator& operator= (const PoolAllocator&);
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    size_t m_block_size;
+    size_t m_blocks_per_chunk;
+    FreeBlock *m_free_list;
+    std::vector<char*> m_chunks;
+    size_t m_num_allocated;
+    bool m_release_pending;
+    void (*m_on_release) ();
+
+    void add_chunk ();
+    void release_chunks ();
+
+public:
+
+    PoolAllocator (size_t a_block_size,
+                   size_t a_blocks_per_chunk = 512);
+    ~PoolAllocator ();
+
+    static PoolAllocator& get (size_t a_block_size);
+
+    void* allocate (size_t a_size);
+    void deallocate (void *a_block, size_t a_size);
+
+    void release_when_unused (void (*a_on_release) () = 0);
+
+    size_t block_size () const {return m_block_size;}
+    size_t num_allocated () const {return m_num_allocated;}
+    size_t num_reserved () const;
+};//end class PoolAllocator
+
+NEMIVER_END_NAMESPACE (common)
+NEMIVER_END_NAMESPACE (nemiver)
+
+#endif //__NMV_POOL_ALLOCATOR_H__
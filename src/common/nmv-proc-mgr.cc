@@ -25,11 +25,15 @@
 
 #include "config.h"
 #include <algorithm>
+#include <map>
+#include <vector>
+#include <glibmm/thread.h>
 extern "C" {
 #include "glibtop.h"
 #include <glibtop/proclist.h>
 #include <glibtop/procargs.h>
 #include <glibtop/procuid.h>
+#include <glibtop/proctime.h>
 }
 
 #include "nmv-proc-mgr.h"
@@ -44,14 +48,39 @@ class ProcMgr : public IProcMgr {
     ProcMgr& operator= (const ProcMgr &);
 
     mutable list<Process> m_process_list;
+    // The processes seen by the last listing, keyed by pid.  This
+    // lets a listing skip reading the details of the processes that
+    // didn't change since then.
+    mutable std::map<pid_t, Process> m_process_cache;
+    // Protects m_process_cache and the state of the listing done by
+    // the worker thread, below.
+    mutable Glib::Mutex m_mutex;
+    // Serializes the calls to libgtop and getpwuid, which are not
+    // thread safe.
+    mutable Glib::Mutex m_libgtop_mutex;
+    Glib::Thread *m_listing_thread;
+    list<Process> m_listed_processes;
+    bool m_is_listing;
+    bool m_restart_listing;
+    bool m_stop_listing;
     friend class IProcMgr;
 
+    void get_all_pids (std::vector<pid_t> &a_pids) const;
+    bool get_process_start_time (pid_t a_pid,
+                                 unsigned long long &a_start_time) const;
+    bool get_process_cached (pid_t a_pid,
+                             Process &a_process,
+                             std::map<pid_t, Process> &a_seen) const;
+    void list_processes_in_thread ();
+
 protected:
     ProcMgr ();
 
 public:
     virtual ~ProcMgr ();
     const list<Process>& get_all_process_list () const ;
+    void start_listing_processes ();
+    bool fetch_listed_processes (list<Process> &a_processes);
     bool get_process_from_pid (pid_t a_pid,
                                Process &a_process) const;
     bool get_process_from_name (const UString &a_pname,
@@ -59,6 +88,10 @@ public:
                                 bool a_fuzzy_search) const;
 };//end class ProcMgr
 
+// The number of processes the worker thread of
+// ProcMgr::start_listing_processes hands over at once.
+static const unsigned PROCESS_LISTING_BATCH_SIZE = 128;
+
 struct LibgtopInit {
     LibgtopInit ()
     {
@@ -71,7 +104,11 @@ struct LibgtopInit {
     }
 };//end struct LibgtopInit
 
-ProcMgr::ProcMgr ()
+ProcMgr::ProcMgr () :
+    m_listing_thread (0),
+    m_is_listing (false),
+    m_restart_listing (false),
+    m_stop_listing (false)
 {
     //init libgtop.
     static  LibgtopInit s_init;
@@ -79,40 +116,200 @@ ProcMgr::ProcMgr ()
 
 ProcMgr::~ProcMgr ()
 {
+    {
+        Glib::Mutex::Lock lock (m_mutex);
+        m_stop_listing = true;
+    }
+    if (m_listing_thread) {
+        m_listing_thread->join ();
+        m_listing_thread = 0;
+    }
 }
 
-const list<ProcMgr::Process>&
-ProcMgr::get_all_process_list () const
+/// Get the pids of all the processes of the system.
+void
+ProcMgr::get_all_pids (std::vector<pid_t> &a_pids) const
 {
     glibtop_proclist buf_desc;
     memset (&buf_desc, 0, sizeof (buf_desc));
     pid_t *pids=0;
 
+    Glib::Mutex::Lock lock (m_libgtop_mutex);
+    //this is an ugly cast, but I am quite obliged
+    //since I have to support one version of glibtop_get_proclist()
+    //that returns an int* and one that returns pid_t*
+    pids = (pid_t*) glibtop_get_proclist (&buf_desc,
+                                           GLIBTOP_KERN_PROC_ALL, 0) ;
+    if (pids) {
+        a_pids.assign (pids, pids + buf_desc.number);
+        g_free (pids);
+        pids=0;
+    }
+}
+
+/// Get the start time of a process.
+///
+/// \param a_pid the pid of the process to consider.
+///
+/// \param a_start_time out parameter.  Set to the start time of the
+/// process.
+///
+/// \return true upon successful completion.
+bool
+ProcMgr::get_process_start_time (pid_t a_pid,
+                                 unsigned long long &a_start_time) const
+{
+    glibtop_proc_time proc_time;
+    memset (&proc_time, 0, sizeof (proc_time));
+
+    Glib::Mutex::Lock lock (m_libgtop_mutex);
+    glibtop_get_proc_time (&proc_time, a_pid);
+    if (!(proc_time.flags & (1L << GLIBTOP_PROC_TIME_START_TIME)))
+        return false;
+    a_start_time = proc_time.start_time;
+    return true;
+}
+
+/// Get the details of a process, from the cache of the last listing
+/// if the process there has the same start time.
+///
+/// \param a_pid the pid of the process to consider.
+///
+/// \param a_process out parameter.  Set to the process found.
+///
+/// \param a_seen the process found is added to this map.
+///
+/// \return true if the process was found.
+bool
+ProcMgr::get_process_cached (pid_t a_pid,
+                             Process &a_process,
+                             std::map<pid_t, Process> &a_seen) const
+{
+    unsigned long long start_time = 0;
+    if (get_process_start_time (a_pid, start_time)) {
+        Glib::Mutex::Lock lock (m_mutex);
+        std::map<pid_t, Process>::const_iterator it =
+            m_process_cache.find (a_pid);
+        if (it != m_process_cache.end ()
+            && it->second.start_time () == start_time) {
+            a_process = it->second;
+            a_seen[a_pid] = a_process;
+            return true;
+        }
+    }
+
+    if (!get_process_from_pid (a_pid, a_process))
+        return false;
+    a_seen[a_pid] = a_process;
+    return true;
+}
+
+const list<ProcMgr::Process>&
+ProcMgr::get_all_process_list () const
+{
+    std::vector<pid_t> pids;
+    std::map<pid_t, Process> seen;
+
     m_process_list.clear ();
+    get_all_pids (pids);
 
-    try {
-        //get the list of pids
-        //this is an ugly cast, but I am quite obliged
-        //since I have to support one version of glibtop_get_proclist()
-        //that returns an int* and one that returns pid_t*
-        pids = (pid_t*) glibtop_get_proclist (&buf_desc,
-                                               GLIBTOP_KERN_PROC_ALL, 0) ;
-
-        //get a couple of info about each pocess
-        for (unsigned i=0; i < buf_desc.number ; ++i) {
-            Process process;
-            bool got_process = get_process_from_pid (pids[i], process);
-            THROW_IF_FAIL (got_process);
+    //get a couple of info about each pocess.  Processes that
+    //vanished in the mean time are just skipped.
+    for (unsigned i = 0; i < pids.size (); ++i) {
+        Process process;
+        if (get_process_cached (pids[i], process, seen))
             m_process_list.push_back (process);
-        }
+    }
+
+    Glib::Mutex::Lock lock (m_mutex);
+    m_process_cache.swap (seen);
+    return m_process_list;
+}
+
+void
+ProcMgr::start_listing_processes ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
 
-    } catch (...) {
+    Glib::Mutex::Lock lock (m_mutex);
+
+    m_listed_processes.clear ();
+    if (m_is_listing) {
+        LOG_DD ("restarting the listing in progress");
+        m_restart_listing = true;
+        return;
     }
-    if (pids) {
-        g_free (pids);
-        pids=0;
+
+    // Reap the thread of the previous listing, which is done.
+    if (m_listing_thread) {
+        m_listing_thread->join ();
+        m_listing_thread = 0;
+    }
+
+    m_is_listing = true;
+    m_restart_listing = false;
+    m_listing_thread =
+        Glib::Thread::create (sigc::mem_fun
+                                (*this, &ProcMgr::list_processes_in_thread),
+                              true /*joinable*/);
+}
+
+bool
+ProcMgr::fetch_listed_processes (list<Process> &a_processes)
+{
+    Glib::Mutex::Lock lock (m_mutex);
+    a_processes.splice (a_processes.end (), m_listed_processes);
+    return !m_is_listing;
+}
+
+/// The body of the worker thread started by start_listing_processes.
+/// Found processes are handed over to fetch_listed_processes by
+/// batches of PROCESS_LISTING_BATCH_SIZE.
+void
+ProcMgr::list_processes_in_thread ()
+{
+    bool restart = true;
+    while (restart) {
+        restart = false;
+
+        std::vector<pid_t> pids;
+        std::map<pid_t, Process> seen;
+        list<Process> batch;
+        unsigned batch_size = 0;
+
+        get_all_pids (pids);
+        for (unsigned i = 0; i <= pids.size (); ++i) {
+            if (i < pids.size ()) {
+                // Exceptions must not escape the thread.
+                NEMIVER_TRY
+                Process process;
+                if (get_process_cached (pids[i], process, seen)) {
+                    batch.push_back (process);
+                    ++batch_size;
+                }
+                NEMIVER_CATCH_NOX
+                if (batch_size < PROCESS_LISTING_BATCH_SIZE)
+                    continue;
+            }
+
+            Glib::Mutex::Lock lock (m_mutex);
+            if (m_stop_listing) {
+                m_is_listing = false;
+                return;
+            }
+            if (m_restart_listing) {
+                m_restart_listing = false;
+                restart = true;
+                break;
+            }
+            m_listed_processes.splice (m_listed_processes.end (), batch);
+            batch_size = 0;
+            if (i == pids.size ()) {
+                m_process_cache.swap (seen);
+                m_is_listing = false;
+            }
+        }
     }
-    return m_process_list;
 }
 
 IProcMgrSafePtr
@@ -131,6 +328,12 @@ ProcMgr::get_process_from_pid (pid_t a_pid,
     LOG_DD ("a_pid: " << (int) a_pid);
     Process process (a_pid);
 
+    unsigned long long start_time = 0;
+    if (get_process_start_time (a_pid, start_time))
+        process.start_time (start_time);
+
+    Glib::Mutex::Lock lock (m_libgtop_mutex);
+
     //get the process arguments
     glibtop_proc_args process_args_desc;
     memset (&process_args_desc, 0, sizeof (process_args_desc));
@@ -61,6 +61,7 @@ public:
         unsigned int m_ppid;
         unsigned int m_uid;
         unsigned int m_euid;
+        unsigned long long m_start_time;
         UString m_user_name;
         list<UString> m_args;
 
@@ -70,7 +71,8 @@ public:
             m_pid (0),
             m_ppid (0),
             m_uid (0),
-            m_euid (0)
+            m_euid (0),
+            m_start_time (0)
         {}
 
         Process (unsigned int a_pid, const list<UString> a_args) :
@@ -78,6 +80,7 @@ public:
             m_ppid (0),
             m_uid (0),
             m_euid (0),
+            m_start_time (0),
             m_args (a_args)
         {}
 
@@ -85,7 +88,8 @@ public:
             m_pid (a_pid),
             m_ppid (0),
             m_uid (0),
-            m_euid (0)
+            m_euid (0),
+            m_start_time (0)
         {}
 
         unsigned int pid () const {return m_pid;}
@@ -100,6 +104,12 @@ public:
         unsigned int euid () const {return m_euid;}
         void euid (unsigned int a_euid) {m_euid = a_euid;}
 
+        /// The time at which the process was started, in the unit
+        /// used by the system.  Together with the pid, it identifies
+        /// a process, as pids are recycled.
+        unsigned long long start_time () const {return m_start_time;}
+        void start_time (unsigned long long a_time) {m_start_time = a_time;}
+
         const UString& user_name () const {return m_user_name;}
         void user_name (const UString &a_name) {m_user_name = a_name;}
 
@@ -122,6 +132,27 @@ public:
     virtual ~IProcMgr () {}
     static IProcMgrSafePtr create ();
     virtual const list<Process>& get_all_process_list () const = 0;
+
+    /// Start listing the processes of the system in a worker thread.
+    /// The processes found are then retrieved by batches using
+    /// fetch_listed_processes.  If a listing is already in progress,
+    /// it is restarted.
+    ///
+    /// Details of processes that were already seen by a previous
+    /// listing, and which start time didn't change, are not read
+    /// again.
+    virtual void start_listing_processes () = 0;
+
+    /// Move the processes found so far by the listing started by
+    /// start_listing_processes at the end of a_processes.
+    ///
+    /// \param a_processes out parameter.  The processes found since
+    /// the last call to this function are appended to it.
+    ///
+    /// \return true if the listing is complete, i.e, if there will be
+    /// no more processes to fetch.
+    virtual bool fetch_listed_processes (list<Process> &a_processes) = 0;
+
     virtual bool get_process_from_pid (pid_t a_pid,
                                        Process &a_process) const = 0;
     virtual bool get_process_from_name
@@ -25,6 +25,7 @@
 #include "config.h"
 #include <cstdlib>
 #include <cstring>
+#include <set>
 #include "nmv-str-utils.h"
 #include "nmv-safe-ptr-utils.h"
 #include "nmv-exception.h"
@@ -416,5 +417,39 @@ ensure_buffer_is_in_utf8 (const std::string &a_input,
     return true;
 }
 
+static std::set<UString>&
+get_interned_strings ()
+{
+    static std::set<UString> s_interned_strings;
+    return s_interned_strings;
+}
+
+/// Return the canonical instance of a string.
+///
+/// Strings that are equal share the same canonical instance, which
+/// lives until clear_interned_strings is called.  So rather than
+/// holding its own copy of a string that is bound to be repeated a
+/// lot -- like the name of a type -- an object can hold a pointer to
+/// the canonical instance returned by this function.
+///
+/// This is not thread safe.
+///
+/// \param a_string the string to intern.
+///
+/// \return the canonical instance of a_string.
+const UString&
+intern (const UString &a_string)
+{
+    return *get_interned_strings ().insert (a_string).first;
+}
+
+/// Destroy all the canonical instances returned by intern.  This
+/// must only be called when nothing refers to them anymore.
+void
+clear_interned_strings ()
+{
+    get_interned_strings ().clear ();
+}
+
 NEMIVER_END_NAMESPACE (str_utils)
 NEMIVER_END_NAMESPACE (nemiver)
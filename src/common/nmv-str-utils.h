@@ -91,6 +91,10 @@ bool is_buffer_valid_utf8 (const char *a_buffer, unsigned a_len);
 bool ensure_buffer_is_in_utf8 (const std::string &a_input,
 			       const std::list<std::string> &supported_encodings,
 			       UString &a_output);
+
+const UString& intern (const UString &a_string);
+
+void clear_interned_strings ();
 			       
 
 NEMIVER_END_NAMESPACE (str_utils)
@@ -58,9 +58,13 @@ extern const char* CONF_KEY_UPDATE_LOCAL_VARS_AT_EACH_STOP;
 extern const char* CONF_KEY_ASM_STYLE_PURE;
 extern const char* CONF_KEY_GDB_BINARY;
 extern const char* CONF_KEY_DEFAULT_NUM_ASM_INSTRS;
+extern const char* CONF_KEY_MAX_RESIDENT_SOURCE_BUFFERS;
 extern const char* CONF_KEY_FOLLOW_FORK_MODE;
 extern const char* CONF_KEY_DISASSEMBLY_FLAVOR;
 extern const char* CONF_KEY_PRETTY_PRINTING;
+extern const char* CONF_KEY_GDB_PROCESS_POOL;
+extern const char* CONF_KEY_GDB_NON_STOP_MODE;
+extern const char* CONF_KEY_TARGET_SIDE_CONDITIONS;
 extern const char* CONF_KEY_CONTEXT_PANE_LOCATION;
 extern const char* CONF_KEY_NEMIVER_CALLSTACK_EXPANSION_CHUNK;
 extern const char* CONF_KEY_DBG_PERSPECTIVE_LAYOUT;
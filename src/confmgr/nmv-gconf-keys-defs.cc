@@ -78,6 +78,8 @@ const char* CONF_KEY_ASM_STYLE_PURE =
                 "/apps/nemiver/dbgperspective/asm-style-pure";
 const char* CONF_KEY_DEFAULT_NUM_ASM_INSTRS =
                 "/apps/nemiver/dbgperspective/default-num-asm-instrs";
+const char* CONF_KEY_MAX_RESIDENT_SOURCE_BUFFERS =
+                "/apps/nemiver/dbgperspective/max-resident-source-buffers";
 const char* CONF_KEY_GDB_BINARY =
                 "/apps/nemiver/dbgperspective/gdb-binary";
 const char* CONF_KEY_FOLLOW_FORK_MODE =
@@ -86,6 +88,12 @@ const char* CONF_KEY_DISASSEMBLY_FLAVOR =
                 "/apps/nemiver/dbgperspective/disassembly-flavor";
 const char* CONF_KEY_PRETTY_PRINTING =
     "/apps/nemiver/dbgperspective/pretty-printing";
+const char* CONF_KEY_GDB_PROCESS_POOL =
+                "/apps/nemiver/dbgperspective/gdb-process-pool";
+const char* CONF_KEY_GDB_NON_STOP_MODE =
+                "/apps/nemiver/dbgperspective/gdb-non-stop-mode";
+const char* CONF_KEY_TARGET_SIDE_CONDITIONS =
+                "/apps/nemiver/dbgperspective/target-side-conditions";
 
 const char* CONF_KEY_CONTEXT_PANE_LOCATION =
                 "/apps/nemiver/dbgperspective/context-pane-location";
@@ -63,10 +63,15 @@ const char* CONF_KEY_ASM_STYLE_PURE = "asm-style-pure";
 const char* CONF_KEY_UPDATE_LOCAL_VARS_AT_EACH_STOP =
   "update-local-vars-at-each-stop";
 const char* CONF_KEY_DEFAULT_NUM_ASM_INSTRS = "default-num-asm-instrs";
+const char* CONF_KEY_MAX_RESIDENT_SOURCE_BUFFERS =
+  "max-resident-source-buffers";
 const char* CONF_KEY_GDB_BINARY = "gdb-binary";
 const char* CONF_KEY_FOLLOW_FORK_MODE = "follow-fork-mode";
 const char* CONF_KEY_DISASSEMBLY_FLAVOR = "disassembly-flavor";
 const char* CONF_KEY_PRETTY_PRINTING = "pretty-printing";
+const char* CONF_KEY_GDB_PROCESS_POOL = "gdb-process-pool";
+const char* CONF_KEY_GDB_NON_STOP_MODE = "gdb-non-stop-mode";
+const char* CONF_KEY_TARGET_SIDE_CONDITIONS = "target-side-conditions";
 const char* CONF_KEY_CONTEXT_PANE_LOCATION = "context-pane-location";
 const char* CONF_KEY_NEMIVER_CALLSTACK_EXPANSION_CHUNK =
                 "callstack-expansion-chunk";
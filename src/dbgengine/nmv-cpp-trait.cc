@@ -26,6 +26,10 @@
 #define __NMV_CPP_TRAIT_H__
 
 #include "config.h"
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <string>
 #include "nmv-i-lang-trait.h"
 
 using nemiver::common::UString;
@@ -39,6 +43,11 @@ class CPPTrait : public ILangTrait {
     CPPTrait& operator= (const CPPTrait &);
 
     UString m_name;
+    // Keyed by the raw type string, to avoid the collation done by
+    // the comparison operators of UString.  Programs only have a
+    // bounded number of types, so this never needs to be trimmed.
+    typedef std::map<std::string, TypeDescriptor> TypeDescriptors;
+    mutable TypeDescriptors m_type_descriptors;
 
 public:
 
@@ -46,6 +55,7 @@ public:
     ~CPPTrait ();
     const UString& get_name () const;
     bool has_pointers () const;
+    const TypeDescriptor& get_type_descriptor (const UString &a_type) const;
     bool is_type_a_pointer (const UString &a_type) const;
     bool is_variable_compound (const IDebugger::VariableSafePtr a_var) const;
 };//end class CPPTrait
@@ -71,39 +81,194 @@ CPPTrait::has_pointers () const
 {
     return true;
 }
-bool
-CPPTrait::is_type_a_pointer (const UString &a_type) const
+static bool
+ends_with (const std::string &a_str, const char *a_suffix)
 {
-    LOG_FUNCTION_SCOPE_NORMAL_DD;
-    LOG_DD ("type: '" << a_type << "'");
+    std::string::size_type len = strlen (a_suffix);
+    return a_str.size () >= len
+           && !a_str.compare (a_str.size () - len, len, a_suffix);
+}
 
-    UString type (a_type);
-    type.chomp ();
-    if (type[type.size () - 1] == '*') {
-        LOG_DD ("type is a pointer");
-        return true;
+static bool
+starts_with (const std::string &a_str, const char *a_prefix)
+{
+    return !a_str.compare (0, strlen (a_prefix), a_prefix);
+}
+
+/// Strip the blanks and the cv-qualifiers at both ends of a type
+/// string.
+static void
+strip_cv_qualifiers (std::string &a_type)
+{
+    static const char *qualifiers[] = {"const", "volatile", 0};
+    bool stripped = true;
+    while (stripped) {
+        stripped = false;
+        std::string::size_type first = a_type.find_first_not_of (" \t\n");
+        std::string::size_type last = a_type.find_last_not_of (" \t\n");
+        if (first == std::string::npos) {
+            a_type.clear ();
+            return;
+        }
+        a_type = a_type.substr (first, last - first + 1);
+        for (const char **q = qualifiers; *q; ++q) {
+            std::string::size_type len = strlen (*q);
+            if (a_type.size () <= len)
+                continue;
+            if (starts_with (a_type, *q) && isspace (a_type[len])) {
+                a_type.erase (0, len);
+                stripped = true;
+            } else if (ends_with (a_type, *q)) {
+                char c = a_type[a_type.size () - len - 1];
+                if (isspace (c) || c == '*' || c == '&') {
+                    a_type.erase (a_type.size () - len);
+                    stripped = true;
+                }
+            }
+        }
     }
-    if (type.size () < 8) {
-        LOG_DD ("type is not a pointer");
-        return false;
+}
+
+/// Look for the parenthesized abstract declarator of a type, like
+/// the "(*)" of "void (*)(int)" or the "(&)" of "int (&)[3]".  The
+/// last operator of that declarator is the one that applies to the
+/// whole type.
+///
+/// \return '*' if the type is a pointer, including a pointer to
+/// member, '&' if it is a reference, or zero if the type has no such
+/// declarator.
+static char
+parenthesized_declarator_kind (const std::string &a_type)
+{
+    std::string::size_type open = a_type.find ('(');
+    while (open != std::string::npos) {
+        std::string::size_type close = a_type.find (')', open);
+        if (close == std::string::npos)
+            break;
+        std::string declarator = a_type.substr (open + 1, close - open - 1);
+        strip_cv_qualifiers (declarator);
+        // Tell a declarator like "*", "&" or "Foo::*" from a list of
+        // parameters like "int *".
+        if (!declarator.empty ()
+            && (declarator[0] == '*'
+                || declarator[0] == '&'
+                || declarator.find ("::*") != std::string::npos)) {
+            char last = declarator[declarator.size () - 1];
+            if (last == '*' || last == '&')
+                return last;
+        }
+        open = a_type.find ('(', close);
     }
-    UString::size_type i = type.size () - 7;
-    if (!a_type.compare (i, 7, "* const")) {
-        LOG_DD ("type is a pointer");
-        return true;
+    return 0;
+}
+
+/// Classify a C++ type string, as reported by GDB.
+static void
+classify_type (const std::string &a_type, ILangTrait::TypeDescriptor &a_desc)
+{
+    static const char *containers[] = {
+        "std::vector<", "std::list<", "std::deque<", "std::map<",
+        "std::multimap<", "std::set<", "std::multiset<",
+        "std::unordered_map<", "std::unordered_set<",
+        "std::tr1::unordered_map<", "std::tr1::unordered_set<",
+        "std::stack<", "std::queue<", "std::priority_queue<",
+        "std::bitset<", 0
+    };
+
+    std::string type (a_type);
+    strip_cv_qualifiers (type);
+    if (type.empty ())
+        return;
+
+    switch (type[type.size () - 1]) {
+        case '&':
+            a_desc.is_reference (true);
+            return;
+        case '*':
+            a_desc.is_pointer (true);
+            return;
+        case ']':
+        case ')':
+            // A reference or a pointer to an array or to a function,
+            // e.g. "int (&)[3]" or "void (*)(int)", is not an array.
+            switch (parenthesized_declarator_kind (type)) {
+                case '&':
+                    a_desc.is_reference (true);
+                    return;
+                case '*':
+                    a_desc.is_pointer (true);
+                    return;
+                default:
+                    break;
+            }
+            if (type[type.size () - 1] == ']')
+                a_desc.is_array (true);
+            return;
+        default:
+            break;
+    }
+
+    for (const char **c = containers; *c; ++c) {
+        if (starts_with (type, *c)) {
+            a_desc.is_container (true);
+            a_desc.is_compound (true);
+            return;
+        }
     }
-    LOG_DD ("type is not a pointer");
-    return false;
+
+    // Do not take any template-id for an aggregate: std::string,
+    // std::atomic<int> or smart pointers have a scalar value that
+    // can be edited.
+    if (starts_with (type, "struct ")
+        || starts_with (type, "class ")
+        || starts_with (type, "union "))
+        a_desc.is_compound (true);
+}
+
+/// \return the descriptor of a type.  The type string is only
+/// analyzed the first time it is seen.
+const ILangTrait::TypeDescriptor&
+CPPTrait::get_type_descriptor (const UString &a_type) const
+{
+    TypeDescriptors::iterator it = m_type_descriptors.find (a_type.raw ());
+    if (it != m_type_descriptors.end ())
+        return it->second;
+
+    TypeDescriptor &desc = m_type_descriptors[a_type.raw ()];
+    classify_type (a_type.raw (), desc);
+    LOG_DD ("type: '" << a_type << "', pointer: " << desc.is_pointer ()
+            << ", reference: " << desc.is_reference ()
+            << ", array: " << desc.is_array ()
+            << ", compound: " << desc.is_compound ()
+            << ", container: " << desc.is_container ());
+    return desc;
+}
+
+bool
+CPPTrait::is_type_a_pointer (const UString &a_type) const
+{
+    return get_type_descriptor (a_type).is_pointer ();
 }
 
 bool
 CPPTrait::is_variable_compound (const IDebugger::VariableSafePtr a_var) const
 {
-    if (a_var
-        && (a_var->value () == "{...}"
-            || a_var->value ().empty ()))
+    if (!a_var)
+        return false;
+    if (a_var->value () == "{...}"
+        || a_var->value ().empty ())
         return true;
-    return false;
+    // Pretty printed containers have a summary as a value, e.g.
+    // "std::vector of length 3, capacity 4".  Their pretty printer
+    // gives them children, whereas the ones of std::string and the
+    // like do not.
+    if (a_var->is_dynamic () && a_var->expects_children ())
+        return true;
+    if (a_var->type ().empty ())
+        return false;
+    // The value of an array is its number of elements, e.g. "[3]".
+    const TypeDescriptor &type = get_type_descriptor (a_var->type ());
+    return type.is_array () || type.is_compound ();
 }
 
 class CPPTraitModule : public DynamicModule {
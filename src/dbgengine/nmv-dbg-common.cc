@@ -23,6 +23,9 @@
  *See COPYRIGHT file copyright information.
  */
 #include "config.h"
+#include <typeinfo>
+#include <cxxabi.h>
+#include <cstdlib>
 #include "common/nmv-exception.h"
 #include "nmv-dbg-common.h"
 
@@ -30,8 +33,35 @@ NEMIVER_BEGIN_NAMESPACE (nemiver)
 
 struct OutputHandlerList::Priv {
     list<OutputHandlerSafePtr> output_handlers;
+    // The names of the handlers of output_handlers, in the same
+    // order.
+    list<UString> handler_names;
+    // If non nil, the time spent in each handler is recorded here.
+    IDebugger::PerfStats *perf_stats;
+
+    Priv () :
+        perf_stats (0)
+    {
+    }
 };//end OutputHandlerList
 
+/// \return the demangled name of the dynamic type of an output
+/// handler.  This is used to tell handlers apart in the performance
+/// statistics.
+static UString
+get_handler_name (const OutputHandler &a_handler)
+{
+    const char *mangled = typeid (a_handler).name ();
+    int status = 0;
+    char *demangled = abi::__cxa_demangle (mangled, 0, 0, &status);
+    UString result = (status == 0 && demangled) ? demangled : mangled;
+    free (demangled);
+    UString::size_type i = result.rfind ("::");
+    if (i != UString::npos)
+        result.erase (0, i + 2);
+    return result;
+}
+
 OutputHandlerList::OutputHandlerList ()
 {
     m_priv.reset (new OutputHandlerList::Priv);
@@ -45,23 +75,48 @@ void
 OutputHandlerList::add (const OutputHandlerSafePtr &a_handler)
 {
     THROW_IF_FAIL (m_priv);
+    THROW_IF_FAIL (a_handler);
     m_priv->output_handlers.push_back (a_handler);
+    m_priv->handler_names.push_back (get_handler_name (*a_handler));
+}
+
+/// Set the object the time spent in each handler should be recorded
+/// into.
+///
+/// \param a_stats the statistics to update, or nil to not record
+/// anything.
+void
+OutputHandlerList::perf_stats (IDebugger::PerfStats *a_stats)
+{
+    THROW_IF_FAIL (m_priv);
+    m_priv->perf_stats = a_stats;
 }
 
 void
 OutputHandlerList::submit_command_and_output (CommandAndOutput &a_cao)
 {
+    gint64 dispatch_start =
+        m_priv->perf_stats ? g_get_monotonic_time () : 0;
     list<OutputHandlerSafePtr>::iterator iter;
+    list<UString>::const_iterator name = m_priv->handler_names.begin ();
     for (iter = m_priv->output_handlers.begin ();
             iter != m_priv->output_handlers.end ();
-            ++iter)
+            ++iter, ++name)
     {
         if ((*iter)->can_handle (a_cao)) {
+            gint64 start = m_priv->perf_stats ? g_get_monotonic_time () : 0;
             NEMIVER_TRY;
             (*iter)->do_handle (a_cao);
             NEMIVER_CATCH_NOX;
+            if (m_priv->perf_stats)
+                m_priv->perf_stats->record_handler_time
+                                        (*name,
+                                         g_get_monotonic_time () - start);
         }
     }
+    if (m_priv->perf_stats)
+        m_priv->perf_stats->record_dispatch (g_get_monotonic_time ()
+                                             - dispatch_start);
 }
 
 /// Private stuff of the VarChange type.
@@ -93,13 +93,17 @@ class Command {
     IDebugger::VariableSafePtr m_var;
     sigc::slot_base m_slot;
     bool m_should_emit_signal;
+    gint64 m_queued_time;
+    gint64 m_issued_time;
 
 public:
 
     Command () :
     m_tag2 (0),
       m_slot (0),
-      m_should_emit_signal (true)
+      m_should_emit_signal (true),
+      m_queued_time (0),
+      m_issued_time (0)
     {
         clear ();
     }
@@ -109,7 +113,9 @@ public:
     m_value (a_value),
       m_tag2 (0),
       m_slot (0),
-      m_should_emit_signal (true)
+      m_should_emit_signal (true),
+      m_queued_time (0),
+      m_issued_time (0)
     {
     }
 
@@ -118,7 +124,9 @@ public:
       m_value (a_value),
       m_tag2 (0),
       m_slot (0),
-      m_should_emit_signal (true)
+      m_should_emit_signal (true),
+      m_queued_time (0),
+      m_issued_time (0)
     {
     }
 
@@ -130,7 +138,9 @@ public:
       m_value (a_value),
       m_tag2 (0),
       m_slot (0),
-      m_should_emit_signal (true)
+      m_should_emit_signal (true),
+      m_queued_time (0),
+      m_issued_time (0)
     {
     }
 
@@ -185,6 +195,16 @@ public:
     bool should_emit_signal () const {return m_should_emit_signal;}
     void should_emit_signal (bool a) {m_should_emit_signal = a;}
 
+    /// When the command got queued, as returned by
+    /// g_get_monotonic_time.
+    gint64 queued_time () const {return m_queued_time;}
+    void queued_time (gint64 a) {m_queued_time = a;}
+
+    /// When the command got sent to the debugger, as returned by
+    /// g_get_monotonic_time.
+    gint64 issued_time () const {return m_issued_time;}
+    void issued_time (gint64 a) {m_issued_time = a;}
+
     /// @}
 
     void clear ()
@@ -197,6 +217,8 @@ public:
         m_tag3.clear ();
         m_tag4.clear ();
 	m_should_emit_signal = true;
+        m_queued_time = 0;
+        m_issued_time = 0;
     }
 };//end class Command
 
@@ -206,7 +228,13 @@ public:
 /// by gdb, but I hope it is generic enough to serve for several
 /// debugging engines.
 /// See the documentation of GDB/MI for more.
-class Output {
+///
+/// An Output can be big -- think of the reply to a request for a
+/// deep call stack or for a large memory area -- so once it has been
+/// parsed it is handed to the output handlers through a shared
+/// OutputSafePtr rather than copied, and must not be modified
+/// anymore.
+class Output : public Object {
 public:
 
     /// \brief debugger stream record.
@@ -279,6 +307,11 @@ public:
         UString m_signal_meaning;
         bool m_has_modified_breakpoint;
         IDebugger::Breakpoint m_modified_breakpoint;
+        bool m_has_deleted_breakpoint;
+        string m_deleted_breakpoint_id;
+        bool m_library_event;
+        bool m_library_loaded;
+        IDebugger::Library m_library;
 
     public:
 
@@ -369,6 +402,21 @@ public:
         bool thread_selected () const {return m_thread_selected;}
         void thread_selected (bool a_in) {m_thread_selected = a_in;}
 
+        /// True if the record reports that a shared library was
+        /// loaded or unloaded by the inferior.
+        bool library_event () const {return m_library_event;}
+        void library_event (bool a_in) {m_library_event = a_in;}
+
+        /// True if the library event is a load, false if it is an
+        /// unload.
+        bool library_loaded () const {return m_library_loaded;}
+        void library_loaded (bool a_in) {m_library_loaded = a_in;}
+
+        /// The library loaded or unloaded.  Only its id is known
+        /// when it is unloaded.
+        const IDebugger::Library& library () const {return m_library;}
+        void library (const IDebugger::Library &a_in) {m_library = a_in;}
+
         long thread_id () const {return m_thread_id;}
         void thread_id (long a_in) {m_thread_id = a_in;}
 
@@ -403,6 +451,29 @@ public:
             m_has_modified_breakpoint = true;
         }
 
+        /// Getter of the "deleted_breakpoint" flag.  This flag is
+        /// true if the underlying debugging engine reports that a
+        /// breakpoint has been deleted, e.g by a command that was not
+        /// issued by Nemiver.
+        ///
+        /// @return the deleted_breakpoint flag.
+        bool has_deleted_breakpoint () const
+        {return m_has_deleted_breakpoint;}
+
+        /// Getter of the ID of the deleted breakpoint carried by this
+        /// out of band record.  What this returns is meaningful only
+        /// if has_deleted_breakpoint() returns true.
+        const string& deleted_breakpoint_id () const
+        {return m_deleted_breakpoint_id;}
+
+        /// Setter of the ID of the deleted breakpoint carried by this
+        /// out of band record.
+        void deleted_breakpoint_id (const string &a_id)
+        {
+            m_deleted_breakpoint_id = a_id;
+            m_has_deleted_breakpoint = true;
+        }
+
         /// @}
 
 	void clear ()
@@ -420,6 +491,11 @@ public:
 	    m_signal_type.clear ();
 	    m_has_modified_breakpoint = 0;
 	    m_modified_breakpoint.clear();
+	    m_has_deleted_breakpoint = false;
+	    m_deleted_breakpoint_id.clear ();
+	    m_library_event = false;
+	    m_library_loaded = false;
+	    m_library.clear ();
 	}
     };//end class OutOfBandRecord
     typedef list<OutOfBandRecord> OutOfBandRecords;
@@ -666,6 +742,15 @@ public:
             m_memory_values = a_values;
             has_memory_values (true);
         }
+        /// Like memory_values, but steals the content of a_values
+        /// rather than copying it.
+        void swap_memory_values (size_t a_address,
+                                 std::vector<uint8_t>& a_values)
+        {
+            m_memory_address = a_address;
+            m_memory_values.swap (a_values);
+            has_memory_values (true);
+        }
 
         bool has_asm_instruction_list () const {return m_has_asm_instrs;}
         void has_asm_instruction_list (bool a) {m_has_asm_instrs = a;}
@@ -680,12 +765,23 @@ public:
             m_asm_instrs = a_asms;
             m_has_asm_instrs = true;
         }
+        /// Like asm_instruction_list, but steals the content of
+        /// a_asms rather than copying it.
+        void swap_asm_instruction_list (std::list<common::Asm> &a_asms)
+        {
+            m_asm_instrs.swap (a_asms);
+            m_has_asm_instrs = true;
+        }
 
         const map<int, list<IDebugger::VariableSafePtr> >&
                                                     frames_parameters () const
         {
             return m_frames_parameters;
         }
+        map<int, list<IDebugger::VariableSafePtr> >& frames_parameters ()
+        {
+            return m_frames_parameters;
+        }
         void frames_parameters
                     (const map<int, list<IDebugger::VariableSafePtr> > &a_in)
         {
@@ -955,27 +1051,34 @@ public:
         m_result_record.clear ();
     }
 };//end class Output
+typedef SafePtr<Output, ObjectRef, ObjectUnref> OutputSafePtr;
 
 /// A container of the Command sent to the debugger
 /// and the output it sent back.
+///
+/// The output is shared, not copied.
 class CommandAndOutput {
     bool m_has_command;
     Command m_command;
-    Output m_output;
+    OutputSafePtr m_output;
 
 public:
 
     CommandAndOutput (const Command &a_command,
-                      const Output &a_output) :
+                      const OutputSafePtr &a_output) :
         m_has_command (true),
         m_command (a_command),
         m_output (a_output)
     {
+        THROW_IF_FAIL (m_output);
     }
 
-    CommandAndOutput () :
-        m_has_command (false)
-    {}
+    explicit CommandAndOutput (const OutputSafePtr &a_output) :
+        m_has_command (false),
+        m_output (a_output)
+    {
+        THROW_IF_FAIL (m_output);
+    }
 
     /// \name accessors
 
@@ -991,9 +1094,16 @@ public:
         m_command = a_in; has_command (true);
     }
 
-    const Output& output () const {return m_output;}
-    Output& output () {return m_output;}
-    void output (const Output &a_in) {m_output = a_in;}
+    const Output& output () const {return *m_output;}
+    /// The output handlers read the output through this accessor
+    /// too, but must not modify it.
+    Output& output () {return *m_output;}
+    const OutputSafePtr& shared_output () const {return m_output;}
+    void output (const OutputSafePtr &a_in)
+    {
+        THROW_IF_FAIL (a_in);
+        m_output = a_in;
+    }
     /// @}
 };//end CommandAndOutput
 
@@ -1042,6 +1152,7 @@ public:
     ~OutputHandlerList ();
     void add (const OutputHandlerSafePtr &a_handler);
     void submit_command_and_output (CommandAndOutput &a_cao);
+    void perf_stats (IDebugger::PerfStats *a_stats);
 };//end class OutputHandlerList
 
 NEMIVER_END_NAMESPACE (nemiver)
@@ -32,6 +32,7 @@
 #include <boost/variant.hpp>
 #include <algorithm>
 #include <memory>
+#include <set>
 #include <fstream>
 #include <iostream>
 #include "nmv-i-debugger.h"
@@ -40,7 +41,10 @@
 #include "common/nmv-sequence.h"
 #include "common/nmv-proc-utils.h"
 #include "common/nmv-str-utils.h"
+#include "common/nmv-date-utils.h"
 #include "nmv-gdb-engine.h"
+#include "nmv-gdb-process-pool.h"
+#include "nmv-stop-history.h"
 #include "langs/nmv-cpp-parser.h"
 #include "langs/nmv-cpp-ast-utils.h"
 #include "nmv-i-lang-trait.h"
@@ -68,6 +72,13 @@ static const char* DEFAULT_GDB_BINARY = "default-gdb-binary";
 static const char* GDB_DEFAULT_PRETTY_PRINTING_VISUALIZER =
     "gdb.default_visualizer";
 static const char* GDB_NULL_PRETTY_PRINTING_VISUALIZER = "None";
+// The minimum delay between two notifications of the hits of
+// countpoints and dprintf breakpoints, in milliseconds.
+static const unsigned TRACED_BREAKPOINTS_NOTIFICATION_INTERVAL = 250;
+
+/// A burst of shared library events is considered over when no such
+/// event came for this many milliseconds.
+static const unsigned LIBRARY_EVENTS_QUIET_INTERVAL = 100;
 
 NEMIVER_BEGIN_NAMESPACE (nemiver)
 
@@ -75,6 +86,9 @@ extern const char* CONF_KEY_GDB_BINARY;
 extern const char* CONF_KEY_FOLLOW_FORK_MODE;
 extern const char* CONF_KEY_DISASSEMBLY_FLAVOR;
 extern const char* CONF_KEY_PRETTY_PRINTING;
+extern const char* CONF_KEY_GDB_PROCESS_POOL;
+extern const char* CONF_KEY_GDB_NON_STOP_MODE;
+extern const char* CONF_KEY_TARGET_SIDE_CONDITIONS;
 
 // Helper function to handle escaping the arguments 
 static UString
@@ -92,6 +106,76 @@ quote_args (const vector<UString> &a_prog_args)
     return args;
 }
 
+/// \return a_str as a quoted C string, which GDB reads back
+/// verbatim as an argument of a GDB/MI command.
+static UString
+quote_mi_string (const UString &a_str)
+{
+    std::string result = "\"";
+    const std::string &raw = a_str.raw ();
+    for (std::string::const_iterator it = raw.begin ();
+         it != raw.end ();
+         ++it) {
+        switch (*it) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            default:
+                result += *it;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+/// \return the format of a dprintf breakpoint, written with C
+/// escapes like a printf format in a C program, as a quoted C
+/// string for -dprintf-insert.
+///
+/// GDB decodes the escapes of that string, then escapes the format
+/// again before handing it to dprintf, which interprets the escapes
+/// of its format.  So the escapes of a_format are passed through
+/// untouched, and only its bare double quotes and characters that
+/// would break the command line are escaped.
+static UString
+quote_mi_format (const UString &a_format)
+{
+    std::string result = "\"";
+    const std::string &raw = a_format.raw ();
+    for (std::string::const_iterator it = raw.begin ();
+         it != raw.end ();
+         ++it) {
+        switch (*it) {
+            case '\\':
+                // Keep the escape sequence as is.  A trailing
+                // backslash escapes nothing; keep it literally.
+                if (it + 1 == raw.end ()) {
+                    result += "\\\\";
+                } else {
+                    result += *it;
+                    result += *++it;
+                }
+                break;
+            case '"':
+                result += "\\\"";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            default:
+                result += *it;
+        }
+    }
+    result += '"';
+    return result;
+}
+
 //**************************************************************
 // <Helper functions to generate a serialized form of location>
 //**************************************************************
@@ -210,7 +294,46 @@ public:
     list<Command> queued_commands;
     list<Command> started_commands;
     bool line_busy;
+    // The names of the variable objects that are not used anymore,
+    // and that are deleted one at a time when the command line is
+    // idle.  The name of a child variable object is not recorded if
+    // one of its ancestors is, as deleting a variable object deletes
+    // its children too.
+    std::set<std::string> released_varobjs;
+    sigc::connection released_varobjs_connection;
+    // The number of member variables which visualizer is being set
+    // by the pending revisualizations, and the number of those that
+    // are done.  Both are reset once every pending member is done.
+    int num_revisualized_members;
+    int num_revisualized_members_done;
     map<string, IDebugger::Breakpoint> cached_breakpoints;
+    // The countpoints and dprintf breakpoints which hits have not
+    // been notified yet, by id.  They are notified all at once, so
+    // that a breakpoint hit in a tight loop doesn't flood the
+    // listeners of breakpoints_set_signal.
+    map<string, IDebugger::Breakpoint> traced_breakpoints_to_notify;
+    sigc::connection traced_breakpoints_connection;
+    // The shared libraries loaded by the inferior, by id, and the id
+    // of the library mapped at the start of each of their address
+    // ranges, to look a library up by address cheaply.
+    map<UString, IDebugger::Library> libraries;
+    map<size_t, UString> library_ranges;
+    // Shared library events come in bursts, e.g. at startup.  They
+    // are notified once the burst is over; meanwhile the breakpoints
+    // GDB resolves again in the new libraries are kept here, by id.
+    sigc::connection library_events_connection;
+    gint64 last_library_event_time;
+    map<string, IDebugger::Breakpoint> breakpoints_resolved_in_burst;
+    // The source files of the program, as last listed by GDB.  They
+    // only change when libraries are loaded or unloaded.
+    vector<UString> source_files;
+    bool source_files_cached;
+    // The forks GDB keeps aside for the checkpoints that were not
+    // restarted from yet, by checkpoint id, with their process id.
+    map<int, int> checkpoint_forks;
+    // The id of the process being debugged among the forks GDB
+    // keeps for the checkpoints, or -1 if it keeps none.
+    int current_fork_id;
     enum InBufferStatus {
         DEFAULT,
         FILLING,
@@ -220,6 +343,12 @@ public:
     Glib::RefPtr<Glib::MainContext> loop_context;
 
     OutputHandlerList output_handler_list;
+    IDebugger::PerfStats perf_stats;
+    StopHistory stop_history;
+    // The scope of the root variable objects, by name, so that the
+    // values reported by -var-update are recorded in the right
+    // scope of the stop history.
+    std::map<UString, StopHistory::VariableScope> variable_scopes;
     IDebugger::State state;
     bool is_running;
     bool uses_launch_tty;
@@ -241,6 +370,45 @@ public:
     // globally, we shouldn't try to globally enable it again.  So
     // let's keep track of if we enabled it once.
     bool pretty_printing_enabled_once;
+    // Whether GDB processes are taken from (and put back into) the
+    // GDBProcessPool, so that GDB has already read the symbols of
+    // the program when a session starts.
+    bool use_gdb_process_pool;
+    // The command line and program of the GDB process to pre-spawn
+    // into the pool once the event loop is idle.
+    vector<UString> gdb_argv_to_prewarm;
+    UString prog_path_to_prewarm;
+    sigc::connection prewarm_connection;
+    // Whether the user wants GDB in non-stop mode.  That mode can't
+    // be changed once the inferior started, so this applies to the
+    // next GDB launched.
+    bool non_stop_mode_requested;
+    // Whether the current GDB is in non-stop mode.
+    bool non_stop_mode;
+    // Whether each thread is running, by thread id.  The threads
+    // that are not in there are running iff
+    // threads_running_by_default is true.
+    map<int, bool> threads_running;
+    bool threads_running_by_default;
+    // Whether the conditions of breakpoints are evaluated by the
+    // target when it supports it, rather than by GDB.
+    bool target_side_conditions;
+    // The state of the fast-forward stepping in progress, if any.
+    // See GDBEngine::fast_forward_until_changed.  The stops that
+    // happen along the way are not notified, except the last one,
+    // which is kept in the fast_forward_stop_* members meanwhile.
+    // fast_forward_stepping is true while one of the steps runs.
+    bool fast_forwarding;
+    bool fast_forward_stepping;
+    UString fast_forward_expression;
+    UString fast_forward_value;
+    bool fast_forward_has_value;
+    unsigned fast_forward_steps_left;
+    UString fast_forward_cookie;
+    bool fast_forward_has_stop;
+    bool fast_forward_stop_has_frame;
+    IDebugger::Frame fast_forward_stop_frame;
+    int fast_forward_stop_thread_id;
     sigc::signal<void> gdb_died_signal;
     sigc::signal<void, const UString& > master_pty_signal;
     sigc::signal<void, const UString& > gdb_stdout_signal;
@@ -265,6 +433,8 @@ public:
     mutable sigc::signal<void> detached_from_target_signal;
     
     mutable sigc::signal<void> inferior_re_run_signal;
+    mutable sigc::signal<void, int, const UString&> checkpoint_set_signal;
+    mutable sigc::signal<void> libraries_changed_signal;
 
     mutable sigc::signal<void,
                          const map<string, IDebugger::Breakpoint>&,
@@ -306,6 +476,8 @@ public:
                          const Frame * const,
                          const UString&> thread_selected_signal;
 
+    mutable sigc::signal<void, int, bool> thread_state_changed_signal;
+
     mutable sigc::signal<void, const vector<IDebugger::Frame>&, const UString&>
                                                     frames_listed_signal;
 
@@ -358,6 +530,8 @@ public:
     mutable sigc::signal<void, const UString&, const UString&>
                                                         signal_received_signal;
     mutable sigc::signal<void, const UString&> error_signal;
+    mutable sigc::signal<void, const UString&, const UString&, const UString&>
+                                                        command_error_signal;
 
     mutable sigc::signal<void> program_finished_signal;
 
@@ -419,6 +593,9 @@ public:
     mutable sigc::signal<void, VariableSafePtr, const UString&>
                                                 assigned_variable_signal;
 
+    mutable sigc::signal<void, int, int>
+                                variables_revisualization_progress_signal;
+
     //***********************
     //</GDBEngine attributes>
     //************************
@@ -493,20 +670,46 @@ public:
         stderr_signal.emit (result);
     }
 
+    /// Record the life cycle of a command which result record has
+    /// just been handled by the output handlers.
+    ///
+    /// \param a_command the command to consider.
+    ///
+    /// \param a_reply_time the time at which the result record of
+    /// the command was parsed.
+    void record_command_timing (const Command &a_command,
+                                gint64 a_reply_time)
+    {
+        IDebugger::PerfStats::CommandTiming timing;
+        timing.name (a_command.name ().empty ()
+                     ? a_command.value ()
+                     : a_command.name ());
+        timing.queued_time (a_command.queued_time ());
+        timing.issued_time (a_command.issued_time ());
+        timing.reply_time (a_reply_time);
+        timing.handled_time (g_get_monotonic_time ());
+        perf_stats.add_command_timing (timing);
+    }
+
     void on_gdb_stdout_signal (const UString &a_buf)
     {
         LOG_D ("<debuggeroutput>\n" << a_buf << "\n</debuggeroutput>",
                GDBMI_OUTPUT_DOMAIN);
 
-        Output output (a_buf);
-
         UString::size_type from (0), to (0), end (a_buf.size ());
 		LOG_DD ("trace5");
         gdbmi_parser.push_input (a_buf);
 		LOG_DD ("trace6");
         for (; from < end;) {
 			LOG_DD ("trace8");
-            if (!gdbmi_parser.parse_output_record (from, to, output)) {
+            // Each output record is parsed once into an Output that
+            // is then shared by the output handlers, never copied.
+            OutputSafePtr output (new Output);
+            gint64 parse_start = g_get_monotonic_time ();
+            bool parsed = gdbmi_parser.parse_output_record (from, to, *output);
+            gint64 parse_end = g_get_monotonic_time ();
+            perf_stats.record_parsing (to - from, parse_end - parse_start);
+            if (!parsed) {
                 LOG_ERROR ("output record parsing failed: "
                         << a_buf.substr (from, end - from)
                         << "\npart of buf: " << a_buf
@@ -514,10 +717,12 @@ public:
                         << "\nto: " << (int) to << "\n"
                         << "\nstrlen: " << (int) a_buf.size ());
                 gdbmi_parser.skip_output_record (from, to);
-                output.parsing_succeeded (false);
+                // Don't hand out what was partially parsed.
+                output.reset (new Output);
+                output->parsing_succeeded (false);
             } else {
 			LOG_DD ("Trace 1");
-				output.parsing_succeeded (true);
+				output->parsing_succeeded (true);
 			}
 			LOG_DD ("Trace 2");
 
@@ -528,23 +733,25 @@ public:
 
             UString output_value;
             output_value.assign (a_buf, from, to - from +1);
-            output.raw_value (output_value);
-            CommandAndOutput command_and_output;
-            if (output.has_result_record ()) {
+            output->raw_value (output_value);
+            CommandAndOutput command_and_output (output);
+            if (output->has_result_record ()) {
                 if (!started_commands.empty ()) {
                     command_and_output.command (*started_commands.begin ());
                 }
             }
-            command_and_output.output (output);
             LOG_DD ("received command was: '"
                     << command_and_output.command ().name ()
                     << "'");
             stdout_signal.emit (command_and_output);
+            if (command_and_output.has_command ())
+                record_command_timing (command_and_output.command (),
+                                       parse_end);
             from = to;
             while (from < end && isspace (a_buf.raw ()[from])) {++from;}
-            if (output.has_result_record ()/*gdb acknowledged previous
-                                             cmd*/
-                || !output.parsing_succeeded ()) {
+            if (output->has_result_record ()/*gdb acknowledged previous
+                                              cmd*/
+                || !output->parsing_succeeded ()) {
                 LOG_DD ("here");
                 if (!started_commands.empty ()) {
                     started_commands.erase (started_commands.begin ());
@@ -557,7 +764,10 @@ public:
                     && !queued_commands.empty ()) {
                     issue_command (*queued_commands.begin ());
                     queued_commands.erase (queued_commands.begin ());
+                    perf_stats.queue_depth (queued_commands.size ());
 					LOG_DD ("command erase");
+                } else {
+                    delete_next_released_varobj ();
                 }
 			LOG_DD ("trace 3");
 			}
@@ -575,6 +785,8 @@ public:
         master_pty_fd (0),
         is_attached (false),
         line_busy (false),
+        num_revisualized_members (0),
+        num_revisualized_members_done (0),
         error_buffer_status (DEFAULT),
         state (IDebugger::NOT_STARTED),
         is_running (false),
@@ -586,7 +798,22 @@ public:
         disassembly_flavor ("att"),
         gdbmi_parser (GDBMIParser::BROKEN_MODE),
         enable_pretty_printing (true),
-        pretty_printing_enabled_once (false)
+        pretty_printing_enabled_once (false),
+        use_gdb_process_pool (false),
+        non_stop_mode_requested (false),
+        non_stop_mode (false),
+        threads_running_by_default (false),
+        target_side_conditions (true),
+        fast_forwarding (false),
+        fast_forward_stepping (false),
+        fast_forward_has_value (false),
+        fast_forward_steps_left (0),
+        fast_forward_has_stop (false),
+        fast_forward_stop_has_frame (false),
+        fast_forward_stop_thread_id (0),
+        last_library_event_time (0),
+        source_files_cached (false),
+        current_fork_id (-1)
     {
         memset (&tty_attributes, 0, sizeof (tty_attributes));
 
@@ -614,6 +841,18 @@ public:
 
         frames_listed_signal.connect (sigc::mem_fun
                (*this, &Priv::on_frames_listed_signal));
+
+        register_names_listed_signal.connect (sigc::mem_fun
+               (*this, &Priv::on_register_names_listed_signal));
+
+        register_values_listed_signal.connect (sigc::mem_fun
+               (*this, &Priv::on_register_values_listed_signal));
+
+        changed_variables_signal.connect (sigc::mem_fun
+               (*this, &Priv::on_changed_variables_signal));
+
+        files_listed_signal.connect (sigc::mem_fun
+               (*this, &Priv::on_files_listed_signal));
     }
     void free_resources ()
     {
@@ -641,6 +880,7 @@ public:
         if (a_priority) {}
         gdb_died_signal.emit ();
         free_resources ();
+        IDebugger::Variable::release_memory_when_unused ();
     }
 
     void set_state (IDebugger::State a_state)
@@ -743,6 +983,14 @@ public:
                                             gdb_stderr_fd),
                             false);
 
+        return connect_to_gdb ();
+    }
+
+    /// Start talking to the GDB process which pid and file
+    /// descriptors are in gdb_pid, master_pty_fd, gdb_stdout_fd and
+    /// gdb_stderr_fd.
+    bool connect_to_gdb ()
+    {
         RETURN_VAL_IF_FAIL (gdb_pid, false);
 
         gdb_stdout_channel = Glib::IOChannel::create_from_fd (gdb_stdout_fd);
@@ -801,20 +1049,32 @@ public:
         return false;
     }
 
-    bool launch_gdb (const UString &working_dir,
-                     const vector<UString> &a_source_search_dirs,
-                     const UString &a_prog,
-                     const vector<UString> &a_gdb_options)
+    /// Build the command line of a GDB process that is to debug a
+    /// given program.
+    ///
+    /// \param working_dir the working directory of the program.
+    ///
+    /// \param a_prog the program.  It's looked up in working_dir and
+    /// in the PATH if it's not found.  It can be empty.
+    ///
+    /// \param a_gdb_options additional options to pass to GDB.
+    ///
+    /// \param a_argv the resulting command line.
+    ///
+    /// \param a_prog_path the resulting path to the program.
+    ///
+    /// \return true upon successful completion, false otherwise.
+    bool build_gdb_argv (const UString &working_dir,
+                         const UString &a_prog,
+                         const vector<UString> &a_gdb_options,
+                         vector<UString> &a_argv,
+                         UString &a_prog_path)
     {
-        if (is_gdb_running ()) {
-            kill_gdb ();
-        }
-        argv.clear ();
-
-        UString prog_path;
+        a_argv.clear ();
+        a_prog_path.clear ();
         if (!a_prog.empty ()) {
-            prog_path = a_prog;
-            if (!Glib::file_test (Glib::filename_from_utf8 (prog_path),
+            a_prog_path = a_prog;
+            if (!Glib::file_test (Glib::filename_from_utf8 (a_prog_path),
                                   Glib::FILE_TEST_IS_REGULAR)) {
                 // So we haven't found the file. Let's look for it in
                 // the current working directory and in the PATH.
@@ -822,12 +1082,15 @@ public:
                 if (!working_dir.empty ()) {
                     list<UString> where;
                     where.push_back (working_dir);
-                    if (common::env::find_file (prog_path, where, prog_path))
+                    if (common::env::find_file (a_prog_path, where,
+                                                a_prog_path))
                         found = true;
                 }
 
-                if (!found && !find_prog_in_path (prog_path, prog_path)) {
-                    LOG_ERROR ("Could not find program '" << prog_path << "'");
+                if (!found
+                    && !find_prog_in_path (a_prog_path, a_prog_path)) {
+                    LOG_ERROR ("Could not find program '"
+                               << a_prog_path << "'");
                     return false;
                 }
             }
@@ -835,29 +1098,108 @@ public:
         // if the executable program to be debugged is a
         // libtool wrapper script,
         // run the debugging session under libtool
-        if (is_libtool_executable_wrapper (prog_path)) {
-            LOG_DD ( prog_path << " is a libtool script");
-            argv.push_back ("libtool");
-            argv.push_back ("--mode=execute");
+        if (is_libtool_executable_wrapper (a_prog_path)) {
+            LOG_DD ( a_prog_path << " is a libtool script");
+            a_argv.push_back ("libtool");
+            a_argv.push_back ("--mode=execute");
         }
 
         THROW_IF_FAIL (get_debugger_full_path () != "");
-        argv.push_back (get_debugger_full_path ());
+        a_argv.push_back (get_debugger_full_path ());
         if (working_dir != "") {
-            argv.push_back ("--cd=" + working_dir);
+            a_argv.push_back ("--cd=" + working_dir);
         }
-        argv.push_back ("--interpreter=mi2");
+        a_argv.push_back ("--interpreter=mi2");
         if (!a_gdb_options.empty ()) {
             for (vector<UString>::const_iterator it = a_gdb_options.begin ();
                  it != a_gdb_options.end ();
                  ++it) {
-                argv.push_back (*it);
+                a_argv.push_back (*it);
             }
         }
-        argv.push_back (prog_path);
+        a_argv.push_back (a_prog_path);
+        return true;
+    }
+
+    bool launch_gdb (const UString &working_dir,
+                     const vector<UString> &a_source_search_dirs,
+                     const UString &a_prog,
+                     const vector<UString> &a_gdb_options)
+    {
+        if (is_gdb_running ()) {
+            kill_gdb ();
+        }
+
+        UString prog_path;
+        if (!build_gdb_argv (working_dir, a_prog, a_gdb_options,
+                             argv, prog_path))
+            return false;
 
         source_search_dirs = a_source_search_dirs;
-        return launch_gdb_real (argv);
+        stop_history.clear ();
+        variable_scopes.clear ();
+        clear_libraries ();
+        source_files_cached = false;
+
+        if (!use_gdb_process_pool || prog_path.empty ())
+            return launch_gdb_real (argv);
+
+        GDBProcessPool::Process process;
+        bool result = false;
+        if (GDBProcessPool::get ().take (argv, prog_path, process)) {
+            LOG_DD ("using pre-spawned gdb of pid " << process.pid);
+            gdb_pid = process.pid;
+            master_pty_fd = process.master_pty_fd;
+            gdb_stdout_fd = process.stdout_fd;
+            gdb_stderr_fd = process.stderr_fd;
+            result = connect_to_gdb ();
+        } else {
+            result = launch_gdb_real (argv);
+        }
+
+        // Have a spare GDB ready for when this session gets
+        // restarted.
+        if (result)
+            queue_prewarm (argv, prog_path);
+        return result;
+    }
+
+    /// Pre-spawn a GDB process into the GDBProcessPool from the
+    /// event loop, once it is idle.
+    ///
+    /// \param a_argv the command line of the GDB process.
+    ///
+    /// \param a_prog_path the program GDB is to load.
+    void queue_prewarm (const vector<UString> &a_argv,
+                        const UString &a_prog_path)
+    {
+        if (!use_gdb_process_pool)
+            return;
+
+        gdb_argv_to_prewarm = a_argv;
+        prog_path_to_prewarm = a_prog_path;
+        if (prewarm_connection.connected ())
+            return;
+        Glib::RefPtr<Glib::IdleSource> source = Glib::IdleSource::create ();
+        source->set_priority (Glib::PRIORITY_LOW);
+        prewarm_connection = source->connect
+            (sigc::mem_fun (*this, &Priv::on_prewarm_idle));
+        source->attach (get_event_loop_context ());
+    }
+
+    bool on_prewarm_idle ()
+    {
+        NEMIVER_TRY
+
+        if (use_gdb_process_pool)
+            GDBProcessPool::get ().prewarm (gdb_argv_to_prewarm,
+                                            prog_path_to_prewarm);
+        gdb_argv_to_prewarm.clear ();
+        prog_path_to_prewarm.clear ();
+
+        NEMIVER_CATCH_NOX
+
+        return false;
     }
 
     bool launch_gdb_and_set_args (const UString &working_dir,
@@ -883,6 +1225,8 @@ public:
 	  queue_command (Command ("set args " + args));
         set_debugger_parameter ("follow-fork-mode", follow_fork_mode);
         set_debugger_parameter ("disassembly-flavor", disassembly_flavor);
+        set_condition_evaluation ();
+        set_non_stop_mode ();
 
         return true;
     }
@@ -932,14 +1276,22 @@ public:
             master_pty_channel->flush ();
             THROW_IF_FAIL (started_commands.size () <= 1);
 
-            if (a_do_record)
+            if (a_do_record) {
                 started_commands.push_back (a_command);
+                Command &started = started_commands.back ();
+                started.issued_time (g_get_monotonic_time ());
+                if (!started.queued_time ())
+                    started.queued_time (started.issued_time ());
+            }
 
             //usually, when we send a command to the debugger,
             //it becomes busy (in a running state), untill it gets
             //back to us saying the converse.
             line_busy = true;
-            set_state (IDebugger::RUNNING);
+            // Variable objects are released behind the back of the
+            // user; don't make the debugger look busy for that.
+            if (a_command.name () != "release-variable")
+                set_state (IDebugger::RUNNING);
             return true;
         }
         LOG_ERROR ("Issuing of last command failed");
@@ -950,11 +1302,15 @@ public:
     {
         bool result (false);
         LOG_DD ("queuing command: '" << a_command.value () << "'");
+        if (fast_forwarding && is_execution_command (a_command))
+            cancel_fast_forward ();
         queued_commands.push_back (a_command);
+        queued_commands.back ().queued_time (g_get_monotonic_time ());
         if (!line_busy && started_commands.empty ()) {
             result = issue_command (*queued_commands.begin (), true);
             queued_commands.erase (queued_commands.begin ());
         }
+        perf_stats.queue_depth (queued_commands.size ());
         return result;
     }
 
@@ -971,6 +1327,387 @@ public:
         started_commands.clear ();
         queued_commands.clear ();
         line_busy = false;
+        released_varobjs.clear ();
+        num_revisualized_members = 0;
+        num_revisualized_members_done = 0;
+    }
+
+    /// \return true if no command is being executed by GDB, no
+    /// command is waiting to be issued, and the inferior is not
+    /// running.
+    bool is_command_line_idle () const
+    {
+        return (!line_busy
+                && started_commands.empty ()
+                && queued_commands.empty ()
+                && state == IDebugger::READY);
+    }
+
+    /// Record that a variable object is not used anymore.  It's
+    /// deleted later, when the command line is idle.
+    void release_varobj (const UString &a_name)
+    {
+        const std::string &name = a_name.raw ();
+        variable_scopes.erase (a_name);
+
+        // If an ancestor of the variable object is going to be
+        // deleted, the variable object goes with it.
+        for (std::string::size_type pos = name.find ('.');
+             pos != std::string::npos;
+             pos = name.find ('.', pos + 1)) {
+            if (released_varobjs.find (name.substr (0, pos))
+                != released_varobjs.end ())
+                return;
+        }
+
+        // Conversely, the descendants of the variable object go with
+        // it.  Their names are all of the form NAME.xxx, and thus
+        // sort between NAME. and NAME/.
+        released_varobjs.erase (released_varobjs.lower_bound (name + '.'),
+                                released_varobjs.lower_bound (name + '/'));
+        released_varobjs.insert (name);
+
+        // If the command line is idle already, no output is going to
+        // come to trigger the deletion.  Do it from the main loop,
+        // once all the variables being destroyed right now are
+        // recorded.
+        if (!released_varobjs_connection.connected ()) {
+            Glib::RefPtr<Glib::IdleSource> source =
+                Glib::IdleSource::create ();
+            source->set_priority (Glib::PRIORITY_LOW);
+            released_varobjs_connection = source->connect
+                (sigc::mem_fun (*this, &Priv::on_released_varobjs_idle));
+            source->attach (get_event_loop_context ());
+        }
+    }
+
+    /// Delete one of the variable objects recorded by
+    /// release_varobj, if the command line is idle.  The next one is
+    /// deleted when GDB is done with this one, and so on, so that
+    /// commands queued in the mean time never have to wait for more
+    /// than one deletion.
+    ///
+    /// \return true if a variable object deletion was issued.
+    bool delete_next_released_varobj ()
+    {
+        if (released_varobjs.empty () || !is_command_line_idle ())
+            return false;
+
+        std::set<std::string>::iterator it = released_varobjs.begin ();
+        Command command ("release-variable", "-var-delete " + *it);
+        released_varobjs.erase (it);
+        return queue_command (command);
+    }
+
+    /// Forget about the pending deletion of a variable object, and
+    /// of its descendants, because GDB hands it out again.  That
+    /// happens when a variable object of that name is created, or
+    /// when its parent is unfolded again after its members were
+    /// dropped, e.g. to revisualize it: GDB then lists the same
+    /// children, under the same names.
+    ///
+    /// \param a_name the name of the variable object.
+    void reclaim_varobj (const UString &a_name)
+    {
+        if (released_varobjs.empty ())
+            return;
+        const std::string &name = a_name.raw ();
+        released_varobjs.erase (name);
+        released_varobjs.erase (released_varobjs.lower_bound (name + '.'),
+                                released_varobjs.lower_bound (name + '/'));
+    }
+
+    bool on_released_varobjs_idle ()
+    {
+        NEMIVER_TRY
+
+        delete_next_released_varobj ();
+
+        NEMIVER_CATCH_NOX
+
+        return false;
+    }
+
+    /// Record a hit of a countpoint or of a dprintf breakpoint.  The
+    /// breakpoints hit during the last
+    /// TRACED_BREAKPOINTS_NOTIFICATION_INTERVAL milliseconds are
+    /// then notified at once by breakpoints_set_signal.
+    ///
+    /// \param a_breakpoint the breakpoint that was hit, as updated
+    /// in the cache.
+    void record_traced_breakpoint_hit (const IDebugger::Breakpoint &a_breakpoint)
+    {
+        traced_breakpoints_to_notify[a_breakpoint.id ()] = a_breakpoint;
+
+        if (!traced_breakpoints_connection.connected ()) {
+            Glib::RefPtr<Glib::TimeoutSource> source =
+                Glib::TimeoutSource::create
+                    (TRACED_BREAKPOINTS_NOTIFICATION_INTERVAL);
+            traced_breakpoints_connection = source->connect
+                (sigc::mem_fun (*this,
+                                &Priv::on_traced_breakpoints_timeout));
+            source->attach (get_event_loop_context ());
+        }
+    }
+
+    /// \return true if a_command resumes or restarts the inferior,
+    /// and isn't one of the steps of a fast-forward stepping.
+    static bool is_execution_command (const Command &a_command)
+    {
+        if (a_command.name () == "fast-forward-step")
+            return false;
+        return (!a_command.value ().raw ().compare (0, 6, "-exec-")
+                || a_command.name () == "restart-from-checkpoint");
+    }
+
+    /// Start stepping over lines until an expression changes.  See
+    /// GDBEngine::fast_forward_until_changed.
+    void fast_forward_until_changed (const UString &a_expression,
+                                     unsigned a_max_nb_steps,
+                                     const UString &a_cookie)
+    {
+        fast_forwarding = true;
+        fast_forward_stepping = false;
+        fast_forward_expression = a_expression;
+        fast_forward_value.clear ();
+        fast_forward_has_value = false;
+        fast_forward_steps_left = a_max_nb_steps;
+        fast_forward_cookie = a_cookie;
+        fast_forward_has_stop = false;
+        evaluate_fast_forward_expression ();
+    }
+
+    void evaluate_fast_forward_expression ()
+    {
+        Command command ("fast-forward-evaluate",
+                         "-data-evaluate-expression "
+                         + fast_forward_expression,
+                         fast_forward_cookie);
+        command.set_slot
+            (sigc::slot<void, bool, const UString&>
+                (sigc::mem_fun (*this, &Priv::on_fast_forward_value)));
+        queue_command (command);
+    }
+
+    /// Called with the value of the expression watched by the
+    /// fast-forward stepping, before the first step and after each
+    /// of them.
+    ///
+    /// \param a_evaluated false if GDB failed to evaluate the
+    /// expression, e.g. because the inferior stepped out of its
+    /// scope.  The stepping then ends.
+    ///
+    /// \param a_value the value of the expression.
+    void on_fast_forward_value (bool a_evaluated, const UString &a_value)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        if (!fast_forwarding)
+            return;
+
+        if (!a_evaluated
+            || (fast_forward_has_value && a_value != fast_forward_value)
+            || !fast_forward_steps_left) {
+            end_fast_forward ();
+            return;
+        }
+        fast_forward_value = a_value;
+        fast_forward_has_value = true;
+        --fast_forward_steps_left;
+        fast_forward_stepping = true;
+        queue_command (Command ("fast-forward-step",
+                                "-exec-next" + exec_thread_option (),
+                                fast_forward_cookie));
+    }
+
+    /// Called when the inferior stopped during a fast-forward
+    /// stepping.
+    ///
+    /// \return true if the stop is one of the steps, in which case
+    /// it must not be notified.  Other stops, like breakpoint hits
+    /// or the exit of the inferior, end the stepping and are
+    /// notified as usual.  So are the stops of the commands queued
+    /// before the stepping started.
+    bool on_fast_forward_stopped (IDebugger::StopReason a_reason,
+                                  bool a_has_frame,
+                                  const IDebugger::Frame &a_frame,
+                                  int a_thread_id)
+    {
+        if (!fast_forwarding || !fast_forward_stepping)
+            return false;
+        fast_forward_stepping = false;
+
+        if (a_reason != IDebugger::END_STEPPING_RANGE) {
+            fast_forwarding = false;
+            return false;
+        }
+        fast_forward_has_stop = true;
+        fast_forward_stop_has_frame = a_has_frame;
+        fast_forward_stop_frame = a_frame;
+        fast_forward_stop_thread_id = a_thread_id;
+        evaluate_fast_forward_expression ();
+        return true;
+    }
+
+    /// Stop the fast-forward stepping in progress, because another
+    /// command is about to resume the inferior.  If one of the steps
+    /// is running, its stop is notified as usual.  Otherwise the last
+    /// stop of the stepping is notified right away, before the new
+    /// command is queued.
+    void cancel_fast_forward ()
+    {
+        LOG_DD ("cancelling the fast-forward stepping");
+        if (fast_forward_stepping) {
+            fast_forwarding = false;
+            fast_forward_stepping = false;
+            return;
+        }
+        end_fast_forward ();
+    }
+
+    /// Notify the last stop of the fast-forward stepping, if any.
+    void end_fast_forward ()
+    {
+        fast_forwarding = false;
+        if (!fast_forward_has_stop)
+            return;
+        stopped_signal.emit (IDebugger::END_STEPPING_RANGE,
+                             fast_forward_stop_has_frame,
+                             fast_forward_stop_frame,
+                             fast_forward_stop_thread_id,
+                             "", fast_forward_cookie);
+        set_state (IDebugger::READY);
+    }
+
+    /// Update the table of the shared libraries after GDB reported
+    /// that one was loaded or unloaded.  The change is notified by
+    /// libraries_changed_signal once the burst of library events it
+    /// belongs to is over.
+    void record_library_event (const Output::OutOfBandRecord &a_record)
+    {
+        const IDebugger::Library &library = a_record.library ();
+        remove_library (library.id ());
+        if (a_record.library_loaded ()) {
+            libraries[library.id ()] = library;
+            list<IDebugger::Library::AddressRange>::const_iterator it;
+            for (it = library.address_ranges ().begin ();
+                 it != library.address_ranges ().end ();
+                 ++it)
+                library_ranges[(size_t) it->first] = library.id ();
+        }
+
+        last_library_event_time = g_get_monotonic_time ();
+        if (!library_events_connection.connected ()) {
+            Glib::RefPtr<Glib::TimeoutSource> source =
+                Glib::TimeoutSource::create (LIBRARY_EVENTS_QUIET_INTERVAL);
+            library_events_connection = source->connect
+                (sigc::mem_fun (*this, &Priv::on_library_events_timeout));
+            source->attach (get_event_loop_context ());
+        }
+    }
+
+    void remove_library (const UString &a_id)
+    {
+        map<UString, IDebugger::Library>::iterator library =
+            libraries.find (a_id);
+        if (library == libraries.end ())
+            return;
+        list<IDebugger::Library::AddressRange>::const_iterator it;
+        for (it = library->second.address_ranges ().begin ();
+             it != library->second.address_ranges ().end ();
+             ++it) {
+            map<size_t, UString>::iterator range =
+                library_ranges.find ((size_t) it->first);
+            if (range != library_ranges.end () && range->second == a_id)
+                library_ranges.erase (range);
+        }
+        libraries.erase (library);
+    }
+
+    void clear_libraries ()
+    {
+        libraries.clear ();
+        library_ranges.clear ();
+    }
+
+    /// Record a breakpoint GDB resolved again while libraries are
+    /// being loaded.  It is notified along with the libraries.
+    void record_breakpoint_resolved_in_burst
+                                (const IDebugger::Breakpoint &a_breakpoint)
+    {
+        breakpoints_resolved_in_burst[a_breakpoint.id ()] = a_breakpoint;
+    }
+
+    bool on_library_events_timeout ()
+    {
+        NEMIVER_TRY
+
+        gint64 quiet_time =
+            g_get_monotonic_time () - last_library_event_time;
+        if (quiet_time < LIBRARY_EVENTS_QUIET_INTERVAL * 1000)
+            return true;
+        notify_library_changes ();
+
+        NEMIVER_CATCH_NOX
+
+        return false;
+    }
+
+    /// Notify the changes made by the last burst of library events,
+    /// at once.
+    void notify_library_changes ()
+    {
+        library_events_connection.disconnect ();
+        // The source files of the libraries come and go with them.
+        source_files_cached = false;
+        libraries_changed_signal.emit ();
+
+        map<string, IDebugger::Breakpoint> breakpoints;
+        breakpoints.swap (breakpoints_resolved_in_burst);
+        if (!breakpoints.empty ())
+            breakpoints_set_signal.emit (breakpoints, "");
+    }
+
+    /// \return the library mapped at a_address, or 0 if there is
+    /// none.
+    const IDebugger::Library* find_library_at_address (size_t a_address) const
+    {
+        map<size_t, UString>::const_iterator range =
+            library_ranges.upper_bound (a_address);
+        if (range == library_ranges.begin ())
+            return 0;
+        --range;
+        map<UString, IDebugger::Library>::const_iterator library =
+            libraries.find (range->second);
+        if (library == libraries.end ()
+            || !library->second.contains_address (a_address))
+            return 0;
+        return &library->second;
+    }
+
+    void on_files_listed_signal (const vector<UString> &a_files,
+                                 const UString &)
+    {
+        // The files listed in the middle of a burst of library
+        // events are about to change.
+        if (library_events_connection.connected ())
+            return;
+        source_files = a_files;
+        source_files_cached = true;
+    }
+
+    bool on_traced_breakpoints_timeout ()
+    {
+        NEMIVER_TRY
+
+        map<string, IDebugger::Breakpoint> breakpoints;
+        breakpoints.swap (traced_breakpoints_to_notify);
+        if (!breakpoints.empty ())
+            breakpoints_set_signal.emit (breakpoints, "");
+
+        NEMIVER_CATCH_NOX
+
+        return false;
     }
 
     void set_debugger_parameter (const UString &a_name,
@@ -994,6 +1731,50 @@ public:
                                         disassembly_flavor);
         get_conf_mgr ()->get_key_value (CONF_KEY_PRETTY_PRINTING,
                                         enable_pretty_printing);
+        get_conf_mgr ()->get_key_value (CONF_KEY_GDB_PROCESS_POOL,
+                                        use_gdb_process_pool);
+        get_conf_mgr ()->get_key_value (CONF_KEY_GDB_NON_STOP_MODE,
+                                        non_stop_mode_requested);
+        get_conf_mgr ()->get_key_value (CONF_KEY_TARGET_SIDE_CONDITIONS,
+                                        target_side_conditions);
+    }
+
+    /// Tell GDB where to evaluate the conditions of breakpoints.  In
+    /// "auto" mode, GDB has the target evaluate them if it can,
+    /// e.g. with gdbserver, and evaluates them itself otherwise.
+    /// Conditions that can't be compiled into agent expressions are
+    /// still evaluated by GDB.
+    void set_condition_evaluation ()
+    {
+        set_debugger_parameter ("breakpoint condition-evaluation",
+                                target_side_conditions ? "auto" : "host");
+    }
+
+    /// Put GDB in non-stop mode if the user asked for it.  This must
+    /// be done before the inferior is started or attached to.
+    void set_non_stop_mode ()
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        non_stop_mode = non_stop_mode_requested;
+        threads_running.clear ();
+        threads_running_by_default = false;
+        if (!non_stop_mode)
+            return;
+        // GDB must accept commands while some threads are running.
+        queue_command (Command ("-gdb-set target-async on"));
+        queue_command (Command ("-gdb-set non-stop on"));
+    }
+
+    /// \return the option that makes an execution command apply to
+    /// the current thread only, in non-stop mode.  In all-stop mode,
+    /// execution commands apply to all the threads and this is
+    /// empty.
+    UString exec_thread_option () const
+    {
+        if (!non_stop_mode)
+            return "";
+        return " --thread " + UString::from_int (cur_thread_num);
     }
 
     /// Lists the frames which numbers are in a given range.
@@ -1241,8 +2022,8 @@ public:
     /// event is fired.
     void on_stopped_signal (IDebugger::StopReason a_reason,
                             bool a_has_frame,
-                            const IDebugger::Frame &,
-                            int,
+                            const IDebugger::Frame &a_frame,
+                            int a_thread_id,
                             const string&,
                             const UString &a_cookie)
     {
@@ -1250,28 +2031,250 @@ public:
 
         NEMIVER_TRY;
 
-        if (IDebugger::is_exited (a_reason))
+        if (IDebugger::is_exited (a_reason)) {
             is_running = false;
+            // GDB keeps no fork once the last process exited.
+            forget_checkpoints ();
+            // The session is over.  Once the views let go of the
+            // variables of the session, their memory can go.
+            IDebugger::Variable::release_memory_when_unused ();
+            if (!libraries.empty ()) {
+                clear_libraries ();
+                notify_library_changes ();
+            }
+        } else if (library_events_connection.connected ()) {
+            // Don't let the views show the stop with stale
+            // libraries.
+            notify_library_changes ();
+        }
+
+        // The next commands are about the thread that just stopped,
+        // which is the one the user is shown.  GDB selects it in
+        // all-stop mode, but not in non-stop mode, and the frame
+        // dependent commands like -stack-list-frames or
+        // -stack-list-locals apply to the selected thread.  So
+        // select it there.  That selection is not news to the
+        // views, which are told about the stop already.
+        if (a_thread_id > 0 && !IDebugger::is_exited (a_reason)) {
+            if (non_stop_mode) {
+                Command command ("select-thread",
+                                 "-thread-select "
+                                 + UString::from_int (a_thread_id));
+                command.should_emit_signal (false);
+                queue_command (command);
+            }
+            cur_thread_num = a_thread_id;
+            cur_frame_level = 0;
+        }
 
-        if (a_has_frame)
+        if (a_has_frame) {
+            stop_history.record_stop (a_reason, a_frame, a_thread_id);
             // List frames so that we can get the @ of the current frame.
             list_frames (0, 0, a_cookie);
+        }
 
         NEMIVER_CATCH_NOX;
     }
 
+    /// Record a checkpoint GDB just set.
+    ///
+    /// \param a_id the id of the checkpoint.
+    ///
+    /// \param a_pid the id of the process GDB forked for it.
+    void record_checkpoint (int a_id, int a_pid)
+    {
+        // When GDB starts keeping forks, it gives the id 0 to the
+        // process that forked the first one.
+        if (current_fork_id < 0)
+            current_fork_id = 0;
+        checkpoint_forks[a_id] = a_pid;
+    }
+
+    /// Forget about the checkpoints, e.g. because GDB killed their
+    /// forks along with the inferior.
+    void forget_checkpoints ()
+    {
+        checkpoint_forks.clear ();
+        current_fork_id = -1;
+    }
+
+    /// Record that GDB switched to the fork of a checkpoint, which
+    /// is the process being debugged from now on.
+    void switch_to_checkpoint_fork (int a_id)
+    {
+        map<int, int>::iterator it = checkpoint_forks.find (a_id);
+        if (it != checkpoint_forks.end ()) {
+            target_pid = it->second;
+            checkpoint_forks.erase (it);
+        }
+        current_fork_id = a_id;
+    }
+
+    /// Called once GDB went back to a checkpoint.  GDB doesn't
+    /// report that as a stop, so fetch the frame the inferior is
+    /// stopped at in the checkpoint, and notify a stop there.
+    void on_restarted_from_checkpoint (int a_checkpoint_id,
+                                       const UString &a_cookie)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        // GDB keeps the process that was debugged until now as a
+        // fork, stopped.  Nothing can go back to it, so it goes.
+        int abandoned_fork_id = current_fork_id;
+        switch_to_checkpoint_fork (a_checkpoint_id);
+        list_frames (0, 0,
+                     sigc::bind
+                        (sigc::mem_fun
+                            (*this, &Priv::on_checkpoint_frame_listed),
+                         abandoned_fork_id, a_cookie),
+                     a_cookie);
+    }
+
+    /// Called when the process being debugged exited while GDB kept
+    /// the forks of some checkpoints.  GDB then forgets about the
+    /// exited process, and switches to the fork of a checkpoint by
+    /// itself.  Handle that like a restart from that checkpoint.
+    ///
+    /// \param a_pid the id of the process GDB switched to.
+    void on_exited_to_checkpoint (int a_pid, const UString &a_cookie)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        map<int, int>::const_iterator it;
+        for (it = checkpoint_forks.begin ();
+             it != checkpoint_forks.end ();
+             ++it) {
+            if (it->second == a_pid)
+                break;
+        }
+        if (it != checkpoint_forks.end ()) {
+            switch_to_checkpoint_fork (it->first);
+        } else {
+            LOG_ERROR ("GDB switched to an unknown fork: " << a_pid);
+            forget_checkpoints ();
+            target_pid = a_pid;
+        }
+        // Once a single process is left, GDB stops keeping it as a
+        // fork.
+        if (checkpoint_forks.empty ())
+            current_fork_id = -1;
+
+        list_frames (0, 0,
+                     sigc::bind
+                        (sigc::mem_fun
+                            (*this, &Priv::on_checkpoint_frame_listed),
+                         -1, a_cookie),
+                     a_cookie);
+    }
+
+    void on_checkpoint_frame_listed (const vector<IDebugger::Frame> &a_frames,
+                                     int a_abandoned_fork_id,
+                                     const UString &a_cookie)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        NEMIVER_TRY
+
+        // The inferior may have exited before being restarted from
+        // the checkpoint.
+        is_running = true;
+
+        // Restarting from a checkpoint switches to the fork GDB kept
+        // aside, which then runs from there: the checkpoint is gone.
+        // Set a new one at the same place right away, before the
+        // stop lets anything resume the inferior, so that it can be
+        // restarted from again.  checkpoint_set_signal tells its id.
+        queue_command (Command ("set-checkpoint", "checkpoint", a_cookie));
+
+        // Then get rid of the fork of the process that was debugged
+        // before the restart.  Doing it after setting the new
+        // checkpoint keeps GDB from leaving its fork mode, which
+        // would renumber the forks.
+        if (a_abandoned_fork_id >= 0 && a_abandoned_fork_id != current_fork_id)
+            queue_command (Command ("delete-checkpoint",
+                                    "delete checkpoint "
+                                    + UString::from_int (a_abandoned_fork_id),
+                                    a_cookie));
+
+        IDebugger::Frame frame;
+        if (!a_frames.empty ())
+            frame = a_frames[0];
+        stopped_signal.emit (IDebugger::UNDEFINED_REASON,
+                             !a_frames.empty (), frame,
+                             cur_thread_num, "", a_cookie);
+        set_state (IDebugger::READY);
+
+        NEMIVER_CATCH_NOX
+    }
+
     void on_frames_listed_signal (const vector<IDebugger::Frame> &a_frames,
                                   const UString &)
     {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
         NEMIVER_TRY
 
-        if (!a_frames.empty () && a_frames[0].level () == 0)
+        if (!a_frames.empty () && a_frames[0].level () == 0) {
             cur_frame_address = a_frames[0].address ();
+            // The frames are listed for the current thread.
+            stop_history.record_call_stack (a_frames, cur_thread_num);
+        }
+
+        NEMIVER_CATCH_NOX
+    }
+
+    void on_register_names_listed_signal
+                        (const std::map<register_id_t, UString> &a_names,
+                         const UString &)
+    {
+        NEMIVER_TRY
+        stop_history.record_register_names (a_names);
+        NEMIVER_CATCH_NOX
+    }
+
+    void on_register_values_listed_signal
+                        (const std::map<register_id_t, UString> &a_values,
+                         const UString &)
+    {
+        NEMIVER_TRY
+        stop_history.record_register_values (a_values);
+        NEMIVER_CATCH_NOX
+    }
 
+    void on_changed_variables_signal (const list<VariableSafePtr> &a_vars,
+                                      const UString &)
+    {
+        NEMIVER_TRY
+        list<VariableSafePtr>::const_iterator it;
+        for (it = a_vars.begin (); it != a_vars.end (); ++it) {
+            if (!*it)
+                continue;
+            // Variables which scope is not known can't be told
+            // apart from the ones of other frames; skip them.
+            std::map<UString, StopHistory::VariableScope>::const_iterator
+                scope = variable_scopes.find ((*it)->root ()->internal_name ());
+            if (scope != variable_scopes.end ())
+                record_variable_value (*it, scope->second);
+        }
         NEMIVER_CATCH_NOX
     }
 
+    /// Record the value of a variable, and of the members of it
+    /// that are known, into the stop history.
+    void record_variable_value (const VariableSafePtr &a_var,
+                                const StopHistory::VariableScope &a_scope)
+    {
+        if (!a_var)
+            return;
+        UString qname;
+        a_var->build_qname (qname);
+        stop_history.record_variable_value (a_scope, qname, a_var->value ());
+        IDebugger::VariableList::const_iterator it;
+        for (it = a_var->members ().begin ();
+             it != a_var->members ().end ();
+             ++it)
+            record_variable_value (*it, a_scope);
+    }
+
     void on_conf_key_changed_signal (const UString &a_key,
                                      const UString &a_namespace)
     {
@@ -1302,6 +2305,22 @@ public:
                                                disassembly_flavor,
                                                a_namespace)) {
             set_debugger_parameter ("disassembly-flavor", disassembly_flavor);
+        } else if (a_key == CONF_KEY_GDB_PROCESS_POOL
+                   && conf_mgr->get_key_value (a_key,
+                                               use_gdb_process_pool,
+                                               a_namespace)) {
+            if (!use_gdb_process_pool)
+                GDBProcessPool::get ().clear ();
+        } else if (a_key == CONF_KEY_TARGET_SIDE_CONDITIONS
+                   && conf_mgr->get_key_value (a_key,
+                                               target_side_conditions,
+                                               a_namespace)) {
+            set_condition_evaluation ();
+        } else if (a_key == CONF_KEY_GDB_NON_STOP_MODE) {
+            // Takes effect when the next GDB is launched.
+            conf_mgr->get_key_value (a_key,
+                                     non_stop_mode_requested,
+                                     a_namespace);
         }
 
         NEMIVER_CATCH_NOX
@@ -1322,6 +2341,9 @@ public:
 
     ~Priv ()
     {
+        released_varobjs_connection.disconnect ();
+        traced_breakpoints_connection.disconnect ();
+        library_events_connection.disconnect ();
         kill_gdb ();
     }
 };//end GDBEngine::Priv
@@ -1572,7 +2594,8 @@ struct OnBreakpointHandler: OutputHandler {
     /// \param b the breakpoint to add to the cache and to notify the
     /// listeners about.
     void
-    append_bp_to_cache_and_notify_bp_set (IDebugger::Breakpoint &b)
+    append_bp_to_cache_and_notify_bp_set (IDebugger::Breakpoint &b,
+                                          const UString &a_cookie = "")
     {
         LOG_DD ("Adding bp " << b.id () << "to cache");
         m_engine->append_breakpoint_to_cache (b);
@@ -1580,7 +2603,140 @@ struct OnBreakpointHandler: OutputHandler {
         map<string, IDebugger::Breakpoint> bps;
         bps[b.id ()] = b;
         LOG_DD ("Firing bp " << b.id() << " set");
-        m_engine->breakpoints_set_signal ().emit (bps, "");
+        m_engine->breakpoints_set_signal ().emit (bps, a_cookie);
+    }
+
+    /// \return true if a_breakpoint, as reported modified by GDB,
+    /// is a countpoint or a dprintf breakpoint that has just been
+    /// hit.
+    bool
+    is_traced_breakpoint_hit (const IDebugger::Breakpoint &a_breakpoint) const
+    {
+        IDebugger::Breakpoint cached;
+        if (!m_engine->get_breakpoint_from_cache (a_breakpoint.id (), cached))
+            return false;
+        return (cached.is_traced ()
+                && a_breakpoint.nb_times_hit () > cached.nb_times_hit ());
+    }
+
+    /// Update the cache with a countpoint or a dprintf breakpoint
+    /// that has just been hit, and have that hit notified along with
+    /// the others that happen shortly.
+    ///
+    /// \param b the breakpoint that was hit.
+    ///
+    /// \param a_output what the hit printed, if b is a dprintf.
+    void
+    record_traced_breakpoint_hit (IDebugger::Breakpoint &b,
+                                  const string &a_output)
+    {
+        b.last_hit_time (common::dateutils::get_current_datetime ());
+        if (b.type () == IDebugger::Breakpoint::DPRINTF_TYPE)
+            b.last_output (a_output);
+        m_engine->append_breakpoint_to_cache (b);
+
+        IDebugger::Breakpoint cached;
+        if (m_engine->get_breakpoint_from_cache (b.id (), cached))
+            m_engine->record_traced_breakpoint_hit (cached);
+    }
+
+    /// \return true if the output has an out of band record
+    /// reporting the deletion of a breakpoint.
+    bool
+    has_deleted_breakpoint (CommandAndOutput &a_in) const
+    {
+        for (Output::OutOfBandRecords::iterator i =
+                 a_in.output ().out_of_band_records ().begin ();
+             i != a_in.output ().out_of_band_records ().end ();
+             ++i) {
+            if (i->has_deleted_breakpoint ())
+                return true;
+        }
+        return false;
+    }
+
+    /// \return true if a_in is the successful reply of a command
+    /// that changes one property of an existing breakpoint, and that
+    /// we can thus apply to our breakpoint cache without asking GDB
+    /// for the whole breakpoint table again.
+    bool
+    is_breakpoint_property_change_done (CommandAndOutput &a_in) const
+    {
+        if (!a_in.output ().has_result_record ()
+            || a_in.output ().result_record ().kind ()
+               != Output::ResultRecord::DONE)
+            return false;
+        const UString &name = a_in.command ().name ();
+        return (name == "enable-breakpoint"
+                || name == "disable-breakpoint"
+                || name == "set-breakpoint-condition"
+                || name == "set-breakpoint-ignore-count");
+    }
+
+    /// Apply the change made by a successful enable-breakpoint,
+    /// disable-breakpoint, set-breakpoint-condition or
+    /// set-breakpoint-ignore-count command to the breakpoint cache,
+    /// and notify the listeners about the breakpoint that changed.
+    ///
+    /// If the breakpoint is not a top level breakpoint of the cache
+    /// (e.g, it's a location of a breakpoint that has several
+    /// locations), ask GDB about that single breakpoint instead.
+    void
+    apply_breakpoint_property_change (CommandAndOutput &a_in)
+    {
+        Command &c = a_in.command ();
+        const string bp_id = c.tag0 ().raw ();
+        map<string, IDebugger::Breakpoint> &breaks =
+            m_engine->get_cached_breakpoints ();
+        map<string, IDebugger::Breakpoint>::iterator it = breaks.find (bp_id);
+
+        if (it == breaks.end ()) {
+            string::size_type dot = bp_id.find ('.');
+            LOG_DD ("bp " << bp_id << " not in cache, fetching it");
+            Command command ("list-breakpoint",
+                             "-break-info " + bp_id.substr (0, dot),
+                             c.cookie ());
+            // The caller of IDebugger::enable_breakpoint gets called
+            // back once the breakpoint is fetched.
+            if (c.name () == "enable-breakpoint" && c.has_slot ()) {
+                IDebugger::BreakpointsSlot slot =
+                    c.get_slot<IDebugger::BreakpointsSlot> ();
+                command.set_slot (slot);
+            }
+            m_engine->queue_command (command);
+            return;
+        }
+
+        IDebugger::Breakpoint &b = it->second;
+        if (c.name () == "enable-breakpoint") {
+            b.enabled (true);
+        } else if (c.name () == "disable-breakpoint") {
+            b.enabled (false);
+        } else if (c.name () == "set-breakpoint-condition") {
+            b.condition (c.tag1 ().raw ());
+            // Only GDB knows whether the target can evaluate the new
+            // condition; ask it.
+            b.condition_evaluator ("");
+            if (b.has_condition ())
+                m_engine->queue_command
+                    (Command ("list-breakpoint",
+                              "-break-info " + b.parent_id (),
+                              c.cookie ()));
+        } else if (c.name () == "set-breakpoint-ignore-count") {
+            b.ignore_count (c.tag2 ());
+            b.initial_ignore_count (c.tag2 ());
+        }
+
+        map<string, IDebugger::Breakpoint> bps;
+        bps[b.id ()] = b;
+        if (c.name () == "enable-breakpoint" && c.has_slot ()) {
+            IDebugger::BreakpointsSlot slot =
+                c.get_slot<IDebugger::BreakpointsSlot> ();
+            LOG_DD ("Calling slot of IDebugger::enable_breakpoint()");
+            slot (bps);
+        }
+        LOG_DD ("Firing bp " << b.id () << " set");
+        m_engine->breakpoints_set_signal ().emit (bps, c.cookie ());
     }
 
     bool
@@ -1588,7 +2744,8 @@ struct OnBreakpointHandler: OutputHandler {
     {
         if (!a_in.output ().has_result_record ()
             && !has_overloads_prompt (a_in)
-            && !has_modified_breakpoint (a_in)) {
+            && !has_modified_breakpoint (a_in)
+            && !has_deleted_breakpoint (a_in)) {
             return false;
         }
         LOG_DD ("handler selected");
@@ -1623,29 +2780,90 @@ struct OnBreakpointHandler: OutputHandler {
             return;
         }
 
-        // If there is modified breakpoint, delete its previous
-        // version from the cache, notify the listeners about its
-        // deletion, add the new version to the cache and notify the
-        // listeners about its addition.
+        // If there are modified or newly created breakpoints,
+        // update them in the cache and notify the listeners about
+        // them alone.  Listeners of breakpoints_set_signal treat a
+        // breakpoint they already know as an update.  The hits of
+        // countpoints and dprintf breakpoints are only recorded;
+        // they are notified later, all at once.  Deleted
+        // breakpoints are removed from the cache and notified as
+        // such.
         {
+            // What GDB printed since the last modified breakpoint;
+            // that is the output of a dprintf that is hit.
+            string console_output;
             Output::OutOfBandRecords::iterator i, end;
-            if (has_modified_breakpoint (a_in, i)) {
-                LOG_DD ("has modified breakpoints!");
-                end = a_in.output ().out_of_band_records ().end ();
-                for (; i != end; ++i) {
-                    if (!i->has_modified_breakpoint ())
-                        continue;
+            end = a_in.output ().out_of_band_records ().end ();
+            for (i = a_in.output ().out_of_band_records ().begin ();
+                 i != end;
+                 ++i) {
+                if (i->has_stream_record ())
+                    console_output +=
+                        i->stream_record ().debugger_console ().raw ();
+                if (i->has_modified_breakpoint ()) {
                     IDebugger::Breakpoint &b = i->modified_breakpoint ();
-                    LOG_DD ("bp " << b.id () << ": notify deleted");
-                    notify_breakpoint_deleted_signal (b.id ());
+                    if (is_traced_breakpoint_hit (b)) {
+                        LOG_DD ("bp "
+                                << b.id ()
+                                << ": record hit");
+                        record_traced_breakpoint_hit (b, console_output);
+                    } else if (!a_in.has_command ()
+                               && m_engine->is_in_library_events_burst ()) {
+                        // GDB resolves the breakpoints again as
+                        // libraries get loaded; notify them all
+                        // once the libraries are.  A breakpoint
+                        // modified by a command, e.g. a new
+                        // condition, is notified right away, with
+                        // the cookie of that command.
+                        LOG_DD ("bp "
+                                << b.id ()
+                                << ": update cache, notify later");
+                        m_engine->append_breakpoint_to_cache (b);
+                        m_engine->record_breakpoint_resolved_in_burst (b);
+                    } else {
+                        LOG_DD ("bp "
+                                << b.id ()
+                                << ": update cache and notify set");
+                        append_bp_to_cache_and_notify_bp_set
+                            (b, a_in.has_command ()
+                                ? a_in.command ().cookie ()
+                                : UString (""));
+                    }
+                    console_output.clear ();
+                } else if (i->has_deleted_breakpoint ()) {
                     LOG_DD ("bp "
-                            << b.id ()
-                            << ": add to cache and notify set");
-                    append_bp_to_cache_and_notify_bp_set (b);
+                            << i->deleted_breakpoint_id ()
+                            << ": notify deleted");
+                    notify_breakpoint_deleted_signal
+                        (i->deleted_breakpoint_id ());
                 }
             }
         }
 
+        if (is_breakpoint_property_change_done (a_in)) {
+            apply_breakpoint_property_change (a_in);
+            return;
+        }
+
+        // The reply of -break-watch only carries the number of the
+        // new watchpoint; fetch the watchpoint alone.
+        if (a_in.command ().name () == "set-watchpoint"
+            && a_in.output ().has_result_record ()
+            && a_in.output ().result_record ().kind ()
+               == Output::ResultRecord::DONE) {
+            const map<UString, UString> &attrs =
+                a_in.output ().result_record ().attrs ();
+            map<UString, UString>::const_iterator it =
+                attrs.find ("watchpoint-number");
+            if (it != attrs.end ()) {
+                m_engine->queue_command
+                    (Command ("list-breakpoint",
+                              "-break-info " + it->second,
+                              a_in.command ().cookie ()));
+            }
+            return;
+        }
+
         bool has_breaks_set = false;
         //if breakpoint where set, put them in cache !
         if (has_breakpoints_set (a_in)) {
@@ -1665,7 +2883,9 @@ struct OnBreakpointHandler: OutputHandler {
 
         if (has_breaks_set
             && (a_in.command ().name () == "set-breakpoint"
-                || a_in.command ().name () == "set-countpoint")) {
+                || a_in.command ().name () == "set-countpoint"
+                || a_in.command ().name () == "set-dprintf"
+                || a_in.command ().name () == "list-breakpoint")) {
             // We are getting this reply b/c we did set a breakpoint;
             // be aware that sometimes GDB can actually set multiple
             // breakpoints as a result.
@@ -1673,11 +2893,14 @@ struct OnBreakpointHandler: OutputHandler {
                 a_in.output ().result_record ().breakpoints ();
 
             Command &c = a_in.command ();
-            if (c.name () == "set-breakpoint"
+            // A list-breakpoint command has a slot when it fetches a
+            // location that IDebugger::enable_breakpoint enabled.
+            if ((c.name () == "set-breakpoint"
+                 || c.name () == "list-breakpoint")
                 && c.has_slot ()) {
                 IDebugger::BreakpointsSlot slot =
                     c.get_slot<IDebugger::BreakpointsSlot> ();
-                LOG_DD ("Calling slot of IDebugger::set_breakpoint()");
+                LOG_DD ("Calling slot of " << c.name ());
                 slot (bps);
             }
             LOG_DD ("Emitting IDebugger::breakpoints_set_signal()");
@@ -1749,6 +2972,8 @@ struct OnStoppedHandler: OutputHandler {
              --iter) {
             if (iter->is_running ())
                 break;
+            if (iter->is_stopped () && is_traced_breakpoint_stop (*iter))
+                continue;
             if (iter->is_stopped ()) {
                 m_is_stopped = true;
                 m_out_of_band_record = *iter;
@@ -1758,6 +2983,48 @@ struct OnStoppedHandler: OutputHandler {
         return false;
     }
 
+    /// \return the id of the process GDB switched to when the
+    /// process being debugged exited while GDB kept the forks of
+    /// some checkpoints, e.g. from "[Switching to process 4242]", or
+    /// 0 if GDB didn't switch.
+    int extract_switched_to_pid (CommandAndOutput &a_in) const
+    {
+        static const string prefix = "[Switching to ";
+        list<Output::OutOfBandRecord>::const_iterator it;
+        for (it = a_in.output ().out_of_band_records ().begin ();
+             it != a_in.output ().out_of_band_records ().end ();
+             ++it) {
+            if (!it->has_stream_record ())
+                continue;
+            const string &console =
+                it->stream_record ().debugger_console ().raw ();
+            string::size_type pos = console.find (prefix);
+            if (pos == string::npos)
+                continue;
+            // E.g. "process 4242", or "Thread 0x7ffff7fd8740 (LWP
+            // 4242)" for a threaded inferior.
+            string::size_type lwp = console.find ("LWP ", pos);
+            if (lwp != string::npos)
+                return atoi (console.c_str () + lwp + 4);
+            string::size_type process = console.find ("process ", pos);
+            if (process != string::npos)
+                return atoi (console.c_str () + process + 8);
+        }
+        return 0;
+    }
+
+    /// \return true if a_record reports a stop at a countpoint.
+    /// GDB resumes the inferior right away, so that stop is not
+    /// notified; the hit is recorded from the =breakpoint-modified
+    /// record that comes with it.
+    bool is_traced_breakpoint_stop (Output::OutOfBandRecord &a_record)
+    {
+        if (a_record.stop_reason () != IDebugger::BREAKPOINT_HIT)
+            return false;
+        return m_engine->is_countpoint
+            (UString::from_int (a_record.breakpoint_number ()).raw ());
+    }
+
     void do_handle (CommandAndOutput &a_in)
     {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
@@ -1779,6 +3046,23 @@ struct OnStoppedHandler: OutputHandler {
                     (m_out_of_band_record.frame ().level ());
         }
 
+        if (m_engine->fast_forward_stopped (reason,
+                                            m_out_of_band_record.has_frame (),
+                                            m_out_of_band_record.frame (),
+                                            thread_id))
+            return;
+
+        // If the process exited while GDB kept checkpoints, GDB is
+        // now debugging the fork of one of them.
+        if (IDebugger::is_exited (reason)) {
+            int pid = extract_switched_to_pid (a_in);
+            if (pid > 0) {
+                m_engine->exited_to_checkpoint (pid,
+                                                a_in.command ().cookie ());
+                return;
+            }
+        }
+
         m_engine->stopped_signal ().emit
                     (m_out_of_band_record.stop_reason (),
                      m_out_of_band_record.has_frame (),
@@ -1799,6 +3083,43 @@ struct OnStoppedHandler: OutputHandler {
     }
 };//end struct OnStoppedHandler
 
+/// Handles the evaluation of the expression watched by the
+/// fast-forward stepping.  Its value, or its failure, is handed to
+/// the slot of the command.
+struct OnFastForwardHandler : OutputHandler {
+    GDBEngine *m_engine;
+
+    OnFastForwardHandler (GDBEngine *a_engine) :
+        m_engine (a_engine)
+    {}
+
+    bool can_handle (CommandAndOutput &a_in)
+    {
+        return (a_in.has_command ()
+                && a_in.command ().name () == "fast-forward-evaluate"
+                && a_in.output ().has_result_record ());
+    }
+
+    void do_handle (CommandAndOutput &a_in)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        const Output::ResultRecord &record = a_in.output ().result_record ();
+        bool evaluated = (record.kind () == Output::ResultRecord::DONE
+                          && record.has_variable_value ()
+                          && record.variable_value ());
+        UString value;
+        if (evaluated)
+            value = record.variable_value ()->value ();
+
+        if (a_in.command ().has_slot ()) {
+            typedef sigc::slot<void, bool, const UString&> SlotType;
+            SlotType slot = a_in.command ().get_slot<SlotType> ();
+            slot (evaluated, value);
+        }
+    }
+};//end struct OnFastForwardHandler
+
 struct OnFileListHandler : OutputHandler {
     GDBEngine *m_engine;
 
@@ -1859,6 +3180,44 @@ struct OnThreadListHandler : OutputHandler {
     }
 };//end OnThreadListHandler
 
+struct OnLibraryEventHandler : OutputHandler {
+    GDBEngine *m_engine;
+
+    OnLibraryEventHandler (GDBEngine *a_engine) :
+        m_engine (a_engine)
+    {}
+
+    bool can_handle (CommandAndOutput &a_in)
+    {
+        if (!a_in.output ().has_out_of_band_record ())
+            return false;
+        list<Output::OutOfBandRecord>::const_iterator it;
+        for (it = a_in.output ().out_of_band_records ().begin ();
+             it != a_in.output ().out_of_band_records ().end ();
+             ++it) {
+            if (it->library_event ()) {
+                LOG_DD ("handler selected");
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void do_handle (CommandAndOutput &a_in)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        THROW_IF_FAIL (m_engine);
+        list<Output::OutOfBandRecord>::const_iterator it;
+        for (it = a_in.output ().out_of_band_records ().begin ();
+             it != a_in.output ().out_of_band_records ().end ();
+             ++it) {
+            if (it->library_event ())
+                m_engine->record_library_event (*it);
+        }
+    }
+};//end struct OnLibraryEventHandler
+
 struct OnThreadSelectedHandler : OutputHandler {
     GDBEngine *m_engine;
     long thread_id;
@@ -1899,6 +3258,10 @@ struct OnThreadSelectedHandler : OutputHandler {
 
         THROW_IF_FAIL (m_engine);
 
+        if (a_in.command ().name () == "select-thread"
+            && !a_in.command ().should_emit_signal ())
+            return;
+
         m_engine->thread_selected_signal ().emit
             (thread_id,
              has_frame
@@ -1997,12 +3360,7 @@ struct OnCommandDoneHandler : OutputHandler {
             }
         }
 
-        if (a_in.command ().name () == "-break-enable"
-            && a_in.command ().has_slot ()) {
-            IDebugger::BreakpointsSlot slot =
-                a_in.command ().get_slot<IDebugger::BreakpointsSlot> ();
-            slot (m_engine->get_cached_breakpoints ());
-        } else if (a_in.command ().name () == "set-variable-visualizer") {
+        if (a_in.command ().name () == "set-variable-visualizer") {
             VariableSafePtr var = a_in.command ().variable ();
             THROW_IF_FAIL (var);
             var->visualizer (a_in.command ().tag0 ());
@@ -2022,6 +3380,85 @@ struct OnCommandDoneHandler : OutputHandler {
     }
 };//struct OnCommandDoneHandler
 
+/// Handles the replies of the "checkpoint" and "restart" commands
+/// of GDB.  The former forks the inferior and keeps the fork aside;
+/// the latter switches to such a fork.
+struct OnCheckpointHandler : OutputHandler {
+    GDBEngine *m_engine;
+
+    OnCheckpointHandler (GDBEngine *a_engine) :
+        m_engine (a_engine)
+    {}
+
+    bool can_handle (CommandAndOutput &a_in)
+    {
+        if (!a_in.has_command ()
+            || (a_in.command ().name () != "set-checkpoint"
+                && a_in.command ().name () != "restart-from-checkpoint"))
+            return false;
+        return (a_in.output ().has_result_record ()
+                && a_in.output ().result_record ().kind ()
+                   == Output::ResultRecord::DONE);
+    }
+
+    /// Get the checkpoint GDB announced on its console, e.g.
+    /// "checkpoint 1: fork returned pid 4242."
+    ///
+    /// \param a_id out parameter.  The id of the checkpoint.
+    ///
+    /// \param a_pid out parameter.  The id of the process GDB
+    /// forked for the checkpoint, or 0 if GDB didn't tell.
+    ///
+    /// \return true if a checkpoint was announced, false otherwise.
+    bool
+    extract_checkpoint (CommandAndOutput &a_in, int &a_id, int &a_pid) const
+    {
+        static const string prefix = "checkpoint ";
+        static const string pid_prefix = "pid ";
+        list<Output::OutOfBandRecord>::const_iterator it;
+        for (it = a_in.output ().out_of_band_records ().begin ();
+             it != a_in.output ().out_of_band_records ().end ();
+             ++it) {
+            if (!it->has_stream_record ())
+                continue;
+            const string &console =
+                it->stream_record ().debugger_console ().raw ();
+            string::size_type pos = console.find (prefix);
+            if (pos == string::npos
+                || !isdigit (console[pos + prefix.size ()]))
+                continue;
+            a_id = atoi (console.c_str () + pos + prefix.size ());
+            a_pid = 0;
+            pos = console.find (pid_prefix, pos);
+            if (pos != string::npos)
+                a_pid = atoi (console.c_str () + pos + pid_prefix.size ());
+            return true;
+        }
+        return false;
+    }
+
+    void do_handle (CommandAndOutput &a_in)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        THROW_IF_FAIL (m_engine);
+
+        Command &c = a_in.command ();
+        if (c.name () == "set-checkpoint") {
+            int id = 0, pid = 0;
+            if (!extract_checkpoint (a_in, id, pid)) {
+                LOG_ERROR ("could not find the id of the new checkpoint");
+                return;
+            }
+            m_engine->record_checkpoint (id, pid);
+            m_engine->checkpoint_set_signal ().emit (id, c.cookie ());
+        } else if (c.has_slot ()) {
+            IDebugger::DefaultSlot slot = c.get_slot<IDebugger::DefaultSlot> ();
+            slot ();
+        }
+    }
+};//struct OnCheckpointHandler
+
 struct OnRunningHandler : OutputHandler {
 
     GDBEngine *m_engine;
@@ -2064,6 +3501,54 @@ struct OnRunningHandler : OutputHandler {
     }
 };//struct OnRunningHandler
 
+/// Keeps track of which threads of the inferior are running, from
+/// the *running and *stopped records.
+struct OnThreadStateHandler : OutputHandler {
+    GDBEngine *m_engine;
+
+    OnThreadStateHandler (GDBEngine *a_engine) :
+        m_engine (a_engine)
+    {}
+
+    bool can_handle (CommandAndOutput &a_in)
+    {
+        if (!a_in.output ().has_out_of_band_record ())
+            return false;
+        list<Output::OutOfBandRecord>::const_iterator it;
+        for (it = a_in.output ().out_of_band_records ().begin ();
+             it != a_in.output ().out_of_band_records ().end ();
+             ++it) {
+            if (it->is_running () || it->is_stopped ())
+                return true;
+        }
+        return false;
+    }
+
+    void do_handle (CommandAndOutput &a_in)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        THROW_IF_FAIL (m_engine);
+
+        list<Output::OutOfBandRecord>::const_iterator it;
+        for (it = a_in.output ().out_of_band_records ().begin ();
+             it != a_in.output ().out_of_band_records ().end ();
+             ++it) {
+            if (it->is_running ()) {
+                // The thread id is -1 if all the threads run.
+                m_engine->set_thread_running (it->thread_id (), true);
+            } else if (it->is_stopped ()) {
+                // In all-stop mode, all the threads stop together.
+                if (!m_engine->is_non_stop_mode ()
+                    || IDebugger::is_exited (it->stop_reason ()))
+                    m_engine->set_thread_running (-1, false);
+                else
+                    m_engine->set_thread_running (it->thread_id (), false);
+            }
+        }
+    }
+};//struct OnThreadStateHandler
+
 struct OnConnectedHandler : OutputHandler {
     GDBEngine *m_engine;
 
@@ -2830,10 +4315,18 @@ struct OnSetMemoryHandler : OutputHandler
         size_t addr = 0;
         std::istringstream istream (a_in.command ().tag1 ());
         istream >> std::hex >> addr;
+
+        // tag3 holds the bytes that were written, as hexadecimal
+        // digits.
+        const std::string &contents = a_in.command ().tag3 ().raw ();
+        std::vector<uint8_t> bytes;
+        bytes.reserve (contents.size () / 2);
+        for (std::string::size_type i = 0; i + 1 < contents.size (); i += 2)
+            bytes.push_back (g_ascii_xdigit_value (contents[i]) * 16
+                             + g_ascii_xdigit_value (contents[i + 1]));
+
         m_engine->set_memory_signal ().emit
-            (addr,
-             std::vector<uint8_t>(), // FIXME: get memory value here
-             a_in.command ().cookie ());
+            (addr, bytes, a_in.command ().cookie ());
         m_engine->set_state (IDebugger::READY);
     }
 };//struct OnSetRegisterValueHandler
@@ -2863,13 +4356,37 @@ struct OnErrorHandler : OutputHandler {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
 
         THROW_IF_FAIL (m_engine);
-        m_engine->error_signal ().emit
-            (a_in.output ().result_record ().attrs ()["msg"]);
+        UString msg = a_in.output ().result_record ().attrs ()["msg"];
+        // A released variable object might be gone already, e.g,
+        // along with its parent.  That's not worth bothering the
+        // user.  Neither is the failed evaluation that normally ends
+        // a fast-forward stepping, when the inferior leaves the scope
+        // of the watched expression, nor the failed deletion of the
+        // fork a restart from a checkpoint left behind.
+        if (a_in.command ().name () != "release-variable"
+            && a_in.command ().name () != "fast-forward-evaluate"
+            && a_in.command ().name () != "delete-checkpoint")
+            m_engine->error_signal ().emit (msg);
+        m_engine->command_error_signal ().emit (a_in.command ().name (),
+                                                a_in.command ().cookie (),
+                                                msg);
 
         if (m_engine->get_state () != IDebugger::PROGRAM_EXITED
             || m_engine->get_state () != IDebugger::NOT_STARTED) {
             m_engine->set_state (IDebugger::READY);
         }
+
+        // The callers of set_variable_visualizer wait for its slot to
+        // go on, e.g. a revisualization unfolds the parent variable
+        // once the visualizer of its last member is set.  Call it
+        // anyway; the variable just keeps its previous visualizer.
+        if (a_in.command ().name () == "set-variable-visualizer"
+            && a_in.command ().variable ()
+            && a_in.command ().has_slot ()) {
+            ConstVariableSlot slot =
+                a_in.command ().get_slot<ConstVariableSlot> ();
+            slot (a_in.command ().variable ());
+        }
     }
 };//struct OnErrorHandler
 
@@ -2957,11 +4474,18 @@ struct OnCreateVariableHandler : public OutputHandler
         VariableSafePtr var = a_in.output ().result_record ().variable ();
         if (!var->internal_name ().empty ())
         var->debugger (m_engine);
+        m_engine->reclaim_variable (var->internal_name ());
 
         // Set the name of the variable to the name that got stored
         // in the tag0 member of the command.
         var->name (a_in.command ().tag0 ());
 
+        // The command holds the scope the variable got created in:
+        // tag2 is the thread, and tag1 the function.
+        m_engine->record_variable_value
+            (var, StopHistory::VariableScope (a_in.command ().tag2 (),
+                                              a_in.command ().tag1 ()));
+
         // Call the slot associated to IDebugger::create_variable (), if
         // any.
         if (a_in.command ().has_slot ()) {
@@ -2997,7 +4521,8 @@ struct OnDeleteVariableHandler : public OutputHandler {
         if (a_in.output ().has_result_record ()
             && (a_in.output ().result_record ().kind ()
             == Output::ResultRecord::DONE)
-            && (a_in.command ().name () == "delete-variable")
+            && (a_in.command ().name () == "delete-variable"
+                || a_in.command ().name () == "release-variable")
             && (a_in.output ().result_record ().number_of_variables_deleted ())) {
             LOG_DD ("handler selected");
             return true;
@@ -3068,6 +4593,7 @@ struct OnUnfoldVariableHandler : public OutputHandler {
         for (Variables::const_iterator it = children_vars.begin ();
              it != children_vars.end ();
              ++it) {
+            m_engine->reclaim_variable ((*it)->internal_name ());
             parent_var->append (*it);
         }
 
@@ -3394,6 +4920,32 @@ GDBEngine::load_program (const UString &a_prog,
     return true;
 }
 
+/// Spawn, in the background, a GDB process that loads a given
+/// program, and put it in the GDBProcessPool.  A later load_program
+/// on that program in that working directory then picks it up.
+///
+/// This does nothing unless the gdb-process-pool setting is on.
+///
+/// \param a_prog the path to the program.
+///
+/// \param a_working_dir the working directory of the program.
+void
+GDBEngine::prewarm_program (const UString &a_prog,
+                            const UString &a_working_dir)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (!m_priv->use_gdb_process_pool || a_prog.empty ())
+        return;
+
+    vector<UString> argv, gdb_opts;
+    UString prog_path;
+    if (!m_priv->build_gdb_argv (a_working_dir, a_prog, gdb_opts,
+                                 argv, prog_path))
+        return;
+    m_priv->queue_prewarm (argv, prog_path);
+}
+
 void
 GDBEngine::load_core_file (const UString &a_prog_path,
                            const UString &a_core_path)
@@ -3426,6 +4978,7 @@ GDBEngine::attach_to_target (unsigned int a_pid,
         Command command;
         command.value ("set breakpoint pending auto");
         queue_command (command);
+        m_priv->set_non_stop_mode ();
         //tell the linker to do all relocations at program load
         //time so that some "step into" don't take for ever.
         //On GDB, it seems that stepping into a function that is
@@ -3454,6 +5007,7 @@ GDBEngine::attach_to_remote_target (const UString &a_host,
 {
 	queue_command (Command ("-target-select remote " + a_host +
                             ":" + UString::from_int (a_port)));
+    return true;
 }
 
 bool
@@ -3672,10 +5226,13 @@ GDBEngine::get_mi_thread_location (UString &a_str) const
 void
 GDBEngine::init_output_handlers ()
 {
+    m_priv->output_handler_list.perf_stats (&m_priv->perf_stats);
     m_priv->output_handler_list.add
                 (OutputHandlerSafePtr (new OnStreamRecordHandler (this)));
     m_priv->output_handler_list.add
                 (OutputHandlerSafePtr (new OnDetachHandler (this)));
+    m_priv->output_handler_list.add
+                (OutputHandlerSafePtr (new OnThreadStateHandler (this)));
     m_priv->output_handler_list.add
                 (OutputHandlerSafePtr (new OnStoppedHandler (this)));
     m_priv->output_handler_list.add
@@ -3684,6 +5241,10 @@ GDBEngine::init_output_handlers ()
                 (OutputHandlerSafePtr (new OnCommandDoneHandler (this)));
     m_priv->output_handler_list.add
                 (OutputHandlerSafePtr (new OnRunningHandler (this)));
+    m_priv->output_handler_list.add
+                (OutputHandlerSafePtr (new OnCheckpointHandler (this)));
+    m_priv->output_handler_list.add
+                (OutputHandlerSafePtr (new OnFastForwardHandler (this)));
     m_priv->output_handler_list.add
                 (OutputHandlerSafePtr (new OnConnectedHandler (this)));
     m_priv->output_handler_list.add
@@ -3710,6 +5271,8 @@ GDBEngine::init_output_handlers ()
             (OutputHandlerSafePtr (new OnThreadListHandler (this)));
     m_priv->output_handler_list.add
             (OutputHandlerSafePtr (new OnThreadSelectedHandler (this)));
+    m_priv->output_handler_list.add
+            (OutputHandlerSafePtr (new OnLibraryEventHandler (this)));
     m_priv->output_handler_list.add
             (OutputHandlerSafePtr (new OnFileListHandler (this)));
     m_priv->output_handler_list.add
@@ -3803,6 +5366,20 @@ GDBEngine::inferior_re_run_signal () const
     return m_priv->inferior_re_run_signal;
 }
 
+/// Return a reference on the IDebugger::checkpoint_set_signal.
+sigc::signal<void, int, const UString&>&
+GDBEngine::checkpoint_set_signal () const
+{
+    return m_priv->checkpoint_set_signal;
+}
+
+/// Return a reference on the IDebugger::libraries_changed_signal.
+sigc::signal<void>&
+GDBEngine::libraries_changed_signal () const
+{
+    return m_priv->libraries_changed_signal;
+}
+
 sigc::signal<void, const IDebugger::Breakpoint&, const string&, const UString&>&
 GDBEngine::breakpoint_deleted_signal () const
 {
@@ -3856,6 +5433,12 @@ GDBEngine::thread_selected_signal () const
     return m_priv->thread_selected_signal;
 }
 
+sigc::signal<void, int, bool>&
+GDBEngine::thread_state_changed_signal () const
+{
+    return m_priv->thread_state_changed_signal;
+}
+
 sigc::signal<void, const vector<IDebugger::Frame>&, const UString&>&
 GDBEngine::frames_listed_signal () const
 {
@@ -4007,6 +5590,12 @@ GDBEngine::error_signal () const
     return m_priv->error_signal;
 }
 
+sigc::signal<void, const UString&, const UString&, const UString&>&
+GDBEngine::command_error_signal () const
+{
+    return m_priv->command_error_signal;
+}
+
 sigc::signal<void>&
 GDBEngine::program_finished_signal () const
 {
@@ -4065,6 +5654,14 @@ GDBEngine::assigned_variable_signal () const
     return m_priv->assigned_variable_signal;
 }
 
+/// Return a reference on the
+/// IDebugger::variables_revisualization_progress_signal.
+sigc::signal<void, int, int>&
+GDBEngine::variables_revisualization_progress_signal () const
+{
+    return m_priv->variables_revisualization_progress_signal;
+}
+
 //******************
 //<signal handlers>
 //******************
@@ -4182,10 +5779,13 @@ GDBEngine::on_rv_unfold_var (const VariableSafePtr a_var,
 /// GDBEngine::unfold_variable_with_visualizer.
 ///
 /// It triggers the setting of the pretty-printing visualizer of each
-/// member variable of a given variable.  Once each member variable
-/// has seen its visualizer set, the initial variable is unfolded.
-/// The resulting children variables will be unfolded and rendered
-/// using the visualize that got set on their children.
+/// member variable of a given variable.  The -var-set-visualizer
+/// commands of all the members are queued at once, so that they are
+/// sent to GDB back to back rather than waiting for each other's
+/// callback.  Once the last member variable has seen its visualizer
+/// set, the initial variable is unfolded, once.  The resulting
+/// children variables will be unfolded and rendered using the
+/// visualizer that got set on their children.
 ///
 /// \param a_var the variable to act upon.  The member variables of
 /// this one are the ones that are going to see their visualizer set.
@@ -4204,18 +5804,29 @@ GDBEngine::on_rv_set_visualizer_on_members (const VariableSafePtr a_var,
 {
     NEMIVER_TRY;
 
+    THROW_IF_FAIL (a_var);
+
+    if (a_var->members ().empty ()) {
+        if (a_slot)
+            a_slot (a_var);
+        return;
+    }
+
+    m_priv->num_revisualized_members += a_var->members ().size ();
+
     IDebugger::VariableList::iterator it = a_var->members ().begin (),
         end = a_var->members ().end ();
-
-    if (it != end)
+    while (it != end) {
+        IDebugger::VariableSafePtr member = *it;
+        bool is_last = (++it == end);
         set_variable_visualizer
-            (*it,
+            (member,
              a_visualizer,
              sigc::bind
              (sigc::mem_fun
-              (*this,
-               &GDBEngine::on_rv_set_visualizer_on_next_sibling),
-              a_visualizer, it, end, a_slot));
+              (*this, &GDBEngine::on_rv_member_visualizer_set),
+              a_var, is_last, a_visualizer, a_slot));
+    }
 
     NEMIVER_CATCH_NOX;
 }
@@ -4224,56 +5835,53 @@ GDBEngine::on_rv_set_visualizer_on_members (const VariableSafePtr a_var,
 /// GDBEngine::set_variable_visualizer, connected by
 /// GDBEngine::on_rv_set_visualizer_on_members.
 ///
-/// It sets the pretty-printing visualizer for the next sibling
-/// variable.  Once it reached the last sibling, it unfolds the parent
-/// variable, forcing the the re-printing of the siblings of the this
-/// function walked through, with a the new visualizer it did set.
+/// It reports the progress of the pending revisualizations.  It is
+/// called whether the visualizer could be set or not, so the
+/// progress always reaches its end, and a_slot is always called.  The
+/// commands queued by GDBEngine::on_rv_set_visualizer_on_members
+/// complete in order, so once the visualizer of the last member has
+/// been set, this unfolds the parent variable, forcing the
+/// re-printing of its members with the new visualizer.
 ///
-/// \param a_var the variable which visualizer got set at the previous
-/// invocation of this function.
+/// \param a_member the member variable which visualizer got set.
+/// It is unused.
 ///
-/// \param a_member_it an iterator pointing to the previous sibling
-/// variable which visualuzer got set.  So this function is going to
-/// set the visualizer of ++a_member_it.
+/// \param a_parent the parent variable of a_member.
 ///
-/// \param a_members_end  an iterator pointing to right after the last
-/// slibling variable we need to walk.
+/// \param a_is_last true if a_member is the last member of a_parent.
 ///
-/// \param a_slot the callback slot to invoke once the parent variable
-/// of a_var has been unfolded.
+/// \param a_visualizer the visualizer that got set on a_member.
+///
+/// \param a_slot the callback slot to invoke once a_parent has been
+/// unfolded.
 void
-GDBEngine::on_rv_set_visualizer_on_next_sibling
-(const VariableSafePtr a_var,
- const UString &a_visualizer,
- IDebugger::VariableList::iterator a_member_it,
- IDebugger::VariableList::iterator a_members_end,
- const ConstVariableSlot &a_slot)
+GDBEngine::on_rv_member_visualizer_set (const VariableSafePtr a_member,
+                                        const VariableSafePtr a_parent,
+                                        bool a_is_last,
+                                        const UString &a_visualizer,
+                                        const ConstVariableSlot &a_slot)
 {
     NEMIVER_TRY;
 
-    THROW_IF_FAIL (a_member_it != a_members_end);
-
-    ++a_member_it;
-    if (a_member_it != a_members_end) {
-        set_variable_visualizer
-            (*a_member_it,
-             a_visualizer,
-             sigc::bind
-             (sigc::mem_fun
-              (*this,
-               &GDBEngine::on_rv_set_visualizer_on_next_sibling),
-              a_visualizer, a_member_it, a_members_end, a_slot));
-    } else {
-        IDebugger::VariableList::iterator it;
-        IDebugger::VariableSafePtr parent = a_var->parent ();
-        // This invalidates a_member_it and a_members_end iterators.
-        parent->members ().clear ();
-        unfold_variable (parent,
-                         sigc::bind
-                         (sigc::mem_fun (*this, &GDBEngine::on_rv_flag),
-                          a_visualizer, a_slot),
-                         "");
+    ++m_priv->num_revisualized_members_done;
+    int done = m_priv->num_revisualized_members_done,
+        total = m_priv->num_revisualized_members;
+    if (done >= total) {
+        m_priv->num_revisualized_members = 0;
+        m_priv->num_revisualized_members_done = 0;
     }
+    variables_revisualization_progress_signal ().emit (done, total);
+
+    if (!a_is_last)
+        return;
+
+    THROW_IF_FAIL (a_parent);
+    a_parent->members ().clear ();
+    unfold_variable (a_parent,
+                     sigc::bind
+                     (sigc::mem_fun (*this, &GDBEngine::on_rv_flag),
+                      a_visualizer, a_slot),
+                     "");
 
     NEMIVER_CATCH_NOX;
 }
@@ -4484,7 +6092,7 @@ GDBEngine::do_continue (const UString &a_cookie)
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     Command command ("do-continue",
-                     "-exec-continue ",
+                     "-exec-continue" + m_priv->exec_thread_option (),
                      a_cookie);
     queue_command (command);
 }
@@ -4518,11 +6126,60 @@ GDBEngine::re_run (const DefaultSlot &a_slot)
         LOG_DD ("Requested to stop GDB");
     }
 
+    // Killing the inferior kills the forks of its checkpoints.
+    m_priv->forget_checkpoints ();
+
     Command command ("re-run", "-exec-run");
     command.set_slot (a_slot);
     queue_command (command);
 }
 
+/// Save the state of the stopped inferior in a checkpoint, using the
+/// "checkpoint" command of GDB, which forks the inferior.  Once
+/// done, IDebugger::checkpoint_set_signal is emitted.
+///
+/// \param a_cookie the cookie passed to
+/// IDebugger::checkpoint_set_signal.
+void
+GDBEngine::set_checkpoint (const UString &a_cookie)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    queue_command (Command ("set-checkpoint", "checkpoint", a_cookie));
+}
+
+/// Restart the inferior from a checkpoint set by set_checkpoint.
+/// This is much faster than re-running the program when its startup
+/// is slow.  Once done, IDebugger::stopped_signal is emitted with
+/// the frame the inferior is at in the checkpoint.
+///
+/// Restarting uses the checkpoint up, so a new checkpoint is set
+/// there at once.  IDebugger::checkpoint_set_signal then notifies
+/// its id, which is the one to restart from next time.  The fork
+/// GDB keeps of the process debugged until the restart is deleted,
+/// so that forks don't pile up across restarts.
+///
+/// \param a_checkpoint_id the id of the checkpoint, as notified by
+/// IDebugger::checkpoint_set_signal.
+///
+/// \param a_cookie the cookie passed to IDebugger::stopped_signal.
+void
+GDBEngine::restart_from_checkpoint (int a_checkpoint_id,
+                                    const UString &a_cookie)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    Command command ("restart-from-checkpoint",
+                     "restart " + UString::from_int (a_checkpoint_id),
+                     a_cookie);
+    command.set_slot
+        (IDebugger::DefaultSlot
+            (sigc::bind (sigc::mem_fun
+                            (*m_priv, &Priv::on_restarted_from_checkpoint),
+                         a_checkpoint_id, a_cookie)));
+    queue_command (command);
+}
+
 void
 GDBEngine::get_target_info (const UString &a_cookie)
 {
@@ -4608,6 +6265,17 @@ GDBEngine::stop_target ()
         return false;
     }
 
+    // In non-stop mode, GDB accepts commands while threads are
+    // running.  Interrupt the current thread, or all the threads
+    // if that one is stopped already.
+    if (m_priv->non_stop_mode) {
+        UString option = is_thread_running (get_current_thread ())
+            ? m_priv->exec_thread_option ()
+            : UString (" --all");
+        return queue_command (Command ("interrupt",
+                                       "-exec-interrupt" + option));
+    }
+
     //return  (kill (m_priv->target_pid, SIGINT) == 0);
     return  (kill (m_priv->gdb_pid, SIGINT) == 0);
 }
@@ -4632,6 +6300,7 @@ GDBEngine::exit_engine ()
     //send the lethal command and run the event loop to flush everything.
     m_priv->issue_command (Command ("quit"), false);
     set_state (IDebugger::NOT_STARTED);
+    IDebugger::Variable::release_memory_when_unused ();
 
     // Set the tty attribute back into the state it was before we
     // connected to the target.
@@ -4644,7 +6313,7 @@ GDBEngine::step_in (const UString &a_cookie)
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     Command command ("step-in",
-                     "-exec-step",
+                     "-exec-step" + m_priv->exec_thread_option (),
                      a_cookie);
     queue_command (command);
 }
@@ -4655,7 +6324,7 @@ GDBEngine::step_out (const UString &a_cookie)
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     Command command ("step-out",
-                     "-exec-finish",
+                     "-exec-finish" + m_priv->exec_thread_option (),
                      a_cookie);
     queue_command (command);
 }
@@ -4666,18 +6335,127 @@ GDBEngine::step_over (const UString &a_cookie)
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     Command command ("step-over",
-                     "-exec-next ",
+                     "-exec-next" + m_priv->exec_thread_option (),
+                     a_cookie);
+    queue_command (command);
+}
+
+/// Step over a number of lines in a row, like the "next N" command
+/// of GDB does.  Only the last stop is notified by
+/// IDebugger::stopped_signal, so the views refresh only once.  The
+/// stepping ends early if a breakpoint is hit.
+///
+/// \param a_nb_steps the number of lines to step over.
+///
+/// \param a_cookie the cookie passed to IDebugger::stopped_signal.
+void
+GDBEngine::fast_forward_step_over (unsigned a_nb_steps,
+                                   const UString &a_cookie)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (!a_nb_steps)
+        return;
+
+    Command command ("step-over",
+                     "-exec-next" + m_priv->exec_thread_option ()
+                     + " " + UString::from_int (a_nb_steps),
                      a_cookie);
     queue_command (command);
 }
 
+/// Step over lines until the value of an expression changes.  The
+/// expression is evaluated by GDB after each step, but only the
+/// last stop is notified by IDebugger::stopped_signal, so the views
+/// refresh only once.
+///
+/// The stepping also ends if the expression cannot be evaluated
+/// anymore, e.g. when the inferior leaves its scope, or if the
+/// inferior stops for another reason, e.g. at a breakpoint.
+///
+/// To step until the current function returns, use step_out, which
+/// GDB runs at once too.
+///
+/// Like the other commands, the stepping starts once the commands
+/// queued before it are done; their stops are notified as usual.
+/// The request is ignored if a fast-forward stepping is in progress
+/// already.  Queuing another command that resumes the inferior,
+/// e.g. step_over, cancels the stepping.
+///
+/// \param a_expression the expression to watch.
+///
+/// \param a_max_nb_steps the maximum number of lines to step over.
+///
+/// \param a_cookie the cookie passed to IDebugger::stopped_signal.
+void
+GDBEngine::fast_forward_until_changed (const UString &a_expression,
+                                       unsigned a_max_nb_steps,
+                                       const UString &a_cookie)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (a_expression.empty ())
+        return;
+
+    if (m_priv->fast_forwarding) {
+        LOG_ERROR ("a fast-forward stepping is in progress already");
+        return;
+    }
+
+    m_priv->fast_forward_until_changed (a_expression, a_max_nb_steps,
+                                        a_cookie);
+}
+
+/// Record a checkpoint GDB just set, so that the process GDB forked
+/// for it can be recognized later.
+///
+/// \param a_checkpoint_id the id of the checkpoint.
+///
+/// \param a_pid the id of the process GDB forked for the
+/// checkpoint.
+void
+GDBEngine::record_checkpoint (int a_checkpoint_id, int a_pid)
+{
+    m_priv->record_checkpoint (a_checkpoint_id, a_pid);
+}
+
+/// Handle the exit of the process being debugged while GDB kept the
+/// forks of some checkpoints: GDB then switches to one of them by
+/// itself.  Like after restart_from_checkpoint, a stop at the frame
+/// of that checkpoint is notified, and a new checkpoint is set in
+/// place of the one used up.
+///
+/// \param a_pid the id of the process GDB switched to.
+///
+/// \param a_cookie the cookie passed to IDebugger::stopped_signal.
+void
+GDBEngine::exited_to_checkpoint (int a_pid, const UString &a_cookie)
+{
+    m_priv->on_exited_to_checkpoint (a_pid, a_cookie);
+}
+
+/// Let the fast-forward stepping in progress, if any, handle a stop
+/// of the inferior.
+///
+/// \return true if the stop is one of the intermediate steps of the
+/// stepping, in which case it must not be notified.
+bool
+GDBEngine::fast_forward_stopped (IDebugger::StopReason a_reason,
+                                 bool a_has_frame,
+                                 const IDebugger::Frame &a_frame,
+                                 int a_thread_id)
+{
+    return m_priv->on_fast_forward_stopped (a_reason, a_has_frame,
+                                            a_frame, a_thread_id);
+}
+
 void
 GDBEngine::step_over_asm (const UString &a_cookie)
 {
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     Command command ("step-over-asm",
-                     "-exec-next-instruction",
+                     "-exec-next-instruction" + m_priv->exec_thread_option (),
                      a_cookie);
     queue_command (command);
 }
@@ -4688,7 +6466,7 @@ GDBEngine::step_in_asm (const UString &a_cookie)
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     Command command ("step-in-asm",
-                     "-exec-step-instruction",
+                     "-exec-step-instruction" + m_priv->exec_thread_option (),
                      a_cookie);
     queue_command (command);
 }
@@ -4701,8 +6479,9 @@ GDBEngine::continue_to_position (const UString &a_path,
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     queue_command (Command ("continue-to-position",
-                            "-exec-until "
-                            + a_path
+                            "-exec-until"
+                            + m_priv->exec_thread_option ()
+                            + " " + a_path
                             + ":"
                             + UString::from_int (a_line_num),
                             a_cookie));
@@ -4727,7 +6506,8 @@ GDBEngine::jump_to_position (const Loc &a_loc,
     location_to_string (a_loc, location);
 
     Command command ("jump-to-position",
-                     "-exec-jump " + location);
+                     "-exec-jump" + m_priv->exec_thread_option ()
+                     + " " + location);
     command.set_slot (a_slot);
     queue_command (command);
 }
@@ -4869,10 +6649,11 @@ GDBEngine::enable_breakpoint (const string &a_break_num,
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
     Command command ("enable-breakpoint",
-                     "-break-enable " + a_break_num);
+                     "-break-enable " + a_break_num,
+                     a_cookie);
+    command.tag0 (a_break_num);
     command.set_slot (a_slot);
     queue_command (command);
-    list_breakpoints (a_cookie);
 }
 
 /// Enable a given breakpoint
@@ -4897,10 +6678,11 @@ GDBEngine::disable_breakpoint (const string &a_break_num,
 {
     LOG_FUNCTION_SCOPE_NORMAL_DD;
 
-    queue_command (Command ("disable-breakpoint",
-                            "-break-disable " + a_break_num,
-                            a_cookie));
-    list_breakpoints (a_cookie);
+    Command command ("disable-breakpoint",
+                     "-break-disable " + a_break_num,
+                     a_cookie);
+    command.tag0 (a_break_num);
+    queue_command (command);
 }
 
 void
@@ -4916,8 +6698,9 @@ GDBEngine::set_breakpoint_ignore_count (const string &a_break_num,
                      "-break-after " + a_break_num
                      + " " + UString::from_int (a_ignore_count),
                      a_cookie);
+    command.tag0 (a_break_num);
+    command.tag2 (a_ignore_count);
     queue_command (command);
-    list_breakpoints (a_cookie);
 
     typedef map<string, IDebugger::Breakpoint> BPMap;
     BPMap &bp_cache =
@@ -4940,8 +6723,9 @@ GDBEngine::set_breakpoint_condition (const string &a_break_num,
     Command command ("set-breakpoint-condition",
                      "-break-condition " + a_break_num
                      + " " + a_condition, a_cookie);
+    command.tag0 (a_break_num);
+    command.tag1 (a_condition);
     queue_command (command);
-    list_breakpoints (a_cookie);
 }
 
 void
@@ -4973,6 +6757,28 @@ GDBEngine::enable_countpoint (const string &a_break_num,
     queue_command (command);
 }
 
+void
+GDBEngine::set_dprintf (const UString &a_path,
+                        gint a_line_num,
+                        const UString &a_format,
+                        const vector<UString> &a_args,
+                        const UString &a_cookie)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    THROW_IF_FAIL (!a_path.empty () && !a_format.empty ());
+
+    UString command_str = "-dprintf-insert -f "
+        + quote_mi_string (a_path + ":" + UString::from_int (a_line_num))
+        + " " + quote_mi_format (a_format);
+    for (vector<UString>::const_iterator it = a_args.begin ();
+         it != a_args.end ();
+         ++it)
+        command_str += " " + quote_mi_string (*it);
+
+    queue_command (Command ("set-dprintf", command_str, a_cookie));
+}
+
 bool
 GDBEngine::is_countpoint (const string &a_bp_num) const
 {
@@ -5023,7 +6829,6 @@ GDBEngine::set_watchpoint (const UString &a_expression,
 
     Command command ("set-watchpoint", cmd_str, a_cookie);
     queue_command (command);
-    list_breakpoints (a_cookie);
 }
 
 /// Set a breakpoint to a function name.
@@ -5167,6 +6972,13 @@ GDBEngine::append_breakpoint_to_cache (IDebugger::Breakpoint &a_break)
         if (cur->second.type () == IDebugger::Breakpoint::COUNTPOINT_TYPE)
             preserve_count_point = true;
 
+        // GDB doesn't know about the last hit of a countpoint or a
+        // dprintf either; keep it unless a_break carries a new one.
+        if (a_break.last_hit_time () == 0) {
+            a_break.last_hit_time (cur->second.last_hit_time ());
+            a_break.last_output (cur->second.last_output ());
+        }
+
         // Let's preserve the initial ignore count property.
         if (cur->second.initial_ignore_count ()
             != a_break.initial_ignore_count ()) {
@@ -5237,9 +7049,8 @@ GDBEngine::set_catch (const UString &a_event,
     queue_command (Command ("catch",
                             "catch " + a_event,
                             a_cookie));
-    // explicitly request the breakpoints to be listed otherwise the newly added
-    // catchpoint won't show up in the breakpoint list
-    list_breakpoints (a_cookie);
+    // The new catchpoint is reported by the =breakpoint-created
+    // notification that comes with the reply of the command.
 }
 
 
@@ -5273,6 +7084,104 @@ GDBEngine::get_current_thread () const
     return m_priv->cur_thread_num;
 }
 
+/// \return true if GDB runs in non-stop mode.  That is decided when
+/// GDB is launched, from the gdb-non-stop-mode configuration key.
+bool
+GDBEngine::is_non_stop_mode () const
+{
+    return m_priv->non_stop_mode;
+}
+
+bool
+GDBEngine::is_thread_running (int a_thread_id) const
+{
+    map<int, bool>::const_iterator it =
+        m_priv->threads_running.find (a_thread_id);
+    if (it == m_priv->threads_running.end ())
+        return m_priv->threads_running_by_default;
+    return it->second;
+}
+
+/// Record that a thread of the inferior started or stopped running,
+/// and emit thread_state_changed_signal.
+///
+/// \param a_thread_id the id of the thread, or -1 for all the
+/// threads.
+///
+/// \param a_is_running whether the thread is running.
+void
+GDBEngine::set_thread_running (int a_thread_id, bool a_is_running)
+{
+    if (a_thread_id <= 0) {
+        a_thread_id = -1;
+        m_priv->threads_running.clear ();
+        m_priv->threads_running_by_default = a_is_running;
+    } else {
+        m_priv->threads_running[a_thread_id] = a_is_running;
+    }
+    m_priv->thread_state_changed_signal.emit (a_thread_id, a_is_running);
+}
+
+
+/// Have the hit of a countpoint or of a dprintf breakpoint notified
+/// by breakpoints_set_signal, along with the other hits that happen
+/// shortly.
+///
+/// \param a_breakpoint the breakpoint that was hit, as updated in
+/// the cache.
+void
+GDBEngine::record_traced_breakpoint_hit (const Breakpoint &a_breakpoint)
+{
+    m_priv->record_traced_breakpoint_hit (a_breakpoint);
+}
+
+/// Update the table of the shared libraries loaded by the inferior
+/// from a library event reported by GDB.  The events of a same
+/// burst are notified at once by libraries_changed_signal.
+///
+/// \param a_record the out of band record of the library event.
+void
+GDBEngine::record_library_event (const Output::OutOfBandRecord &a_record)
+{
+    m_priv->record_library_event (a_record);
+}
+
+/// \return true if library events have been reported recently, and
+/// not notified yet.
+bool
+GDBEngine::is_in_library_events_burst () const
+{
+    return m_priv->library_events_connection.connected ();
+}
+
+/// Have a breakpoint GDB resolved again during a burst of library
+/// events notified by breakpoints_set_signal at the end of the
+/// burst, along with the other breakpoints resolved meanwhile.
+///
+/// \param a_breakpoint the breakpoint, as updated in the cache.
+void
+GDBEngine::record_breakpoint_resolved_in_burst (const Breakpoint &a_breakpoint)
+{
+    m_priv->record_breakpoint_resolved_in_burst (a_breakpoint);
+}
+
+const map<UString, IDebugger::Library>&
+GDBEngine::get_libraries () const
+{
+    return m_priv->libraries;
+}
+
+bool
+GDBEngine::find_library_at_address (const Address &a_address,
+                                    Library &a_library) const
+{
+    const Library *library =
+        m_priv->find_library_at_address ((size_t) a_address);
+    if (!library)
+        return false;
+    a_library = *library;
+    return true;
+}
 
 void
 GDBEngine::choose_function_overload (int a_overload_number,
@@ -5743,6 +7652,14 @@ void
 GDBEngine::list_files (const UString &a_cookie)
 {
     LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    // Listing the source files of a big program is slow, and they
+    // only change when libraries are loaded or unloaded.  While
+    // libraries are being loaded, the cache is stale already.
+    if (m_priv->source_files_cached && !is_in_library_events_burst ()) {
+        m_priv->files_listed_signal.emit (m_priv->source_files, a_cookie);
+        return;
+    }
     queue_command (Command ("list-files",
                             "-file-list-exec-source-files",
                             a_cookie));
@@ -5926,7 +7843,10 @@ fetch_variable:
     //now we must must parse the line to extract its
     //type and name parts.
     LOG_DD ("going to parse variable decl: '" << str.raw () << "'");
-    parser.reset (new Parser (str.raw ()));
+    // Programs can have a great many globals, so do not copy each
+    // declaration into the parser.  str is not touched until the
+    // parser is done with it.
+    parser.reset (new Parser (str.raw ().data (), str.raw ().size ()));
     simple_decl.reset ();
     if (!parser->parse_simple_declaration (simple_decl)
         || !simple_decl) {
@@ -6081,19 +8001,31 @@ GDBEngine::set_memory (size_t a_addr,
                        const UString& a_cookie)
 {
     LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (a_bytes.empty ())
+        return;
+
+    // Write the whole range at once.  The contents are given to
+    // -data-write-memory-bytes as a string of hexadecimal digits,
+    // two per byte.
+    static const char hex_digits[] = "0123456789abcdef";
+    std::string contents;
+    contents.reserve (a_bytes.size () * 2);
     for (std::vector<uint8_t>::const_iterator iter = a_bytes.begin ();
-            iter != a_bytes.end (); ++iter)
-    {
-        UString cmd_str;
-        cmd_str.printf ("-data-evaluate-expression "
-                        "\"*(unsigned char*)%zu = 0x%X\"",
-                a_addr++,
-                *iter);
-        Command command ("set-memory", cmd_str, a_cookie);
-        command.tag0 ("set-memory");
-        command.tag1 (UString ().printf ("0x%X",a_addr));
-        queue_command (command);
+         iter != a_bytes.end ();
+         ++iter) {
+        contents += hex_digits[*iter >> 4];
+        contents += hex_digits[*iter & 0xf];
     }
+
+    UString cmd_str;
+    cmd_str.printf ("-data-write-memory-bytes 0x%zx ", a_addr);
+    cmd_str += contents;
+    Command command ("set-memory", cmd_str, a_cookie);
+    command.tag0 ("set-memory");
+    command.tag1 (UString ().printf ("0x%zx", a_addr));
+    command.tag3 (contents);
+    queue_command (command);
 }
 
 void
@@ -6279,6 +8211,10 @@ GDBEngine::create_variable (const UString &a_name,
                      + a_name,
                      a_cookie);
     command.tag0 (a_name);
+    command.tag1 (m_priv->stop_history.function_name
+                            (get_current_thread (),
+                             get_current_frame_level ()));
+    command.tag2 (get_current_thread ());
     command.set_slot (a_slot);
     command.should_emit_signal (a_should_emit_signal);
     queue_command (command);
@@ -6333,6 +8269,7 @@ GDBEngine::delete_variable (const VariableSafePtr a_var,
     THROW_IF_FAIL (a_var);
     THROW_IF_FAIL (!a_var->internal_name ().empty ());
 
+    m_priv->variable_scopes.erase (a_var->internal_name ());
     Command command ("delete-variable",
                      "-var-delete " + a_var->internal_name (),
                      a_cookie);
@@ -6363,6 +8300,7 @@ GDBEngine::delete_variable (const UString &a_internal_name,
 
     THROW_IF_FAIL (!a_internal_name.empty ());
 
+    m_priv->variable_scopes.erase (a_internal_name);
     Command command ("delete-variable",
                      "-var-delete " + a_internal_name,
                      a_cookie);
@@ -6370,6 +8308,35 @@ GDBEngine::delete_variable (const UString &a_internal_name,
     queue_command (command);
 }
 
+/// Record that a variable object is not used anymore.  The variable
+/// objects recorded that way are deleted one at a time, only when
+/// GDB has nothing else to do, so that they never delay the commands
+/// issued by the user.  Deleting a variable object deletes its
+/// children, so these are not deleted separately.
+///
+/// \param a_internal_name the name of the variable object.
+void
+GDBEngine::release_variable (const UString &a_internal_name)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    THROW_IF_FAIL (!a_internal_name.empty ());
+
+    m_priv->release_varobj (a_internal_name);
+}
+
+/// Cancel the pending deletion of a variable object recorded by
+/// release_variable, and of its descendants, because the variable
+/// object is used again.
+///
+/// \param a_internal_name the name of the variable object.
+void
+GDBEngine::reclaim_variable (const UString &a_internal_name)
+{
+    if (!a_internal_name.empty ())
+        m_priv->reclaim_varobj (a_internal_name);
+}
+
 /// Unfold a given variable.
 ///
 /// Query the backend for the member variables of the given variable.
@@ -6464,6 +8431,11 @@ GDBEngine::unfold_variable (VariableSafePtr a_var,
     }
     THROW_IF_FAIL (!a_var->internal_name ().empty ());
 
+    // The children GDB is about to list might have been released
+    // with the previous members of a_var, if these were dropped.
+    // They must outlive this unfolding.
+    m_priv->reclaim_varobj (a_var->internal_name ());
+
     Command command ("unfold-variable",
                      "-var-list-children "
                      " --all-values "
@@ -6678,6 +8650,126 @@ GDBEngine::enable_pretty_printing (bool a_flag)
                                    a_flag);
 }
 
+/// \return the timings and counters of the hot paths of the engine.
+const IDebugger::PerfStats&
+GDBEngine::get_perf_stats () const
+{
+    return m_priv->perf_stats;
+}
+
+/// \return the record of the recent stops of the inferior.
+const StopHistory&
+GDBEngine::get_stop_history () const
+{
+    return m_priv->stop_history;
+}
+
+/// Record the value of a variable into the stop history, and
+/// remember the scope of the variable, for its later values.
+///
+/// \param a_var the variable, which was just created.
+///
+/// \param a_scope the thread and function the variable lives in.
+void
+GDBEngine::record_variable_value (const VariableSafePtr &a_var,
+                                  const StopHistory::VariableScope &a_scope)
+{
+    THROW_IF_FAIL (a_var);
+    if (!a_var->internal_name ().empty ())
+        m_priv->variable_scopes[a_var->internal_name ()] = a_scope;
+    m_priv->record_variable_value (a_var, a_scope);
+}
+
+/// Forget about all the timings and counters recorded so far.
+void
+GDBEngine::reset_perf_stats ()
+{
+    m_priv->perf_stats.clear ();
+}
+
+/// \return a copy of a_str suitable for being embedded into a JSON
+/// string literal.
+static std::string
+escape_json_string (const UString &a_str)
+{
+    std::string result;
+    const std::string &raw = a_str.raw ();
+    for (std::string::const_iterator it = raw.begin ();
+         it != raw.end ();
+         ++it) {
+        switch (*it) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            default:
+                if ((unsigned char) *it < 0x20)
+                    result += ' ';
+                else
+                    result += *it;
+        }
+    }
+    return result;
+}
+
+/// Write the timings of the recently completed commands to a file,
+/// in the Chrome trace event JSON format.
+///
+/// Each command yields three consecutive events named after the
+/// command: the time it spent in the command queue, the time GDB took
+/// to reply and the time the output handlers took to handle the
+/// reply.  Each kind of event lives on its own track.
+///
+/// \param a_path the path of the file to write.
+///
+/// \return true upon successful completion, false otherwise.
+bool
+GDBEngine::dump_perf_trace (const UString &a_path) const
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    std::ofstream out (Glib::filename_from_utf8 (a_path).c_str ());
+    if (!out.good ()) {
+        LOG_ERROR ("could not open " << a_path);
+        return false;
+    }
+
+    static const char *phases[] = {"queued", "in-gdb", "handling"};
+    const list<PerfStats::CommandTiming> &timings =
+        m_priv->perf_stats.command_timings ();
+    bool first = true;
+
+    out << "{\"traceEvents\":[";
+    list<PerfStats::CommandTiming>::const_iterator it;
+    for (it = timings.begin (); it != timings.end (); ++it) {
+        gint64 bounds[] = {it->queued_time (), it->issued_time (),
+                           it->reply_time (), it->handled_time ()};
+        for (int i = 0; i < 3; ++i) {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "{\"name\":\""
+                << escape_json_string (it->name ()) << "\","
+                << "\"cat\":\"" << phases[i] << "\","
+                << "\"ph\":\"X\","
+                << "\"ts\":" << bounds[i] << ","
+                << "\"dur\":" << bounds[i + 1] - bounds[i] << ","
+                << "\"pid\":1,"
+                << "\"tid\":" << i + 1 << "}";
+        }
+    }
+    out << "]}\n";
+    return out.good ();
+}
+
 /// Instruct GDB to set the variable vizualizer used by the GDB Pretty
 /// Printing system to print the value of a given variable.
 /// 
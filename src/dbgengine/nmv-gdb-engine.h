@@ -30,6 +30,7 @@
 #include "nmv-dbg-common.h"
 #include "nmv-gdbmi-parser.h"
 #include "nmv-i-lang-trait.h"
+#include "nmv-stop-history.h"
 
 NEMIVER_BEGIN_NAMESPACE (nemiver)
 
@@ -73,6 +74,10 @@ public:
 
     sigc::signal<void>& inferior_re_run_signal () const;
 
+    sigc::signal<void, int, const UString&>& checkpoint_set_signal () const;
+
+    sigc::signal<void>& libraries_changed_signal () const;
+
     sigc::signal<void, const map<string, IDebugger::Breakpoint>&, const UString&>&
                                             breakpoints_list_signal () const;
 
@@ -114,6 +119,8 @@ public:
                  const Frame* const,
                  const UString&>& thread_selected_signal () const ;
 
+    sigc::signal<void, int, bool>& thread_state_changed_signal () const;
+
     sigc::signal<void,
                  const vector<IDebugger::Frame>&,
                  const UString&>& frames_listed_signal () const;
@@ -167,6 +174,9 @@ public:
 
     sigc::signal<void, const UString&>& error_signal () const;
 
+    sigc::signal<void, const UString&, const UString&, const UString&>&
+                                        command_error_signal () const;
+
     sigc::signal<void>& program_finished_signal () const;
 
     sigc::signal<void, IDebugger::State>& state_changed_signal () const;
@@ -210,6 +220,9 @@ public:
     sigc::signal<void, VariableSafePtr, const UString&>&
                 assigned_variable_signal () const;
 
+    sigc::signal<void, int, int>&
+                variables_revisualization_progress_signal () const;
+
     //*************
     //</signals>
     //*************
@@ -238,12 +251,11 @@ public:
     void on_rv_set_visualizer_on_members (const VariableSafePtr,
 					  const UString&,
 					  const ConstVariableSlot&);
-    void on_rv_set_visualizer_on_next_sibling
-      (const VariableSafePtr,
-       const UString&,
-       IDebugger::VariableList::iterator,
-       IDebugger::VariableList::iterator,
-       const ConstVariableSlot&);
+    void on_rv_member_visualizer_set (const VariableSafePtr,
+				      const VariableSafePtr,
+				      bool,
+				      const UString&,
+				      const ConstVariableSlot&);
 
     void on_rv_flag (const VariableSafePtr,
 		     const UString&,
@@ -299,6 +311,9 @@ public:
 		       bool a_uses_launch_tty,
 		       bool a_force);
 
+    void prewarm_program (const UString &a_prog,
+                          const UString &a_working_dir);
+
     void load_core_file (const UString &a_prog_file,
                          const UString &a_core_path);
 
@@ -339,6 +354,11 @@ public:
 
     void re_run (const DefaultSlot &);
 
+    void set_checkpoint (const UString &a_cookie);
+
+    void restart_from_checkpoint (int a_checkpoint_id,
+                                  const UString &a_cookie);
+
     void get_target_info (const UString &a_cookie);
 
     ILangTraitSafePtr create_language_trait ();
@@ -371,6 +391,22 @@ public:
 
     void step_out (const UString &a_cookie);
 
+    void fast_forward_step_over (unsigned a_nb_steps,
+                                 const UString &a_cookie);
+
+    void fast_forward_until_changed (const UString &a_expression,
+                                     unsigned a_max_nb_steps,
+                                     const UString &a_cookie);
+
+    bool fast_forward_stopped (IDebugger::StopReason a_reason,
+                               bool a_has_frame,
+                               const IDebugger::Frame &a_frame,
+                               int a_thread_id);
+
+    void record_checkpoint (int a_checkpoint_id, int a_pid);
+
+    void exited_to_checkpoint (int a_pid, const UString &a_cookie);
+
     void step_over_asm (const UString &a_cookie);
 
     void step_in_asm (const UString &a_cookie);
@@ -436,6 +472,12 @@ public:
 
     bool is_countpoint (const Breakpoint &a_breakpoint) const;
 
+    void set_dprintf (const UString &a_path,
+                      gint a_line_num,
+                      const UString &a_format,
+                      const vector<UString> &a_args,
+                      const UString &a_cookie = "");
+
     void delete_breakpoint (const UString &a_path,
                             gint a_line_num,
                             const UString &a_cookie);
@@ -468,6 +510,25 @@ public:
 
     unsigned int get_current_thread () const;
 
+    bool is_non_stop_mode () const;
+
+    bool is_thread_running (int a_thread_id) const;
+
+    void set_thread_running (int a_thread_id, bool a_is_running);
+
+    void record_traced_breakpoint_hit (const Breakpoint &a_breakpoint);
+
+    void record_library_event (const Output::OutOfBandRecord &a_record);
+
+    bool is_in_library_events_burst () const;
+
+    void record_breakpoint_resolved_in_burst (const Breakpoint &a_breakpoint);
+
+    const map<UString, Library>& get_libraries () const;
+
+    bool find_library_at_address (const Address &a_address,
+                                  Library &a_library) const;
+
     void delete_breakpoint (const string &a_break_num,
                             const UString &a_cookie);
 
@@ -616,6 +677,10 @@ public:
 			  const DefaultSlot &a_slot,
 			  const UString &a_cookie);
 
+    void release_variable (const UString &a_internal_name);
+
+    void reclaim_variable (const UString &a_internal_name);
+
     void unfold_variable (VariableSafePtr a_var,
                           const UString &a_cookie);
 
@@ -673,6 +738,17 @@ public:
     void set_variable_visualizer (const VariableSafePtr a_var,
 				  const std::string &a_vizualizer,
 				  const ConstVariableSlot &a_slot);
+
+    const PerfStats& get_perf_stats () const;
+
+    const StopHistory& get_stop_history () const;
+
+    void record_variable_value (const VariableSafePtr &a_var,
+                                const StopHistory::VariableScope &a_scope);
+
+    void reset_perf_stats ();
+
+    bool dump_perf_trace (const UString &a_path) const;
 };//end class GDBEngine
 
 NEMIVER_END_NAMESPACE (nemiver)
@@ -0,0 +1,287 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#include "config.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <signal.h>
+#include <unistd.h>
+#include <list>
+#include "common/nmv-exception.h"
+#include "common/nmv-proc-utils.h"
+#include "nmv-gdb-process-pool.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+
+/// The default number of processes the pool holds.  Each of them
+/// holds the symbols of a whole program, so keep that low.
+static const unsigned DEFAULT_CAPACITY = 2;
+
+/// Get the modification time of a file.
+///
+/// \param a_path the path to the file.
+///
+/// \param a_mtime the resulting modification time.  Set only if the
+/// function returned true.
+///
+/// \return true upon successful completion, false otherwise.
+static bool
+get_mtime (const UString &a_path, time_t &a_mtime)
+{
+    struct stat st;
+    if (a_path.empty ()
+        || stat (Glib::filename_from_utf8 (a_path).c_str (), &st))
+        return false;
+    a_mtime = st.st_mtime;
+    return true;
+}
+
+/// Reap a killed pooled process, so that it doesn't linger as a
+/// zombie.
+static void
+on_killed_process_died (Glib::Pid a_pid, int)
+{
+    g_spawn_close_pid (a_pid);
+}
+
+struct GDBProcessPool::Priv {
+    struct Entry {
+        std::vector<UString> argv;
+        time_t mtime;
+        Process process;
+        sigc::connection child_watch_connection;
+
+        Entry () :
+            mtime (0)
+        {
+        }
+    };
+
+    // The oldest entries come first.
+    std::list<Entry> entries;
+    unsigned capacity;
+
+    Priv () :
+        capacity (DEFAULT_CAPACITY)
+    {
+    }
+
+    std::list<Entry>::iterator find (const std::vector<UString> &a_argv)
+    {
+        std::list<Entry>::iterator it;
+        for (it = entries.begin (); it != entries.end (); ++it)
+            if (it->argv == a_argv)
+                break;
+        return it;
+    }
+
+    void close_fds (Process &a_process)
+    {
+        if (a_process.master_pty_fd >= 0)
+            close (a_process.master_pty_fd);
+        if (a_process.stdout_fd >= 0)
+            close (a_process.stdout_fd);
+        if (a_process.stderr_fd >= 0)
+            close (a_process.stderr_fd);
+    }
+
+    /// Kill the process of an entry and forget about the entry.  The
+    /// process is reaped once it is gone.
+    void kill_entry (std::list<Entry>::iterator a_it)
+    {
+        LOG_DD ("killing pooled gdb of pid " << a_it->process.pid);
+        a_it->child_watch_connection.disconnect ();
+        Glib::signal_child_watch ().connect
+            (sigc::ptr_fun (&on_killed_process_died), a_it->process.pid);
+        kill (a_it->process.pid, SIGKILL);
+        close_fds (a_it->process);
+        entries.erase (a_it);
+    }
+
+    void on_pooled_process_died (Glib::Pid a_pid, int)
+    {
+        NEMIVER_TRY
+
+        std::list<Entry>::iterator it;
+        for (it = entries.begin (); it != entries.end (); ++it) {
+            if (it->process.pid == a_pid) {
+                LOG_DD ("pooled gdb of pid " << a_pid << " died");
+                close_fds (it->process);
+                entries.erase (it);
+                break;
+            }
+        }
+        g_spawn_close_pid (a_pid);
+
+        NEMIVER_CATCH_NOX
+    }
+};//end struct GDBProcessPool::Priv
+
+GDBProcessPool::GDBProcessPool () :
+    m_priv (new Priv)
+{
+}
+
+GDBProcessPool::~GDBProcessPool ()
+{
+    clear ();
+}
+
+/// \return the pool shared by all the instances of the debugging
+/// engine.
+GDBProcessPool&
+GDBProcessPool::get ()
+{
+    static GDBProcessPool s_pool;
+    return s_pool;
+}
+
+/// \return the maximum number of processes the pool holds.
+unsigned
+GDBProcessPool::capacity () const
+{
+    return m_priv->capacity;
+}
+
+/// Set the maximum number of processes the pool holds.  The oldest
+/// processes are killed if there are too many of them already.
+void
+GDBProcessPool::capacity (unsigned a_capacity)
+{
+    m_priv->capacity = a_capacity;
+    while (m_priv->entries.size () > m_priv->capacity)
+        m_priv->kill_entry (m_priv->entries.begin ());
+}
+
+/// \return the number of processes in the pool.
+unsigned
+GDBProcessPool::size () const
+{
+    return m_priv->entries.size ();
+}
+
+/// Spawn a GDB process in the background and keep it in the pool.
+/// GDB reads the symbols of the program while it waits there.
+///
+/// If the pool already holds a process for the same command line
+/// and the same version of the program, nothing is done.
+///
+/// \param a_argv the command line of the GDB process, exactly as
+/// it would be passed to common::launch_program.
+///
+/// \param a_prog_path the path to the program GDB is to load.
+///
+/// \return true if the pool holds a suitable process upon
+/// completion, false otherwise.
+bool
+GDBProcessPool::prewarm (const std::vector<UString> &a_argv,
+                         const UString &a_prog_path)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (!m_priv->capacity || a_argv.empty ())
+        return false;
+
+    time_t mtime = 0;
+    if (!get_mtime (a_prog_path, mtime))
+        return false;
+
+    std::list<Priv::Entry>::iterator it = m_priv->find (a_argv);
+    if (it != m_priv->entries.end ()) {
+        if (it->mtime == mtime)
+            return true;
+        m_priv->kill_entry (it);
+    }
+
+    while (m_priv->entries.size () >= m_priv->capacity)
+        m_priv->kill_entry (m_priv->entries.begin ());
+
+    Priv::Entry entry;
+    entry.argv = a_argv;
+    entry.mtime = mtime;
+    int pid = 0;
+    if (!common::launch_program (a_argv, pid,
+                                 entry.process.master_pty_fd,
+                                 entry.process.stdout_fd,
+                                 entry.process.stderr_fd)
+        || !pid) {
+        LOG_ERROR ("could not pre-spawn gdb for " << a_prog_path);
+        return false;
+    }
+    entry.process.pid = pid;
+    entry.child_watch_connection = Glib::signal_child_watch ().connect
+        (sigc::mem_fun (*m_priv, &Priv::on_pooled_process_died), pid);
+    m_priv->entries.push_back (entry);
+    LOG_DD ("pre-spawned gdb of pid " << pid << " for " << a_prog_path);
+    return true;
+}
+
+/// Take a GDB process out of the pool.
+///
+/// \param a_argv the command line the process must have been
+/// spawned with.
+///
+/// \param a_prog_path the path to the program GDB loaded.  If the
+/// program changed on disk since the process was spawned, the
+/// process is killed and the function returns false.
+///
+/// \param a_process the resulting process.  Set only if the
+/// function returned true.  The caller then owns it.
+///
+/// \return true if a suitable process was found, false otherwise.
+bool
+GDBProcessPool::take (const std::vector<UString> &a_argv,
+                      const UString &a_prog_path,
+                      Process &a_process)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    std::list<Priv::Entry>::iterator it = m_priv->find (a_argv);
+    if (it == m_priv->entries.end ())
+        return false;
+
+    time_t mtime = 0;
+    if (!get_mtime (a_prog_path, mtime) || mtime != it->mtime) {
+        LOG_DD ("program " << a_prog_path << " changed since gdb "
+                << it->process.pid << " was spawned");
+        m_priv->kill_entry (it);
+        return false;
+    }
+
+    it->child_watch_connection.disconnect ();
+    a_process = it->process;
+    m_priv->entries.erase (it);
+    LOG_DD ("took pooled gdb of pid " << a_process.pid);
+    return true;
+}
+
+/// Kill all the processes of the pool.
+void
+GDBProcessPool::clear ()
+{
+    while (!m_priv->entries.empty ())
+        m_priv->kill_entry (m_priv->entries.begin ());
+}
+
+NEMIVER_END_NAMESPACE (nemiver)
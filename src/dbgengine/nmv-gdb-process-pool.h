@@ -0,0 +1,100 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#ifndef __NMV_GDB_PROCESS_POOL_H__
+#define __NMV_GDB_PROCESS_POOL_H__
+
+#include <vector>
+#include <glibmm.h>
+#include "common/nmv-ustring.h"
+#include "common/nmv-safe-ptr-utils.h"
+
+using nemiver::common::UString;
+using nemiver::common::SafePtr;
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+
+/// A pool of GDB processes that were spawned ahead of time on a
+/// given program, so that GDB has already read the symbols of the
+/// program by the time a debugging session is started on it.
+///
+/// An instance is keyed by the command line it was spawned with
+/// (which contains the path to the program and the working
+/// directory) and by the modification time of the program.  An
+/// instance whose program changed on disk since it was spawned is
+/// never handed out; it is killed instead.
+///
+/// Pooled processes that die are reaped and forgotten.  The ones
+/// still in the pool when Nemiver exits are killed.
+class GDBProcessPool {
+    GDBProcessPool (const GDBProcessPool&);
+    GDBProcessPool& operator= (const GDBProcessPool&);
+
+    struct Priv;
+    SafePtr<Priv> m_priv;
+
+    GDBProcessPool ();
+
+public:
+
+    /// The pieces of a GDB process, as returned by
+    /// common::launch_program.
+    struct Process {
+        Glib::Pid pid;
+        int master_pty_fd;
+        int stdout_fd;
+        int stderr_fd;
+
+        Process () :
+            pid (0),
+            master_pty_fd (-1),
+            stdout_fd (-1),
+            stderr_fd (-1)
+        {
+        }
+    };
+
+    ~GDBProcessPool ();
+
+    static GDBProcessPool& get ();
+
+    unsigned capacity () const;
+
+    void capacity (unsigned a_capacity);
+
+    unsigned size () const;
+
+    bool prewarm (const std::vector<UString> &a_argv,
+                  const UString &a_prog_path);
+
+    bool take (const std::vector<UString> &a_argv,
+               const UString &a_prog_path,
+               Process &a_process);
+
+    void clear ();
+};//end class GDBProcessPool
+
+NEMIVER_END_NAMESPACE (nemiver)
+
+#endif //__NMV_GDB_PROCESS_POOL_H__
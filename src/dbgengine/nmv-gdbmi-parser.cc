@@ -24,6 +24,7 @@
  *See COPYRIGHT file copyright information.
  */
 #include "config.h"
+#include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -134,6 +135,10 @@ static const char* PREFIX_ERROR = "^error";
 static const char* PREFIX_BKPT = "bkpt={";
 static const char* PREFIX_BREAKPOINT_TABLE = "BreakpointTable={";
 static const char* PREFIX_BREAKPOINT_MODIFIED_ASYNC_OUTPUT = "=breakpoint-modified,";
+static const char* PREFIX_BREAKPOINT_CREATED_ASYNC_OUTPUT = "=breakpoint-created,";
+static const char* PREFIX_BREAKPOINT_DELETED_ASYNC_OUTPUT = "=breakpoint-deleted,";
+static const char* PREFIX_LIBRARY_LOADED_ASYNC_OUTPUT = "=library-loaded,";
+static const char* PREFIX_LIBRARY_UNLOADED_ASYNC_OUTPUT = "=library-unloaded,";
 static const char* PREFIX_THREAD_IDS = "thread-ids={";
 static const char* PREFIX_NEW_THREAD_ID = "new-thread-id=\"";
 static const char* PREFIX_FILES = "files=[";
@@ -174,6 +179,49 @@ is_string_start (gunichar a_c)
     return true;
 }
 
+/// \return true if a_result is the "wpt", "hw-rwpt" or "hw-awpt"
+/// tuple that -break-watch replies with.
+static bool
+is_watchpoint_result (const GDBMIResultSafePtr &a_result)
+{
+    if (!a_result || !a_result->value ()
+        || a_result->value ()->content_type () != GDBMIValue::TUPLE_TYPE)
+        return false;
+    const UString &name = a_result->variable ();
+    return (name == "wpt" || name == "hw-rwpt" || name == "hw-awpt");
+}
+
+/// Look for a member of string type in the tuple value of a_result.
+///
+/// \param a_result the result which value must be a tuple.
+///
+/// \param a_name the name of the member to look for.
+///
+/// \param a_value out parameter.  Set to the value of the member iff
+/// the function returns true.
+///
+/// \return true if the member was found.
+static bool
+get_tuple_string_member (const GDBMIResultSafePtr &a_result,
+                         const UString &a_name,
+                         UString &a_value)
+{
+    GDBMITupleSafePtr tuple = a_result->value ()->get_tuple_content ();
+    if (!tuple)
+        return false;
+    list<GDBMIResultSafePtr>::const_iterator it;
+    for (it = tuple->content ().begin (); it != tuple->content ().end (); ++it) {
+        if (*it
+            && (*it)->variable () == a_name
+            && (*it)->value ()
+            && (*it)->value ()->content_type () == GDBMIValue::STRING_TYPE) {
+            a_value = (*it)->value ()->get_string_content ();
+            return true;
+        }
+    }
+    return false;
+}
+
 /// remove the trailing chars "\\n" at the end of a string
 /// these chars are found at the end gdb stream records.
 void
@@ -730,6 +778,48 @@ GDBMIParser::parse_octal_escape_sequence (UString::size_type a_from,
     return true;
 }
 
+/// Make a string that is not valid UTF-8 displayable: every byte
+/// that is not part of a valid UTF-8 sequence is replaced by its
+/// octal escape sequence, e.g, "\351".  This is lossless, unlike
+/// replacing the offending bytes with a placeholder character.
+///
+/// \param a_bytes the bytes to consider.
+///
+/// \param a_result the resulting valid UTF-8 string.
+static void
+escape_invalid_utf8 (const std::string &a_bytes,
+                     std::string &a_result)
+{
+    const gchar *cur = a_bytes.data (), *end = cur + a_bytes.size ();
+    const gchar *invalid = 0;
+    while (!g_utf8_validate (cur, end - cur, &invalid)) {
+        a_result.append (cur, invalid);
+        char seq[5];
+        snprintf (seq, sizeof (seq), "\\%03o",
+                  (unsigned) (unsigned char) *invalid);
+        a_result += seq;
+        cur = invalid + 1;
+    }
+    a_result.append (cur, end);
+}
+
+/// Parse the body of a c-string, i.e, what comes after its opening
+/// double quote, up to (and not including) its closing double quote.
+///
+/// The runs of characters that need no unescaping are copied in
+/// bulk.  Octal escape sequences are decoded into the bytes they
+/// stand for, and an escaped double quote is turned into a double
+/// quote.  The other escape sequences are kept as is.  The resulting
+/// bytes are validated as UTF-8 once, at the end.
+///
+/// \param a_from the index of the first character of the body.
+///
+/// \param a_to output parameter.  Set to the index of the closing
+/// double quote, if the function returns true.
+///
+/// \param a_string output parameter.  The unescaped body.
+///
+/// \return true upon successful parsing, false otherwise.
 bool
 GDBMIParser::parse_c_string_body (UString::size_type a_from,
                                   UString::size_type &a_to,
@@ -738,81 +828,52 @@ GDBMIParser::parse_c_string_body (UString::size_type a_from,
     UString::size_type cur=a_from;
     CHECK_END (cur);
 
-    UString::value_type ch = RAW_CHAR_AT (cur), prev_ch;
-    if (ch == '"') {
-        a_string = "";
-        a_to = cur;
-        return true;
-    }
+    const std::string &input = RAW_INPUT;
+    std::string result;
 
-    if (!isascii (ch) && ch != '\\') {
-        LOG_PARSING_ERROR (cur);
-        return false;
-    }
+    for (;;) {
+        UString::size_type special = input.find_first_of ("\\\"", cur);
+        if (special == std::string::npos
+            || m_priv->index_passed_end (special)) {
+            LOG_PARSING_ERROR (cur);
+            return false;
+        }
+        result.append (input, cur, special - cur);
+        cur = special;
+        if (input[cur] == '"')
+            break;
 
-    std::string result;
-    if (ch != '\\') {
-        result += ch;
-        ++cur;
-    } else {
-        UString seq;
+        // input[cur] is a backslash.
+        PARSING_ERROR_IF_END (cur + 1);
         if (!m_priv->index_passed_end (cur + 3)
-            && isdigit (RAW_CHAR_AT (cur + 1))
-            && isdigit (RAW_CHAR_AT (cur + 2))
-            && isdigit (RAW_CHAR_AT (cur + 3))
-            && parse_octal_escape_sequence (cur, cur, seq)) {
-            result += seq;
+            && input[cur + 1] >= '0' && input[cur + 1] <= '7'
+            && input[cur + 2] >= '0' && input[cur + 2] <= '7'
+            && input[cur + 3] >= '0' && input[cur + 3] <= '7') {
+            result += (char) ((input[cur + 1] - '0') * 64
+                              + (input[cur + 2] - '0') * 8
+                              + (input[cur + 3] - '0'));
+            cur += 4;
+        } else if (input[cur + 1] == '"') {
+            result += '"';
+            cur += 2;
         } else {
-            result += ch;
-            ++cur;
+            result.append (input, cur, 2);
+            cur += 2;
         }
     }
-    CHECK_END (cur);
 
-    for (;;) {
-        prev_ch = ch;
-        ch = RAW_CHAR_AT (cur);
-        if (isascii (ch)) {
-            if (ch == '"' && prev_ch != '\\') {
-                break;
-            } else if (ch == '"' && prev_ch == '\\') {
-                // So '"' was escaped as '\"'.  Let's expand it into
-                // '"'.
-                result.erase (result.end () - 1);
-                result += ch;
-                ++cur;
-            } else if (ch == '\\') {
-                UString seq;
-                if (!m_priv->index_passed_end (cur+3)
-                    && isdigit (RAW_CHAR_AT (cur +1))
-                    && isdigit (RAW_CHAR_AT (cur +2))
-                    && isdigit (RAW_CHAR_AT (cur +3))
-                    && parse_octal_escape_sequence (cur, cur, seq)) {
-                    ch = seq[seq.size ()-1];
-                    result += seq;
-                } else {
-                    result += ch;
-                    ++cur;
-                }
-            } else {
-                result += ch;
-                ++cur;
-            }
-            CHECK_END (cur);
-            continue;
-        } else {
-	  result += ch;
-	  ++cur;
-	  if (m_priv->index_passed_end (cur))
-	    break;
-	}
-    }
-
-    if (ch != '"') {
-        LOG_PARSING_ERROR (cur);
-        return false;
+    if (g_utf8_validate (result.data (), result.size (), 0)) {
+        a_string = result;
+    } else {
+        // That can be e.g, a file name that is not encoded in UTF-8.
+        std::string utf8;
+        try {
+            utf8 = Glib::filename_to_utf8 (result);
+        } catch (...) {
+            escape_invalid_utf8 (result, utf8);
+        }
+        a_string = utf8;
     }
-    a_string = result;
     a_to = cur;
     return true;
 }
@@ -1626,7 +1687,10 @@ GDBMIParser::parse_output_record (UString::size_type a_from,
         return false;
     }
 
-    Output output;
+    // Parse right into a_output rather than into a copy of it, as a
+    // result record can be big.
+    Output &output = a_output;
+    output.clear ();
 	int y = 0;
     while (RAW_CHAR_AT (cur) == '*'
            || RAW_CHAR_AT (cur) == '~'
@@ -1658,10 +1722,8 @@ GDBMIParser::parse_output_record (UString::size_type a_from,
     }
 
     if (RAW_CHAR_AT (cur) == '^') {
-        Output::ResultRecord result_record;
-        if (parse_result_record (cur, cur, result_record)) {
+        if (parse_result_record (cur, cur, output.result_record ())) {
             output.has_result_record (true);
-            output.result_record (result_record);
         }
         if (m_priv->index_passed_end (cur)) {
             LOG_PARSING_ERROR (cur);
@@ -1683,7 +1745,6 @@ GDBMIParser::parse_output_record (UString::size_type a_from,
         return false;
     }
 
-    a_output = output;
     a_to = cur;
     return true;
 }
@@ -1831,6 +1892,56 @@ GDBMIParser::parse_out_of_band_record (UString::size_type a_from,
         goto end;
     }
 
+    if (!RAW_INPUT.compare (cur,
+                            strlen (PREFIX_BREAKPOINT_CREATED_ASYNC_OUTPUT),
+                            PREFIX_BREAKPOINT_CREATED_ASYNC_OUTPUT)) {
+        IDebugger::Breakpoint bp;
+        if (!parse_breakpoint_created_async_output (cur, cur, bp)) {
+            LOG_PARSING_ERROR_MSG (cur,
+                                   "could not parse the expected "
+                                   "breakpoint created async output");
+            return false;
+        }
+        // A new breakpoint is just a modification of the breakpoint
+        // table, as far as the clients of the parser are concerned.
+        record.modified_breakpoint (bp);
+        goto end;
+    }
+
+    if (!RAW_INPUT.compare (cur,
+                            strlen (PREFIX_BREAKPOINT_DELETED_ASYNC_OUTPUT),
+                            PREFIX_BREAKPOINT_DELETED_ASYNC_OUTPUT)) {
+        string id;
+        if (!parse_breakpoint_deleted_async_output (cur, cur, id)) {
+            LOG_PARSING_ERROR_MSG (cur,
+                                   "could not parse the expected "
+                                   "breakpoint deleted async output");
+            return false;
+        }
+        record.deleted_breakpoint_id (id);
+        goto end;
+    }
+
+    if (!RAW_INPUT.compare (cur,
+                            strlen (PREFIX_LIBRARY_LOADED_ASYNC_OUTPUT),
+                            PREFIX_LIBRARY_LOADED_ASYNC_OUTPUT)
+        || !RAW_INPUT.compare (cur,
+                               strlen (PREFIX_LIBRARY_UNLOADED_ASYNC_OUTPUT),
+                               PREFIX_LIBRARY_UNLOADED_ASYNC_OUTPUT)) {
+        IDebugger::Library library;
+        bool loaded = false;
+        if (!parse_library_async_output (cur, cur, library, loaded)) {
+            LOG_PARSING_ERROR_MSG (cur,
+                                   "could not parse the expected "
+                                   "library async output");
+            return false;
+        }
+        record.library_event (true);
+        record.library_loaded (loaded);
+        record.library (library);
+        goto end;
+    }
+
     if (RAW_CHAR_AT (cur) == '=' || RAW_CHAR_AT (cur) == '*') {
        //this is an unknown async notification sent by gdb.
        //For now, the only one
@@ -1870,7 +1981,8 @@ GDBMIParser::parse_result_record (UString::size_type a_from,
     }
 
     UString name, value;
-    Output::ResultRecord result_record;
+    Output::ResultRecord &result_record = a_record;
+    result_record.clear ();
     if (!RAW_INPUT.compare (cur, strlen (PREFIX_DONE), PREFIX_DONE)) {
         cur += 5;
         result_record.kind (Output::ResultRecord::DONE);
@@ -1896,7 +2008,7 @@ fetch_gdbmi_result:
                                                PREFIX_BREAKPOINT_TABLE)) {
                 map<string, IDebugger::Breakpoint> breaks;
                 if (parse_breakpoint_table (cur, cur, breaks)) {
-                    result_record.breakpoints () = breaks;
+                    result_record.breakpoints ().swap (breaks);
                 }
             } else if (!m_priv->input.compare (cur, strlen (PREFIX_THREAD_IDS),
                         PREFIX_THREAD_IDS)) {
@@ -1926,12 +2038,13 @@ fetch_gdbmi_result:
                        GDBMI_PARSING_DOMAIN);
             } else if (!RAW_INPUT.compare (cur, strlen (PREFIX_STACK),
                                            PREFIX_STACK)) {
-                vector<IDebugger::Frame> call_stack;
+                vector<IDebugger::Frame> &call_stack =
+                    result_record.call_stack ();
                 if (!parse_call_stack (cur, cur, call_stack)) {
                     LOG_PARSING_ERROR (cur);
                     return false;
                 }
-                result_record.call_stack (call_stack);
+                result_record.has_call_stack (true);
                 LOG_D ("parsed a call stack of depth: "
                        << (int) call_stack.size (),
                        GDBMI_PARSING_DOMAIN);
@@ -1959,13 +2072,14 @@ fetch_gdbmi_result:
                 LOG_D ("parsed result", GDBMI_PARSING_DOMAIN);
             } else if (!RAW_INPUT.compare (cur, strlen (PREFIX_STACK_ARGS),
                                            PREFIX_STACK_ARGS)) {
-                map<int, list<IDebugger::VariableSafePtr> > frames_args;
+                map<int, list<IDebugger::VariableSafePtr> > &frames_args =
+                    result_record.frames_parameters ();
                 if (!parse_stack_arguments (cur, cur, frames_args)) {
                     LOG_PARSING_ERROR (cur);
                 } else {
                     LOG_D ("parsed stack args", GDBMI_PARSING_DOMAIN);
                 }
-                result_record.frames_parameters (frames_args);
+                result_record.has_frames_parameters (true);
             } else if (!RAW_INPUT.compare (cur, strlen (PREFIX_LOCALS),
                                            PREFIX_LOCALS)) {
                 list<IDebugger::VariableSafePtr> vars;
@@ -2029,7 +2143,7 @@ fetch_gdbmi_result:
                     LOG_PARSING_ERROR (cur);
                 } else {
                     LOG_D ("parsed memory values", GDBMI_PARSING_DOMAIN);
-                    result_record.memory_values (addr, values);
+                    result_record.swap_memory_values (addr, values);
                 }
             } else if (!RAW_INPUT.compare (cur,
                                            strlen (PREFIX_ASM_INSTRUCTIONS),
@@ -2040,7 +2154,7 @@ fetch_gdbmi_result:
                     LOG_PARSING_ERROR (cur);
                 } else {
                     LOG_D ("parsed asm instruction list", GDBMI_PARSING_DOMAIN);
-                    result_record.asm_instruction_list (asm_instrs);
+                    result_record.swap_asm_instruction_list (asm_instrs);
                 }
             } else if (!RAW_INPUT.compare (cur,
                                            strlen (PREFIX_NAME),  
@@ -2115,6 +2229,13 @@ fetch_gdbmi_result:
                 if (!parse_gdbmi_result (cur, cur, result)
                     || !result) {
                     LOG_PARSING_ERROR (cur);
+                } else if (is_watchpoint_result (result)) {
+                    // This is the reply of -break-watch.  Only keep
+                    // the number of the new watchpoint; the engine
+                    // fetches the watchpoint itself afterwards.
+                    UString number;
+                    if (get_tuple_string_member (result, "number", number))
+                        result_record.attrs ()["watchpoint-number"] = number;
                 } else {
                     LOG_D ("parsed unknown gdbmi result",
                            GDBMI_PARSING_DOMAIN);
@@ -2189,7 +2310,6 @@ fetch_gdbmi_result:
         return false;
     }
 
-    a_record = result_record;
     a_to = cur;
     return true;
 }
@@ -2376,6 +2496,9 @@ GDBMIParser::parse_breakpoint_with_one_loc (Glib::ustring::size_type a_from,
     if ((iter = attrs.find ("cond")) != null_iter) {
         a_bkpt.condition (iter->second);
     }
+    if ((iter = attrs.find ("evaluated-by")) != null_iter) {
+        a_bkpt.condition_evaluator (iter->second);
+    }
     a_bkpt.nb_times_hit (atoi (attrs["times"].c_str ()));
     if ((iter = attrs.find ("ignore")) != null_iter) {
         ignore_count_present = true;
@@ -2387,6 +2510,8 @@ GDBMIParser::parse_breakpoint_with_one_loc (Glib::ustring::size_type a_from,
         a_bkpt.type (IDebugger::Breakpoint::STANDARD_BREAKPOINT_TYPE);
     else if (type.find ("watchpoint") != type.npos)
         a_bkpt.type (IDebugger::Breakpoint::WATCHPOINT_TYPE);
+    else if (type == "dprintf")
+        a_bkpt.type (IDebugger::Breakpoint::DPRINTF_TYPE);
 
     // Set the initial ignore count
     if (ignore_count_present)
@@ -2556,6 +2681,184 @@ GDBMIParser::parse_breakpoint_modified_async_output (UString::size_type a_from,
     return parse_breakpoint (cur, a_to, a_b);
 }
 
+bool
+GDBMIParser::parse_breakpoint_created_async_output (UString::size_type a_from,
+                                                    UString::size_type &a_to,
+                                                    IDebugger::Breakpoint &a_b)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    UString::size_type cur = a_from;
+
+    int prefix_len = strlen (PREFIX_BREAKPOINT_CREATED_ASYNC_OUTPUT);
+    if (RAW_INPUT.compare (cur, prefix_len,
+                           PREFIX_BREAKPOINT_CREATED_ASYNC_OUTPUT)) {
+        LOG_PARSING_ERROR (cur);
+        return false;
+    }
+
+    cur += prefix_len;
+    PARSING_ERROR_IF_END (cur);
+
+    return parse_breakpoint (cur, a_to, a_b);
+}
+
+bool
+GDBMIParser::parse_breakpoint_deleted_async_output (UString::size_type a_from,
+                                                    UString::size_type &a_to,
+                                                    string &a_id)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    UString::size_type cur = a_from;
+
+    int prefix_len = strlen (PREFIX_BREAKPOINT_DELETED_ASYNC_OUTPUT);
+    if (RAW_INPUT.compare (cur, prefix_len,
+                           PREFIX_BREAKPOINT_DELETED_ASYNC_OUTPUT)) {
+        LOG_PARSING_ERROR (cur);
+        return false;
+    }
+
+    cur += prefix_len;
+    PARSING_ERROR_IF_END (cur);
+
+    UString name, value;
+    if (!parse_attribute (cur, cur, name, value)) {
+        LOG_PARSING_ERROR_MSG (cur, "was expecting an attribute");
+        return false;
+    }
+    if (name != "id" || value.empty ()) {
+        LOG_PARSING_ERROR_MSG (cur, "was expecting attribute 'id'");
+        return false;
+    }
+
+    a_id = value.raw ();
+    a_to = cur;
+    return true;
+}
+
+bool
+GDBMIParser::parse_library_async_output (UString::size_type a_from,
+                                         UString::size_type &a_to,
+                                         IDebugger::Library &a_library,
+                                         bool &a_loaded)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_D (GDBMI_PARSING_DOMAIN);
+
+    UString::size_type cur = a_from;
+
+    if (!RAW_INPUT.compare (cur,
+                            strlen (PREFIX_LIBRARY_LOADED_ASYNC_OUTPUT),
+                            PREFIX_LIBRARY_LOADED_ASYNC_OUTPUT)) {
+        a_loaded = true;
+        cur += strlen (PREFIX_LIBRARY_LOADED_ASYNC_OUTPUT);
+    } else if (!RAW_INPUT.compare
+                        (cur,
+                         strlen (PREFIX_LIBRARY_UNLOADED_ASYNC_OUTPUT),
+                         PREFIX_LIBRARY_UNLOADED_ASYNC_OUTPUT)) {
+        a_loaded = false;
+        cur += strlen (PREFIX_LIBRARY_UNLOADED_ASYNC_OUTPUT);
+    } else {
+        LOG_PARSING_ERROR (cur);
+        return false;
+    }
+    PARSING_ERROR_IF_END (cur);
+
+    IDebugger::Library library;
+    // Older versions of GDB give a single address range, with the
+    // low-address and high-address attributes, rather than the
+    // ranges list.
+    UString low_address, high_address;
+    GDBMIResultSafePtr result;
+
+    // We loop, parsing GDB/MI RESULT constructs and ',' until we
+    // reach '\n'.
+    while (true) {
+        if (!parse_gdbmi_result (cur, cur, result) || !result) {
+            LOG_PARSING_ERROR (cur);
+            return false;
+        }
+        const UString &name = result->variable ();
+        GDBMIValueSafePtr value = result->value ();
+        if (value && value->content_type () == GDBMIValue::STRING_TYPE) {
+            const UString &str = value->get_string_content ();
+            if (name == "id")
+                library.id (str);
+            else if (name == "target-name")
+                library.target_name (str);
+            else if (name == "host-name")
+                library.host_name (str);
+            else if (name == "symbols-loaded")
+                library.symbols_loaded (str == "1");
+            else if (name == "thread-group")
+                library.thread_group (str);
+            else if (name == "low-address")
+                low_address = str;
+            else if (name == "high-address")
+                high_address = str;
+        } else if (name == "ranges"
+                   && value
+                   && value->content_type () == GDBMIValue::LIST_TYPE) {
+            // ranges=[{from="<address>",to="<address>"},...]
+            list<GDBMIValueSafePtr> ranges;
+            if (value->get_list_content ()
+                && (value->get_list_content ()->content_type ()
+                    == GDBMIList::VALUE_TYPE))
+                value->get_list_content ()->get_value_content (ranges);
+            list<GDBMIValueSafePtr>::const_iterator it;
+            for (it = ranges.begin (); it != ranges.end (); ++it) {
+                if (!*it || (*it)->content_type () != GDBMIValue::TUPLE_TYPE)
+                    continue;
+                UString from, to;
+                list<GDBMIResultSafePtr>::const_iterator r;
+                for (r = (*it)->get_tuple_content ()->content ().begin ();
+                     r != (*it)->get_tuple_content ()->content ().end ();
+                     ++r) {
+                    if (!*r
+                        || !(*r)->value ()
+                        || ((*r)->value ()->content_type ()
+                            != GDBMIValue::STRING_TYPE))
+                        continue;
+                    if ((*r)->variable () == "from")
+                        from = (*r)->value ()->get_string_content ();
+                    else if ((*r)->variable () == "to")
+                        to = (*r)->value ()->get_string_content ();
+                }
+                if (!from.empty () && !to.empty ())
+                    library.address_ranges ().push_back
+                        (IDebugger::Library::AddressRange
+                            (Address (from.raw ()), Address (to.raw ())));
+            }
+        }
+        SKIP_BLANK (cur);
+        if (m_priv->index_passed_end (cur) || RAW_CHAR_AT (cur) == '\n')
+            break;
+        if (RAW_CHAR_AT (cur) != ',') {
+            LOG_PARSING_ERROR (cur);
+            return false;
+        }
+        ++cur;
+        CHECK_END (cur);
+    }
+
+    if (library.address_ranges ().empty ()
+        && !low_address.empty ()
+        && !high_address.empty ())
+        library.address_ranges ().push_back
+            (IDebugger::Library::AddressRange
+                (Address (low_address.raw ()),
+                 Address (high_address.raw ())));
+
+    if (library.id ().empty ()) {
+        LOG_PARSING_ERROR_MSG (cur, "was expecting attribute 'id'");
+        return false;
+    }
+
+    a_library = library;
+    a_to = cur;
+    return true;
+}
+
 bool
 GDBMIParser::parse_threads_list (UString::size_type a_from,
                                  UString::size_type &a_to,
@@ -2710,17 +3013,16 @@ GDBMIParser::parse_new_thread_id (UString::size_type a_from,
 
     SKIP_BLANK (cur);
 
-    if (RAW_CHAR_AT (cur) != ',') {
-        LOG_PARSING_ERROR (cur);
-        return false;
-    }
-    ++cur;
-    CHECK_END (cur);
-
+    // In non-stop mode, a running thread can be selected.  It has no
+    // frame then.
     IDebugger::Frame frame;
-    if (!parse_frame (cur, cur, frame)) {
-        LOG_PARSING_ERROR (cur);
-        return false;
+    if (!m_priv->index_passed_end (cur) && RAW_CHAR_AT (cur) == ',') {
+        ++cur;
+        CHECK_END (cur);
+        if (!parse_frame (cur, cur, frame)) {
+            LOG_PARSING_ERROR (cur);
+            return false;
+        }
     }
 
     a_to = cur;
@@ -2887,7 +3189,7 @@ GDBMIParser::parse_call_stack (const UString::size_type a_from,
         stack.push_back (frame);
         frame.clear ();
     }
-    a_stack = stack;
+    a_stack.swap (stack);
     a_to = cur;
     return true;
 }
@@ -3209,7 +3511,7 @@ GDBMIParser::parse_stack_arguments (UString::size_type a_from,
     }
 
     a_to = cur;
-    a_params = all_frames_args;
+    a_params.swap (all_frames_args);
     LOG_D ("number of frames parsed: " << (int)a_params.size (),
            GDBMI_PARSING_DOMAIN);
     return true;
@@ -4291,7 +4593,7 @@ GDBMIParser::parse_memory_values (UString::size_type a_from,
         return false;
     }
 
-    a_values = memory_values;
+    a_values.swap (memory_values);
     a_to = cur;
     return true;
 }
@@ -540,6 +540,29 @@ public:
                                                  UString::size_type &a_to,
                                                  IDebugger::Breakpoint &a_b);
 
+    /// Parse a GDB/MI async output that says that a breakpoint has
+    /// been created, e.g by a CLI command like "catch" or "break"
+    /// typed in the console.
+    bool parse_breakpoint_created_async_output (UString::size_type a_from,
+                                                UString::size_type &a_to,
+                                                IDebugger::Breakpoint &a_b);
+
+    /// Parse a GDB/MI async output that says that a breakpoint has
+    /// been deleted.  That output has the form
+    /// =breakpoint-deleted,id="<number>".
+    bool parse_breakpoint_deleted_async_output (UString::size_type a_from,
+                                                UString::size_type &a_to,
+                                                string &a_id);
+
+    /// Parse a GDB/MI async output that says that a shared library
+    /// has been loaded or unloaded.  That output has the form
+    /// =library-loaded,id="<id>",target-name="<path>",...
+    /// or =library-unloaded,id="<id>",...
+    bool parse_library_async_output (UString::size_type a_from,
+                                     UString::size_type &a_to,
+                                     IDebugger::Library &a_library,
+                                     bool &a_loaded);
+
     /// parses the result of the gdbmi command
     /// "-thread-list-ids".
     bool parse_threads_list (UString::size_type a_from,
@@ -554,6 +577,7 @@ public:
     /// got parsed.
     /// \param a_thread_id out parameter. The id of the selected thread.
     /// \param a_frame out parameter. The current frame in the selected thread.
+    /// Empty if the thread is running, in non-stop mode.
     /// \param a_level out parameter. the level
     bool parse_new_thread_id (UString::size_type a_from,
                               UString::size_type &a_to,
@@ -27,6 +27,7 @@
 #define __NMV_I_DEBUGGER_H__
 
 #include <stdint.h>
+#include <ctime>
 #include <vector>
 #include <string>
 #include <map>
@@ -39,6 +40,7 @@
 #include "common/nmv-asm-instr.h"
 #include "common/nmv-loc.h"
 #include "common/nmv-str-utils.h"
+#include "common/nmv-pool-allocator.h"
 #include "nmv-i-conf-mgr.h"
 
 using nemiver::common::SafePtr;
@@ -55,6 +57,7 @@ using nemiver::common::MixedAsmInstr;
 using nemiver::common::Asm;
 using nemiver::common::DisassembleInfo;
 using nemiver::common::Loc;
+using nemiver::common::PoolAllocator;
 using std::vector;
 using std::string;
 using std::map;
@@ -64,6 +67,7 @@ NEMIVER_BEGIN_NAMESPACE (nemiver)
 
 class ILangTrait;
 class IDebugger;
+class StopHistory;
 typedef SafePtr<IDebugger, ObjectRef, ObjectUnref> IDebuggerSafePtr;
 
 /// \brief a debugger engine.
@@ -94,7 +98,8 @@ public:
             UNDEFINED_TYPE = 0,
             STANDARD_BREAKPOINT_TYPE,
             WATCHPOINT_TYPE,
-            COUNTPOINT_TYPE
+            COUNTPOINT_TYPE,
+            DPRINTF_TYPE
         };
 
     private:
@@ -106,6 +111,9 @@ public:
         UString m_file_name;
         UString m_file_full_name;
         string m_condition;
+        // Who evaluates the condition, i.e, "host" or "target", as
+        // reported by GDB.  Empty if GDB didn't tell.
+        string m_condition_evaluator;
         Type m_type;
         int m_line;
         int m_nb_times_hit;
@@ -131,6 +139,12 @@ public:
         int m_parent_breakpoint_number;
         // Whether the breakpoint is pending.
         bool m_is_pending;
+        // When the breakpoint was last hit, if it is a countpoint or
+        // a dprintf.  Those hits are tracked by the engine, not by
+        // GDB.
+        time_t m_last_hit_time;
+        // What the last hit of a dprintf breakpoint printed.
+        string m_last_output;
 
     public:
         Breakpoint () {clear ();}
@@ -223,6 +237,15 @@ public:
 
         bool has_condition () const {return !m_condition.empty ();}
 
+        /// Whether the condition of the breakpoint is evaluated by
+        /// the target, rather than by the debugger after stopping
+        /// the inferior.
+        bool is_condition_evaluated_by_target () const
+        {
+            return has_condition () && m_condition_evaluator == "target";
+        }
+        void condition_evaluator (const string &a) {m_condition_evaluator = a;}
+
         int nb_times_hit () const {return m_nb_times_hit;}
         void nb_times_hit (int a_nb) {m_nb_times_hit = a_nb;}
 
@@ -272,6 +295,23 @@ public:
         Type type () const {return m_type;}
         void type (Type a_type) {m_type = a_type;}
 
+        /// Whether hitting this breakpoint doesn't stop the
+        /// inferior, i.e, whether it's a countpoint or a dprintf.
+        /// The hits of such a breakpoint are only counted.
+        bool is_traced () const
+        {
+            return (m_type == COUNTPOINT_TYPE || m_type == DPRINTF_TYPE);
+        }
+
+        /// The time of the last hit of a countpoint or of a dprintf,
+        /// or 0 if it has not been hit yet.
+        time_t last_hit_time () const {return m_last_hit_time;}
+        void last_hit_time (time_t a) {m_last_hit_time = a;}
+
+        /// The text printed by the last hit of a dprintf.
+        const string& last_output () const {return m_last_output;}
+        void last_output (const string &a) {m_last_output = a;}
+
         /// @}
 
         /// \brief clear this instance of breakpoint
@@ -286,6 +326,7 @@ public:
             m_file_full_name.clear ();
             m_line = 0;
             m_condition.clear ();
+            m_condition_evaluator.clear ();
             m_nb_times_hit = 0;
             m_initial_ignore_count = 0;
             m_ignore_count = 0;
@@ -294,6 +335,8 @@ public:
             m_sub_breakpoints.clear ();
             m_parent_breakpoint_number = 0;
             m_is_pending = false;
+            m_last_hit_time = 0;
+            m_last_output.clear ();
         }
     };//end class Breakpoint
 
@@ -364,6 +407,79 @@ public:
     };//end class OverloadsChoiceEntry
     typedef vector<OverloadsChoiceEntry> OverloadsChoiceEntries;
 
+    /// \brief A shared library loaded by the inferior, as reported
+    /// by the =library-loaded notifications of GDB.
+    class Library {
+    public:
+        /// The range of addresses [from, to) where a section of
+        /// the library is mapped.
+        typedef std::pair<Address, Address> AddressRange;
+
+    private:
+        UString m_id;
+        UString m_target_name;
+        UString m_host_name;
+        bool m_symbols_loaded;
+        UString m_thread_group;
+        list<AddressRange> m_address_ranges;
+
+    public:
+        Library () :
+            m_symbols_loaded (false)
+        {
+        }
+
+        /// The identifier GDB gives to the library.  It is the
+        /// same in the =library-unloaded notification.
+        const UString& id () const {return m_id;}
+        void id (const UString &a_in) {m_id = a_in;}
+
+        /// The path of the library on the target.
+        const UString& target_name () const {return m_target_name;}
+        void target_name (const UString &a_in) {m_target_name = a_in;}
+
+        /// The path of the library on the host GDB runs on.
+        const UString& host_name () const {return m_host_name;}
+        void host_name (const UString &a_in) {m_host_name = a_in;}
+
+        bool symbols_loaded () const {return m_symbols_loaded;}
+        void symbols_loaded (bool a_in) {m_symbols_loaded = a_in;}
+
+        const UString& thread_group () const {return m_thread_group;}
+        void thread_group (const UString &a_in) {m_thread_group = a_in;}
+
+        const list<AddressRange>& address_ranges () const
+        {
+            return m_address_ranges;
+        }
+        list<AddressRange>& address_ranges () {return m_address_ranges;}
+
+        /// \return true if a_address is in one of the address ranges
+        /// of the library.
+        bool contains_address (size_t a_address) const
+        {
+            list<AddressRange>::const_iterator it;
+            for (it = m_address_ranges.begin ();
+                 it != m_address_ranges.end ();
+                 ++it) {
+                if ((size_t) it->first <= a_address
+                    && a_address < (size_t) it->second)
+                    return true;
+            }
+            return false;
+        }
+
+        void clear ()
+        {
+            m_id.clear ();
+            m_target_name.clear ();
+            m_host_name.clear ();
+            m_symbols_loaded = false;
+            m_thread_group.clear ();
+            m_address_ranges.clear ();
+        }
+    };//end class Library
+
     class Variable;
     typedef SafePtr<Variable, ObjectRef, ObjectUnref> VariableSafePtr;
     typedef list<VariableSafePtr> VariableList;
@@ -492,9 +608,13 @@ public:
         // the life cycle of this instance.
         mutable IDebugger *m_debugger;
         UString m_name;
+        // The caption of the variable, when it differs from its name.
         UString m_name_caption;
         UString m_value;
-        UString m_type;
+        // The type, visualizer and display hint strings are bound to
+        // be shared by a lot of variables, so they are interned.  A
+        // nil pointer stands for the empty string.
+        const UString *m_type;
         // When using GDB pretty-printers, this is a string naming the
         // pretty printer used to visualize this variable. As
         // disabling pretty printing is not possible globally in GDB
@@ -504,8 +624,8 @@ public:
         // using  the default pretty printer; if pretty printing is
         // disabled the variable would be displayed using no pretty
         // printer.
-        UString m_visualizer;
-        UString m_display_hint;
+        const UString *m_visualizer;
+        const UString *m_display_hint;
         Variable *m_parent;
         //if this variable is a pointer,
         //it can be dereferenced. The variable
@@ -534,7 +654,9 @@ public:
             m_debugger (a_dbg),
             m_name (a_name),
             m_value (a_value),
-            m_type (a_type),
+            m_type (intern (a_type)),
+            m_visualizer (0),
+            m_display_hint (0),
             m_parent (0),
             m_num_expected_children (0),
             m_in_scope (a_in_scope),
@@ -553,7 +675,9 @@ public:
             : m_debugger (a_dbg),
             m_name (a_name),
             m_value (a_value),
-            m_type (a_type),
+            m_type (intern (a_type)),
+            m_visualizer (0),
+            m_display_hint (0),
             m_parent (0),
             m_num_expected_children (0),
             m_in_scope (a_in_scope),
@@ -569,6 +693,9 @@ public:
                            IDebugger *a_dbg = 0)
             : m_debugger (a_dbg),
             m_name (a_name),
+            m_type (0),
+            m_visualizer (0),
+            m_display_hint (0),
             m_parent (0),
             m_num_expected_children (0),
             m_in_scope (true),
@@ -582,6 +709,9 @@ public:
 
         Variable (IDebugger *a_dbg = 0)
             : m_debugger (a_dbg),
+            m_type (0),
+            m_visualizer (0),
+            m_display_hint (0),
             m_parent (0),
             m_num_expected_children (0),
             m_in_scope (true),
@@ -592,6 +722,54 @@ public:
         {
         }
 
+        /// \return the pool the variables are allocated from.
+        static PoolAllocator& pool ()
+        {
+            static PoolAllocator &s_pool =
+                PoolAllocator::get (sizeof (Variable));
+            return s_pool;
+        }
+
+        /// Variables are allocated from a pool rather than one by
+        /// one from the heap, as there can be hundreds of thousands
+        /// of them after a stop.
+        static void* operator new (size_t a_size)
+        {
+            return pool ().allocate (a_size);
+        }
+
+        static void operator delete (void *a_ptr, size_t a_size)
+        {
+            pool ().deallocate (a_ptr, a_size);
+        }
+
+        /// Give the memory of the pool of variables, and the strings
+        /// interned by the variables, back to the system once no
+        /// variable is alive anymore.  This is meant to be called at
+        /// the end of a debugging session.
+        static void release_memory_when_unused ()
+        {
+            pool ().release_when_unused
+                        (&nemiver::str_utils::clear_interned_strings);
+        }
+
+        /// \return the interned instance of a_str, or nil if a_str
+        /// is empty.
+        static const UString* intern (const UString &a_str)
+        {
+            if (a_str.empty ())
+                return 0;
+            return &nemiver::str_utils::intern (a_str);
+        }
+
+        /// \return the string pointed to by a_str, or the empty
+        /// string if a_str is nil.
+        static const UString& interned_or_empty (const UString *a_str)
+        {
+            static const UString empty;
+            return a_str ? *a_str : empty;
+        }
+
         ~Variable ()
         {
             // If this variable is peered with an engine-side variable
@@ -600,9 +778,7 @@ public:
             if (m_debugger
                 && !internal_name ().empty ()
                 && m_debugger->is_attached_to_target ()) {
-                IDebugger::DefaultSlot empty_slot;
-                m_debugger->delete_variable (internal_name (),
-                                             empty_slot);
+                m_debugger->release_variable (internal_name ());
             }
         }
 
@@ -730,25 +906,38 @@ public:
         const UString& name () const {return m_name;}
         void name (const UString &a_name)
         {
-            m_name_caption = a_name;
+            m_name_caption.clear ();
             m_name = a_name;
         }
 
-        const UString& name_caption () const {return m_name_caption;}
-        void name_caption (const UString &a_n) {m_name_caption = a_n;}
+        /// \return the caption of the variable.  It defaults to the
+        /// name of the variable.
+        const UString& name_caption () const
+        {
+            return m_name_caption.empty () ? m_name : m_name_caption;
+        }
+        void name_caption (const UString &a_n)
+        {
+            if (a_n == m_name)
+                m_name_caption.clear ();
+            else
+                m_name_caption = a_n;
+        }
 
         const UString& value () const {return m_value;}
         void value (const UString &a_value) {m_value = a_value;}
 
-        const UString& type () const {return m_type;}
-        void type (const UString &a_type) {m_type = a_type;}
-        void type (const string &a_type) {m_type = a_type;}
+        const UString& type () const {return interned_or_empty (m_type);}
+        void type (const UString &a_type) {m_type = intern (a_type);}
+        void type (const string &a_type) {m_type = intern (a_type);}
 
-        const UString& visualizer () const {return m_visualizer;}
-        void visualizer (const UString &a) {m_visualizer = a;}
+        const UString& visualizer () const
+        {return interned_or_empty (m_visualizer);}
+        void visualizer (const UString &a) {m_visualizer = intern (a);}
 
-        const UString& display_hint () const {return m_display_hint;};
-        void display_hint (const UString &a) {m_display_hint = a;}
+        const UString& display_hint () const
+        {return interned_or_empty (m_display_hint);}
+        void display_hint (const UString &a) {m_display_hint = intern (a);}
 
         /// Return true if this instance of Variable has a parent variable,
         /// false otherwise.
@@ -1025,6 +1214,216 @@ public:
 
     };//end class Variable
 
+    /// \brief Timings and counters of the hot paths of the debugging
+    /// engine.
+    ///
+    /// All the times are in microseconds, as returned by
+    /// g_get_monotonic_time.  Keeping these up to date is cheap
+    /// enough for the engine to do it all the time.
+    class PerfStats {
+    public:
+
+        /// The life cycle of a command sent to the debugger.
+        class CommandTiming {
+            UString m_name;
+            gint64 m_queued_time;
+            gint64 m_issued_time;
+            gint64 m_reply_time;
+            gint64 m_handled_time;
+
+        public:
+            CommandTiming () :
+                m_queued_time (0),
+                m_issued_time (0),
+                m_reply_time (0),
+                m_handled_time (0)
+            {
+            }
+
+            const UString& name () const {return m_name;}
+            void name (const UString &a_name) {m_name = a_name;}
+
+            /// When the command was put in the command queue.
+            gint64 queued_time () const {return m_queued_time;}
+            void queued_time (gint64 a) {m_queued_time = a;}
+
+            /// When the command was written to the debugger.
+            gint64 issued_time () const {return m_issued_time;}
+            void issued_time (gint64 a) {m_issued_time = a;}
+
+            /// When the result record of the command was received.
+            gint64 reply_time () const {return m_reply_time;}
+            void reply_time (gint64 a) {m_reply_time = a;}
+
+            /// When the output handlers were done with the result
+            /// record of the command.
+            gint64 handled_time () const {return m_handled_time;}
+            void handled_time (gint64 a) {m_handled_time = a;}
+        };//end class CommandTiming
+
+        /// The number of buckets of the histograms of HandlerStats.
+        /// The buckets grow tenfold: the first one holds the
+        /// durations under 10 microseconds, bucket N the durations
+        /// from 10^N up to 10^(N+1) microseconds, and the last one
+        /// every duration from 10^6 microseconds (one second) on.
+        enum {
+            NB_HISTOGRAM_BUCKETS = 7
+        };
+
+        /// The time spent in a given output handler.
+        class HandlerStats {
+            unsigned long m_nb_calls;
+            gint64 m_total_time;
+            gint64 m_max_time;
+            unsigned long m_histogram[NB_HISTOGRAM_BUCKETS];
+
+        public:
+            HandlerStats () :
+                m_nb_calls (0),
+                m_total_time (0),
+                m_max_time (0)
+            {
+                for (int i = 0; i < NB_HISTOGRAM_BUCKETS; ++i)
+                    m_histogram[i] = 0;
+            }
+
+            /// \return the index of the histogram bucket of a
+            /// duration, in microseconds.  See NB_HISTOGRAM_BUCKETS.
+            static int bucket_of (gint64 a_duration)
+            {
+                int i = 0;
+                for (gint64 limit = 10;
+                     i < NB_HISTOGRAM_BUCKETS - 1 && a_duration >= limit;
+                     limit *= 10)
+                    ++i;
+                return i;
+            }
+
+            void record (gint64 a_duration)
+            {
+                ++m_nb_calls;
+                m_total_time += a_duration;
+                if (a_duration > m_max_time)
+                    m_max_time = a_duration;
+                ++m_histogram[bucket_of (a_duration)];
+            }
+
+            unsigned long nb_calls () const {return m_nb_calls;}
+            gint64 total_time () const {return m_total_time;}
+            gint64 max_time () const {return m_max_time;}
+            unsigned long histogram (int a_bucket) const
+            {
+                return m_histogram[a_bucket];
+            }
+        };//end class HandlerStats
+
+        /// The maximum number of command timings kept around.
+        enum {
+            MAX_NB_COMMAND_TIMINGS = 1000
+        };
+
+    private:
+        list<CommandTiming> m_command_timings;
+        map<UString, HandlerStats> m_handler_stats;
+        guint64 m_nb_bytes_parsed;
+        gint64 m_parse_time;
+        unsigned long m_nb_records_parsed;
+        gint64 m_dispatch_time;
+        unsigned long m_nb_dispatches;
+        unsigned m_queue_depth;
+        unsigned m_max_queue_depth;
+
+    public:
+        PerfStats ()
+        {
+            clear ();
+        }
+
+        /// The timings of the most recently completed commands,
+        /// oldest first.
+        const list<CommandTiming>& command_timings () const
+        {
+            return m_command_timings;
+        }
+
+        void add_command_timing (const CommandTiming &a_timing)
+        {
+            m_command_timings.push_back (a_timing);
+            if (m_command_timings.size () > MAX_NB_COMMAND_TIMINGS)
+                m_command_timings.pop_front ();
+        }
+
+        /// The time spent in each output handler, keyed by handler
+        /// name.
+        const map<UString, HandlerStats>& handler_stats () const
+        {
+            return m_handler_stats;
+        }
+
+        void record_handler_time (const UString &a_handler,
+                                  gint64 a_duration)
+        {
+            m_handler_stats[a_handler].record (a_duration);
+        }
+
+        void record_parsing (gsize a_nb_bytes, gint64 a_duration)
+        {
+            m_nb_bytes_parsed += a_nb_bytes;
+            m_parse_time += a_duration;
+            ++m_nb_records_parsed;
+        }
+
+        /// Record the time it took to hand one parsed output over
+        /// to all the output handlers.
+        void record_dispatch (gint64 a_duration)
+        {
+            m_dispatch_time += a_duration;
+            ++m_nb_dispatches;
+        }
+
+        gint64 dispatch_time () const {return m_dispatch_time;}
+        unsigned long nb_dispatches () const {return m_nb_dispatches;}
+
+        guint64 nb_bytes_parsed () const {return m_nb_bytes_parsed;}
+        gint64 parse_time () const {return m_parse_time;}
+        unsigned long nb_records_parsed () const
+        {
+            return m_nb_records_parsed;
+        }
+
+        /// \return the parsing throughput, in bytes per second.
+        double parse_bytes_per_second () const
+        {
+            if (!m_parse_time)
+                return 0;
+            return m_nb_bytes_parsed * 1000000.0 / m_parse_time;
+        }
+
+        /// The number of commands waiting in the command queue.
+        unsigned queue_depth () const {return m_queue_depth;}
+        void queue_depth (unsigned a_depth)
+        {
+            m_queue_depth = a_depth;
+            if (a_depth > m_max_queue_depth)
+                m_max_queue_depth = a_depth;
+        }
+
+        unsigned max_queue_depth () const {return m_max_queue_depth;}
+
+        void clear ()
+        {
+            m_command_timings.clear ();
+            m_handler_stats.clear ();
+            m_nb_bytes_parsed = 0;
+            m_parse_time = 0;
+            m_nb_records_parsed = 0;
+            m_dispatch_time = 0;
+            m_nb_dispatches = 0;
+            m_queue_depth = 0;
+            m_max_queue_depth = 0;
+        }
+    };//end class PerfStats
+
     enum State {
         // The inferior hasn't been loaded.
         NOT_STARTED=0,
@@ -1125,6 +1524,22 @@ public:
     /// function IDebugger::re_run.
     virtual sigc::signal<void>& inferior_re_run_signal () const = 0;
 
+    /// Signal emitted when a checkpoint was set by
+    /// IDebugger::set_checkpoint.  Its argument is the id of the
+    /// checkpoint, to pass to IDebugger::restart_from_checkpoint.
+    virtual sigc::signal<void,
+                         int/*checkpoint id*/,
+                         const UString&/*cookie*/>&
+                                    checkpoint_set_signal () const = 0;
+
+    /// Signal emitted whenever the inferior loads or unloads shared
+    /// libraries, i.e, whenever the code mapped in the address space
+    /// of the inferior changes.  Libraries are often loaded in
+    /// bursts, e.g. at startup; the signal is then emitted once, at
+    /// the end of the burst, or at the next stop of the inferior.
+    /// The libraries are listed by IDebugger::get_libraries.
+    virtual sigc::signal<void>& libraries_changed_signal () const = 0;
+
     virtual sigc::signal<void,
                         const IDebugger::Breakpoint&,
                         const string& /*breakpoint number*/,
@@ -1172,6 +1587,13 @@ public:
                          const UString& /*cookie*/> &
                                              thread_selected_signal () const=0;
 
+    /// Emitted when a thread of the inferior starts or stops
+    /// running.  The thread id is -1 if all the threads did.
+    virtual sigc::signal<void,
+                         int/*thread id*/,
+                         bool/*is running*/>&
+                                    thread_state_changed_signal () const=0;
+
     virtual sigc::signal<void,
                         const vector<IDebugger::Frame>&,
                         const UString&>& frames_listed_signal () const=0;
@@ -1254,6 +1676,15 @@ public:
     virtual sigc::signal<void, const UString&/*error message*/>&
                                                     error_signal () const = 0;
 
+    /// Signal emitted whenever GDB reports that a command failed.
+    /// Unlike error_signal, it lets the client tell which of its
+    /// requests failed, by looking at the command cookie.
+    virtual sigc::signal<void,
+                         const UString&/*command name*/,
+                         const UString&/*command cookie*/,
+                         const UString&/*error message*/>&
+                                        command_error_signal () const = 0;
+
     virtual sigc::signal<void, IDebugger::State>&
                                         state_changed_signal () const = 0;
 
@@ -1327,6 +1758,15 @@ public:
 
     virtual sigc::signal<void, VariableSafePtr, const UString&>&
                 assigned_variable_signal () const = 0;
+
+    /// This signal is emitted each time the visualizer of a member
+    /// variable has been set during a revisualization initiated by
+    /// IDebugger::revisualize_variable.  The parameters of the slot
+    /// are the number of member variables done so far and the number
+    /// of member variables of all the pending revisualizations.  Both
+    /// are equal when the last pending member is done.
+    virtual sigc::signal<void, int, int>&
+                variables_revisualization_progress_signal () const = 0;
     /// @}
 
     virtual void do_init (IConfMgrSafePtr a_conf_mgr) = 0;
@@ -1367,6 +1807,18 @@ public:
                  bool a_uses_launch_tty = false,
                  bool a_force = false) = 0;
 
+    /// Spawn, in the background, a GDB process that loads a given
+    /// program and keep it aside, so that a later load_program on
+    /// that program in that working directory starts with the
+    /// symbols already read.  This does nothing unless the
+    /// gdb-process-pool setting is on.
+    ///
+    /// \param a_prog the path to the program.
+    ///
+    /// \param a_working_dir the working directory of the program.
+    virtual void prewarm_program (const UString &a_prog,
+                                  const UString &a_working_dir) = 0;
+
     virtual void load_core_file (const UString &a_prog_file,
                                  const UString &a_core_file) = 0;
 
@@ -1408,6 +1860,28 @@ public:
 
     virtual void re_run (const DefaultSlot &) = 0;
 
+    /// Save the state of the stopped inferior in a checkpoint, i.e,
+    /// in a fork of the inferior that waits to be restarted from.
+    /// IDebugger::checkpoint_set_signal is emitted once it's done.
+    ///
+    /// If the inferior exits while checkpoints are kept, it goes
+    /// back to one of them, as if restart_from_checkpoint had been
+    /// called, rather than finishing.
+    virtual void set_checkpoint (const UString &a_cookie = "") = 0;
+
+    /// Restart the inferior from a checkpoint, rather than from the
+    /// start of the program.  The inferior is then stopped where the
+    /// checkpoint was set, and that is notified by
+    /// IDebugger::stopped_signal, with no particular stop reason.
+    /// The checkpoint is used up by the restart, so a new one is set
+    /// in its place, and notified by IDebugger::checkpoint_set_signal.
+    /// The process that was debugged until then is killed.
+    ///
+    /// \param a_checkpoint_id the id of the checkpoint, as notified
+    /// by IDebugger::checkpoint_set_signal.
+    virtual void restart_from_checkpoint (int a_checkpoint_id,
+                                          const UString &a_cookie = "") = 0;
+
     virtual IDebugger::State get_state () const = 0;
 
     virtual int get_current_frame_level () const = 0;
@@ -1422,6 +1896,18 @@ public:
 
     virtual void step_out (const UString &a_cookie="") = 0;
 
+    /// Step over a_nb_steps lines in a row, notifying only the
+    /// last stop.  See GDBEngine::fast_forward_step_over.
+    virtual void fast_forward_step_over (unsigned a_nb_steps,
+                                         const UString &a_cookie="") = 0;
+
+    /// Step over lines until the value of a_expression changes,
+    /// notifying only the last stop.  See
+    /// GDBEngine::fast_forward_until_changed.
+    virtual void fast_forward_until_changed (const UString &a_expression,
+                                             unsigned a_max_nb_steps = 1000,
+                                             const UString &a_cookie="") = 0;
+
     virtual void step_over_asm (const UString &a_cookie="") = 0;
 
     virtual void step_in_asm (const UString &a_cookie="") = 0;
@@ -1488,6 +1974,28 @@ public:
 
     virtual bool is_countpoint (const Breakpoint &a_breakpoint) const = 0;
 
+    /// Set a dprintf breakpoint, i.e, a breakpoint that prints
+    /// a_format, like printf, each time it's hit, and that doesn't
+    /// stop the inferior.  Its hits are notified by
+    /// breakpoints_set_signal at a limited rate, like those of
+    /// countpoints.
+    ///
+    /// \param a_path the path of the source file to set the
+    /// breakpoint in.
+    ///
+    /// \param a_line_num the line number to set the breakpoint at.
+    ///
+    /// \param a_format the printf-like format to print.  Like in a
+    /// C program, it can contain escapes, e.g. \\n for a new line.
+    ///
+    /// \param a_args the expressions to print, one per conversion
+    /// specification of a_format.
+    virtual void set_dprintf (const UString &a_path,
+                              gint a_line_num,
+                              const UString &a_format,
+                              const vector<UString> &a_args,
+                              const UString &a_cookie = "") = 0;
+
     virtual void delete_breakpoint (const UString &a_path,
                                     gint a_line_num,
                                     const UString &a_cookie="") = 0;
@@ -1524,6 +2032,14 @@ public:
 
     virtual unsigned int get_current_thread () const = 0;
 
+    /// \return true if GDB runs in non-stop mode, i.e, if a thread
+    /// of the inferior can be stopped while the others keep
+    /// running.
+    virtual bool is_non_stop_mode () const = 0;
+
+    /// \return true if a given thread of the inferior is running.
+    virtual bool is_thread_running (int a_thread_id) const = 0;
+
     virtual void select_frame (int a_frame_id,
                                const UString &a_cookie="") = 0;
 
@@ -1697,6 +2213,21 @@ public:
                                   const DefaultSlot &a_slot,
                                   const UString &a_cookie = "") = 0;
 
+    /// Tell the backend that a variable object (e.g, for GDB, a so
+    /// called variable object) named by a given string is not used
+    /// anymore.  Unlike delete_variable, the backend is free to
+    /// delete it later, e.g, when it has nothing else to do.  This
+    /// is what the destructor of IDebugger::Variable uses.
+    ///
+    /// Note that when the backend counter part is eventually deleted,
+    /// the IDebugger::variable_deleted_signal is invoked, with null
+    /// pointer to IDebugger::Variable.  The children of a variable
+    /// object deleted that way are not notified separately.
+    ///
+    /// \param a_internal_name the name of the backend variable object
+    /// that is not used anymore.
+    virtual void release_variable (const UString &a_internal_name) = 0;
+
     virtual void unfold_variable (VariableSafePtr a_var,
                                   const UString &a_cookie = "") = 0;
     virtual void unfold_variable
@@ -1765,6 +2296,42 @@ public:
 
     virtual void enable_pretty_printing (bool a_flag = true) = 0;
 
+    /// \return the timings and counters of the hot paths of the
+    /// debugging engine.
+    virtual const PerfStats& get_perf_stats () const = 0;
+
+    virtual void reset_perf_stats () = 0;
+
+    /// Write the timings of the recently completed commands to a
+    /// file, in the Chrome trace event JSON format, so that they can
+    /// be examined with chrome://tracing.
+    ///
+    /// \param a_path the path of the file to write.
+    ///
+    /// \return true upon successful completion.
+    virtual bool dump_perf_trace (const UString &a_path) const = 0;
+
+    /// \return the record of the recent stops of the inferior: the
+    /// frames, call stacks, and register and variable values seen
+    /// at each of them.  See nmv-stop-history.h.
+    virtual const StopHistory& get_stop_history () const = 0;
+
+    /// \return the shared libraries currently loaded by the
+    /// inferior, by id.
+    virtual const map<UString, Library>& get_libraries () const = 0;
+
+    /// Find the shared library that is mapped at a given address,
+    /// without asking GDB.
+    ///
+    /// \param a_address the address to look up.
+    ///
+    /// \param a_library out parameter.  Set to the library found,
+    /// iff the function returned true.
+    ///
+    /// \return true if a library is mapped at a_address.
+    virtual bool find_library_at_address (const Address &a_address,
+                                          Library &a_library) const = 0;
+
 };//end IDebugger
 
 NEMIVER_END_NAMESPACE (nemiver)
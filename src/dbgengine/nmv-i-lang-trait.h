@@ -53,6 +53,46 @@ protected:
 
 public:
 
+    /// What the debugging engine and the variable views need to know
+    /// about a type.  Language traits compute it once per distinct
+    /// type string and share it among all the variables of that type.
+    class TypeDescriptor {
+        bool m_is_pointer;
+        bool m_is_reference;
+        bool m_is_array;
+        bool m_is_compound;
+        bool m_is_container;
+
+    public:
+        TypeDescriptor () :
+            m_is_pointer (false),
+            m_is_reference (false),
+            m_is_array (false),
+            m_is_compound (false),
+            m_is_container (false)
+        {
+        }
+
+        bool is_pointer () const {return m_is_pointer;}
+        void is_pointer (bool a) {m_is_pointer = a;}
+
+        bool is_reference () const {return m_is_reference;}
+        void is_reference (bool a) {m_is_reference = a;}
+
+        bool is_array () const {return m_is_array;}
+        void is_array (bool a) {m_is_array = a;}
+
+        /// Whether values of the type are made of named members,
+        /// e.g. a struct, class or union.
+        bool is_compound () const {return m_is_compound;}
+        void is_compound (bool a) {m_is_compound = a;}
+
+        /// Whether the type is a well known container, e.g.
+        /// std::vector.  A container is also compound.
+        bool is_container () const {return m_is_container;}
+        void is_container (bool a) {m_is_container = a;}
+    };//end class TypeDescriptor
+
     virtual ~ILangTrait () {}
 
     virtual const UString& get_name () const = 0;
@@ -64,6 +104,8 @@ public:
 
     /// \name language features
     /// @{
+    virtual const TypeDescriptor& get_type_descriptor
+                                        (const UString &a_type) const = 0;
     virtual bool is_type_a_pointer (const UString &a_type) const = 0;
     virtual bool is_variable_compound
                         (const nemiver::IDebugger::VariableSafePtr) const = 0;
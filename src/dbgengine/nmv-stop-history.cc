@@ -0,0 +1,499 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#include <deque>
+#include "common/nmv-exception.h"
+#include "nmv-stop-history.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+
+/// The default number of stops kept by a StopHistory.
+static const unsigned DEFAULT_CAPACITY = 512;
+
+/// Values longer than this are truncated before being recorded, so
+/// that a single huge array cannot blow the memory budget.
+static const UString::size_type MAX_VALUE_LENGTH = 1024;
+
+/// The whole state is kept for one stop out of this many, once it
+/// has been rebuilt.
+static const unsigned KEYFRAME_INTERVAL = 32;
+
+typedef StopHistory::register_id_t register_id_t;
+typedef StopHistory::VariableKey VariableKey;
+typedef std::map<register_id_t, UString> RegisterMap;
+typedef std::map<VariableKey, UString> VariableMap;
+
+struct StopHistory::Priv {
+
+    /// What is stored for each stop: only what changed since the
+    /// previous stop.
+    struct Entry {
+        unsigned long stop_number;
+        IDebugger::StopReason reason;
+        int thread_id;
+        IDebugger::Frame frame;
+        bool has_call_stack;
+        // The number of outermost frames of the call stack that are
+        // the same as in the call stack of the previous entry.
+        unsigned nb_shared_frames;
+        // The other frames, innermost first.
+        std::vector<IDebugger::Frame> new_frames;
+        // The registers and variables that changed during the stop.
+        RegisterMap registers;
+        VariableMap variables;
+        // Only the oldest entry has these: the values that were
+        // known before it, folded in from the entries that were
+        // dropped.
+        RegisterMap base_registers;
+        VariableMap base_variables;
+
+        Entry () :
+            stop_number (0),
+            reason (IDebugger::UNDEFINED_REASON),
+            thread_id (-1),
+            has_call_stack (false),
+            nb_shared_frames (0)
+        {
+        }
+    };
+
+    /// The whole state at the end of a stop.
+    struct Keyframe {
+        std::vector<IDebugger::Frame> call_stack;
+        RegisterMap registers;
+        VariableMap variables;
+    };
+
+    unsigned capacity;
+    unsigned long nb_stops;
+    std::deque<Entry> entries;
+    // The whole state at some of the stops, by stop number.  Only
+    // stops that are over are there, as their state can't change
+    // anymore.
+    mutable std::map<unsigned long, Keyframe> keyframes;
+    // The full call stack of the entry before the last one, which
+    // the call stack of the last entry is encoded against, and the
+    // full call stack of the last entry.
+    std::vector<IDebugger::Frame> prev_call_stack;
+    std::vector<IDebugger::Frame> cur_call_stack;
+    // The values of the registers and variables as of the last
+    // entry.
+    RegisterMap registers;
+    VariableMap variables;
+    RegisterMap register_names;
+    mutable sigc::signal<void> changed_signal;
+
+    Priv () :
+        capacity (DEFAULT_CAPACITY),
+        nb_stops (0)
+    {
+    }
+
+    static bool frames_equal (const IDebugger::Frame &a_lhs,
+                              const IDebugger::Frame &a_rhs)
+    {
+        return a_lhs.address () == a_rhs.address ()
+            && a_lhs.function_name () == a_rhs.function_name ();
+    }
+
+    /// Encode a call stack against the one of the previous entry.
+    static void encode_call_stack
+                    (const std::vector<IDebugger::Frame> &a_prev,
+                     const std::vector<IDebugger::Frame> &a_frames,
+                     Entry &a_entry)
+    {
+        unsigned nb_shared = 0;
+        while (nb_shared < a_prev.size ()
+               && nb_shared < a_frames.size ()
+               && frames_equal (a_prev[a_prev.size () - 1 - nb_shared],
+                                a_frames[a_frames.size () - 1 - nb_shared]))
+            ++nb_shared;
+        a_entry.has_call_stack = true;
+        a_entry.nb_shared_frames = nb_shared;
+        a_entry.new_frames.assign (a_frames.begin (),
+                                   a_frames.end () - nb_shared);
+    }
+
+    /// Rebuild the full call stack of an entry from the full call
+    /// stack of the previous entry.
+    static void decode_call_stack
+                    (const std::vector<IDebugger::Frame> &a_prev,
+                     const Entry &a_entry,
+                     std::vector<IDebugger::Frame> &a_frames)
+    {
+        a_frames.clear ();
+        if (!a_entry.has_call_stack)
+            return;
+        THROW_IF_FAIL (a_entry.nb_shared_frames <= a_prev.size ());
+        a_frames = a_entry.new_frames;
+        a_frames.insert (a_frames.end (),
+                         a_prev.end () - a_entry.nb_shared_frames,
+                         a_prev.end ());
+        for (unsigned i = 0; i < a_frames.size (); ++i)
+            a_frames[i].level (i);
+    }
+
+    static UString truncate (const UString &a_value)
+    {
+        if (a_value.size () <= MAX_VALUE_LENGTH)
+            return a_value;
+        UString result = a_value.substr (0, MAX_VALUE_LENGTH);
+        result += "...";
+        return result;
+    }
+
+    /// Drop the oldest entry, folding what it knows into the next
+    /// one, which becomes the oldest.
+    void drop_oldest_entry ()
+    {
+        THROW_IF_FAIL (!entries.empty ());
+        keyframes.erase (entries[0].stop_number);
+        if (entries.size () == 1) {
+            entries.pop_front ();
+            prev_call_stack.clear ();
+            cur_call_stack.clear ();
+            return;
+        }
+
+        Entry &oldest = entries[0], &next = entries[1];
+
+        std::vector<IDebugger::Frame> oldest_stack, next_stack;
+        std::vector<IDebugger::Frame> nil;
+        decode_call_stack (nil, oldest, oldest_stack);
+        if (next.has_call_stack) {
+            decode_call_stack (oldest_stack, next, next_stack);
+            next.nb_shared_frames = 0;
+            next.new_frames.swap (next_stack);
+        }
+
+        // The base values of the next entry are the values known
+        // at the end of the oldest one, minus what the next entry
+        // changes itself.
+        next.base_registers.swap (oldest.base_registers);
+        RegisterMap::const_iterator r;
+        for (r = oldest.registers.begin (); r != oldest.registers.end (); ++r)
+            next.base_registers[r->first] = r->second;
+        for (r = next.registers.begin (); r != next.registers.end (); ++r)
+            next.base_registers.erase (r->first);
+
+        next.base_variables.swap (oldest.base_variables);
+        VariableMap::const_iterator v;
+        for (v = oldest.variables.begin (); v != oldest.variables.end (); ++v)
+            next.base_variables[v->first] = v->second;
+        for (v = next.variables.begin (); v != next.variables.end (); ++v)
+            next.base_variables.erase (v->first);
+
+        entries.pop_front ();
+
+        // The oldest entry is encoded against nothing.
+        if (entries.size () == 1)
+            prev_call_stack.clear ();
+    }
+};//end struct StopHistory::Priv
+
+StopHistory::StopHistory () :
+    m_priv (new Priv)
+{
+}
+
+StopHistory::~StopHistory ()
+{
+}
+
+/// \return the maximum number of stops that are kept.
+unsigned
+StopHistory::capacity () const
+{
+    return m_priv->capacity;
+}
+
+/// Set the maximum number of stops that are kept.  The oldest
+/// stops are dropped if there are too many of them already.
+void
+StopHistory::capacity (unsigned a_capacity)
+{
+    m_priv->capacity = a_capacity;
+    bool changed = false;
+    while (m_priv->entries.size () > m_priv->capacity) {
+        m_priv->drop_oldest_entry ();
+        changed = true;
+    }
+    if (changed)
+        m_priv->changed_signal.emit ();
+}
+
+/// \return the number of stops that are kept.
+unsigned
+StopHistory::size () const
+{
+    return m_priv->entries.size ();
+}
+
+/// Forget about all the stops, e.g, when the inferior is re-run.
+void
+StopHistory::clear ()
+{
+    m_priv->entries.clear ();
+    m_priv->keyframes.clear ();
+    m_priv->prev_call_stack.clear ();
+    m_priv->cur_call_stack.clear ();
+    m_priv->registers.clear ();
+    m_priv->variables.clear ();
+    m_priv->changed_signal.emit ();
+}
+
+/// Start recording a new stop.  The call stack, registers and
+/// variables recorded next are attached to that stop.
+///
+/// \param a_reason the reason of the stop.
+///
+/// \param a_frame the frame the inferior stopped in.
+///
+/// \param a_thread_id the thread that stopped.
+void
+StopHistory::record_stop (IDebugger::StopReason a_reason,
+                          const IDebugger::Frame &a_frame,
+                          int a_thread_id)
+{
+    if (!m_priv->capacity)
+        return;
+
+    if (m_priv->entries.empty () || !m_priv->entries.back ().has_call_stack)
+        m_priv->cur_call_stack.clear ();
+    m_priv->prev_call_stack.swap (m_priv->cur_call_stack);
+    m_priv->cur_call_stack.clear ();
+
+    m_priv->entries.push_back (Priv::Entry ());
+    Priv::Entry &entry = m_priv->entries.back ();
+    entry.stop_number = ++m_priv->nb_stops;
+    entry.reason = a_reason;
+    entry.frame = a_frame;
+    entry.thread_id = a_thread_id;
+
+    while (m_priv->entries.size () > m_priv->capacity)
+        m_priv->drop_oldest_entry ();
+
+    m_priv->changed_signal.emit ();
+}
+
+/// Record the call stack of the current stop.  Only the frames that
+/// differ from the call stack of the previous stop are stored.
+///
+/// The call stack is often listed several times during a stop, in
+/// chunks starting at the innermost frame.  The longest listing
+/// wins.  The call stacks of the threads that did not stop are
+/// ignored.
+///
+/// \param a_frames the call stack, innermost frame first.
+///
+/// \param a_thread_id the thread the call stack is the one of.
+void
+StopHistory::record_call_stack (const std::vector<IDebugger::Frame> &a_frames,
+                                int a_thread_id)
+{
+    if (m_priv->entries.empty ()
+        || m_priv->entries.back ().thread_id != a_thread_id
+        || (m_priv->entries.back ().has_call_stack
+            && m_priv->cur_call_stack.size () > a_frames.size ()))
+        return;
+    Priv::encode_call_stack (m_priv->prev_call_stack, a_frames,
+                             m_priv->entries.back ());
+    m_priv->cur_call_stack = a_frames;
+    m_priv->changed_signal.emit ();
+}
+
+/// Record the values of some registers at the current stop.  Only
+/// the values that changed are stored.
+void
+StopHistory::record_register_values (const RegisterMap &a_values)
+{
+    if (m_priv->entries.empty ())
+        return;
+
+    Priv::Entry &entry = m_priv->entries.back ();
+    bool changed = false;
+    RegisterMap::const_iterator it;
+    for (it = a_values.begin (); it != a_values.end (); ++it) {
+        UString value = Priv::truncate (it->second);
+        RegisterMap::iterator known = m_priv->registers.find (it->first);
+        if (known != m_priv->registers.end () && known->second == value)
+            continue;
+        m_priv->registers[it->first] = value;
+        entry.registers[it->first] = value;
+        changed = true;
+    }
+    if (changed)
+        m_priv->changed_signal.emit ();
+}
+
+/// Record the value of a variable at the current stop.  It's not
+/// stored if it did not change.
+///
+/// \param a_scope the thread and function the variable lives in.
+///
+/// \param a_qname the qualified name of the variable, e.g, "foo.bar".
+///
+/// \param a_value the value of the variable.
+void
+StopHistory::record_variable_value (const VariableScope &a_scope,
+                                    const UString &a_qname,
+                                    const UString &a_value)
+{
+    if (m_priv->entries.empty () || a_qname.empty ())
+        return;
+
+    VariableKey key (a_scope, a_qname);
+    UString value = Priv::truncate (a_value);
+    VariableMap::iterator known = m_priv->variables.find (key);
+    if (known != m_priv->variables.end () && known->second == value)
+        return;
+    m_priv->variables[key] = value;
+    m_priv->entries.back ().variables[key] = value;
+    m_priv->changed_signal.emit ();
+}
+
+/// \return the name of the function of a frame of the thread that
+/// stopped last, or an empty string if that frame is not known.
+///
+/// \param a_thread_id the thread of the frame.
+///
+/// \param a_frame_level the level of the frame, 0 being the
+/// innermost one.
+UString
+StopHistory::function_name (int a_thread_id, unsigned a_frame_level) const
+{
+    if (m_priv->entries.empty ())
+        return "";
+    const Priv::Entry &entry = m_priv->entries.back ();
+    if (entry.thread_id != a_thread_id)
+        return "";
+    if (a_frame_level < m_priv->cur_call_stack.size ())
+        return m_priv->cur_call_stack[a_frame_level].function_name ();
+    if (a_frame_level == 0)
+        return entry.frame.function_name ();
+    return "";
+}
+
+/// Record the names of the registers.  They are the same for all
+/// the stops.
+void
+StopHistory::record_register_names (const RegisterMap &a_names)
+{
+    RegisterMap::const_iterator it;
+    for (it = a_names.begin (); it != a_names.end (); ++it)
+        m_priv->register_names[it->first] = it->second;
+}
+
+/// \return the names of the registers, by register id.
+const RegisterMap&
+StopHistory::register_names () const
+{
+    return m_priv->register_names;
+}
+
+/// Rebuild the state of the inferior at a given stop.
+///
+/// \param a_index the index of the stop, from 0 for the oldest
+/// stop kept to size () - 1 for the current one.
+///
+/// \param a_snapshot the resulting state.  Set only if the function
+/// returned true.
+///
+/// \return true if a_index designates a stop that is kept, false
+/// otherwise.
+bool
+StopHistory::get_snapshot (unsigned a_index, Snapshot &a_snapshot) const
+{
+    if (a_index >= m_priv->entries.size ())
+        return false;
+
+    // The stop numbers of the entries follow each other.  Start
+    // from the closest keyframe before the stop, if any, rather
+    // than from the oldest stop.
+    unsigned long first_stop = m_priv->entries[0].stop_number;
+    unsigned long target_stop = m_priv->entries[a_index].stop_number;
+    std::vector<IDebugger::Frame> prev_stack, stack;
+    RegisterMap registers;
+    VariableMap variables;
+    unsigned i = 0;
+    std::map<unsigned long, Priv::Keyframe>::const_iterator keyframe =
+        m_priv->keyframes.upper_bound (target_stop);
+    if (keyframe != m_priv->keyframes.begin ()) {
+        --keyframe;
+        prev_stack = keyframe->second.call_stack;
+        registers = keyframe->second.registers;
+        variables = keyframe->second.variables;
+        i = keyframe->first - first_stop + 1;
+    } else {
+        registers = m_priv->entries[0].base_registers;
+        variables = m_priv->entries[0].base_variables;
+    }
+
+    for (; i <= a_index; ++i) {
+        const Priv::Entry &entry = m_priv->entries[i];
+        Priv::decode_call_stack (prev_stack, entry, stack);
+        prev_stack.swap (stack);
+        RegisterMap::const_iterator r;
+        for (r = entry.registers.begin (); r != entry.registers.end (); ++r)
+            registers[r->first] = r->second;
+        VariableMap::const_iterator v;
+        for (v = entry.variables.begin (); v != entry.variables.end (); ++v)
+            variables[v->first] = v->second;
+        if (entry.stop_number % KEYFRAME_INTERVAL == 0
+            && i + 1 < m_priv->entries.size ()
+            && !m_priv->keyframes.count (entry.stop_number)) {
+            Priv::Keyframe &k = m_priv->keyframes[entry.stop_number];
+            k.call_stack = prev_stack;
+            k.registers = registers;
+            k.variables = variables;
+        }
+    }
+
+    const Priv::Entry &entry = m_priv->entries[a_index];
+    a_snapshot.stop_number = entry.stop_number;
+    a_snapshot.reason = entry.reason;
+    a_snapshot.thread_id = entry.thread_id;
+    a_snapshot.frame = entry.frame;
+    a_snapshot.call_stack.swap (prev_stack);
+    a_snapshot.registers.swap (registers);
+    a_snapshot.variables.swap (variables);
+    a_snapshot.changed_registers.clear ();
+    RegisterMap::const_iterator r;
+    for (r = entry.registers.begin (); r != entry.registers.end (); ++r)
+        a_snapshot.changed_registers.push_back (r->first);
+    a_snapshot.changed_variables.clear ();
+    VariableMap::const_iterator v;
+    for (v = entry.variables.begin (); v != entry.variables.end (); ++v)
+        a_snapshot.changed_variables.push_back (v->first);
+    return true;
+}
+
+/// Emitted whenever something is recorded, or stops are dropped.
+sigc::signal<void>&
+StopHistory::changed_signal () const
+{
+    return m_priv->changed_signal;
+}
+
+NEMIVER_END_NAMESPACE (nemiver)
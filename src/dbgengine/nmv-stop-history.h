@@ -0,0 +1,154 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#ifndef __NMV_STOP_HISTORY_H__
+#define __NMV_STOP_HISTORY_H__
+
+#include <vector>
+#include <map>
+#include <list>
+#include "nmv-i-debugger.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+
+/// A bounded record of the recent stops of the inferior.
+///
+/// For each stop, this records the frame the inferior stopped in,
+/// its call stack, and the register and variable values the
+/// debugging engine saw during that stop.  Only what changed since
+/// the previous stop is kept: the frames of the call stack that
+/// are shared with the previous stop, and the registers and
+/// variables that kept their values, are not stored again.  The
+/// stops are kept in a ring buffer; the oldest one is folded into
+/// the next one when the buffer is full, so memory use is bounded
+/// by the capacity, whatever the number of steps.
+///
+/// Any stop can then be looked at again through get_snapshot,
+/// without asking GDB anything.  The state at some of the stops is
+/// kept whole the first time it is rebuilt, so that looking at a
+/// stop only replays the few stops since the closest of these.
+class NEMIVER_API StopHistory {
+    //non copyable
+    StopHistory (const StopHistory&);
+    StopHistory& operator= (const StopHistory&);
+
+    struct Priv;
+    SafePtr<Priv> m_priv;
+
+public:
+
+    typedef IDebugger::register_id_t register_id_t;
+
+    /// Where a variable lives: the thread and the function of the
+    /// frame it was created in.  Variables of the same name in
+    /// different scopes are different variables.
+    struct VariableScope {
+        int thread_id;
+        UString function_name;
+
+        VariableScope (int a_thread_id = -1,
+                       const UString &a_function_name = "") :
+            thread_id (a_thread_id),
+            function_name (a_function_name)
+        {
+        }
+
+        bool operator< (const VariableScope &a_other) const
+        {
+            if (thread_id != a_other.thread_id)
+                return thread_id < a_other.thread_id;
+            return function_name < a_other.function_name;
+        }
+    };
+
+    /// A variable is known by its scope and its qualified name.
+    typedef std::pair<VariableScope, UString> VariableKey;
+
+    /// The state of the inferior as it was at a given stop.
+    struct Snapshot {
+        /// The number of the stop, counting from the beginning of
+        /// the session.
+        unsigned long stop_number;
+        IDebugger::StopReason reason;
+        int thread_id;
+        IDebugger::Frame frame;
+        /// Empty if the call stack was not listed during that stop.
+        std::vector<IDebugger::Frame> call_stack;
+        /// The last known values of the registers, by register id.
+        std::map<register_id_t, UString> registers;
+        /// The last known values of the variables, by scope and
+        /// qualified name.
+        std::map<VariableKey, UString> variables;
+        /// The registers which value changed during that stop.
+        std::list<register_id_t> changed_registers;
+        /// The variables which value changed during that stop.
+        std::list<VariableKey> changed_variables;
+
+        Snapshot () :
+            stop_number (0),
+            reason (IDebugger::UNDEFINED_REASON),
+            thread_id (-1)
+        {
+        }
+    };
+
+    StopHistory ();
+    ~StopHistory ();
+
+    unsigned capacity () const;
+    void capacity (unsigned a_capacity);
+
+    unsigned size () const;
+
+    void clear ();
+
+    void record_stop (IDebugger::StopReason a_reason,
+                      const IDebugger::Frame &a_frame,
+                      int a_thread_id);
+
+    void record_call_stack (const std::vector<IDebugger::Frame> &a_frames,
+                            int a_thread_id);
+
+    void record_register_values
+                (const std::map<register_id_t, UString> &a_values);
+
+    void record_variable_value (const VariableScope &a_scope,
+                                const UString &a_qname,
+                                const UString &a_value);
+
+    UString function_name (int a_thread_id, unsigned a_frame_level) const;
+
+    void record_register_names
+                (const std::map<register_id_t, UString> &a_names);
+
+    const std::map<register_id_t, UString>& register_names () const;
+
+    bool get_snapshot (unsigned a_index, Snapshot &a_snapshot) const;
+
+    sigc::signal<void>& changed_signal () const;
+};//end class StopHistory
+
+NEMIVER_END_NAMESPACE (nemiver)
+
+#endif //__NMV_STOP_HISTORY_H__
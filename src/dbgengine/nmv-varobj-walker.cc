@@ -216,8 +216,13 @@ VarobjWalker::do_walk_variable_real (const IDebugger::VariableSafePtr a_var,
     if (a_max_depth == 0)
         return;
 
+    ILangTrait &lang_trait = m_debugger->get_language_trait ();
+    // Do not follow pointers: what they point to is not a member of
+    // the variable, and following them can loop forever on a linked
+    // structure.
     if (a_var->needs_unfolding ()
-        && m_debugger->get_language_trait ().is_variable_compound (a_var)) {
+        && !lang_trait.get_type_descriptor (a_var->type ()).is_pointer ()
+        && lang_trait.is_variable_compound (a_var)) {
         LOG_DD ("needs unfolding");
         m_variable_unfolds++;
         m_debugger->unfold_variable
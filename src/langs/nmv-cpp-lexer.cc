@@ -24,9 +24,11 @@
  */
 #include <cstring>
 #include <deque>
+#include <vector>
 #include "nmv-cpp-lexer.h"
 
 using std::deque;
+using std::vector;
 
 NEMIVER_BEGIN_NAMESPACE (nemiver)
 NEMIVER_BEGIN_NAMESPACE (cpp)
@@ -42,28 +44,113 @@ NEMIVER_BEGIN_NAMESPACE (cpp)
 //<class Lexer implem>
 //********************
 struct Lexer::Priv {
-    string input;
+    //the copy of the input, when the lexer owns it.
+    string input_copy;
+    //the character stream. It either points into input_copy or
+    //into a buffer borrowed from the caller.
+    const char *input;
+    string::size_type input_size;
     //points to the current character in the char stream
     string::size_type cursor;
-    deque<string::size_type> recorded_positions;
+    vector<string::size_type> recorded_positions;
     deque<Token> tokens_queue;
     //points to the next token in the token stream;
     deque<Token>::size_type token_cursor;
 
     Priv (const string &a_in) :
-        input (a_in),
+        input_copy (a_in),
+        input (input_copy.data ()),
+        input_size (input_copy.size ()),
         cursor (0),
         token_cursor (0)
     {
     }
 
-    Priv () :
+    Priv (const char *a_buf, string::size_type a_len) :
+        input (a_buf),
+        input_size (a_len),
         cursor (0),
         token_cursor (0)
     {
     }
 };//end struct Lexer::Priv
 
+/// The C++ keywords.
+static const char *s_keywords[] = {
+    "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+    "case", "catch", "char", "class", "compl", "const", "const_cast",
+    "continue", "default", "delete", "do", "double", "dynamic_cast",
+    "else", "enum", "explicit", "export", "extern", "false", "float",
+    "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+    "namespace", "new", "not", "not_eq", "operator", "or", "or_eq",
+    "private", "protected", "public", "register", "reinterpret_cast",
+    "return", "short", "signed", "sizeof", "static", "static_cast",
+    "struct", "switch", "template", "this", "throw", "true", "try",
+    "typedef", "typeid", "typename", "union", "unsigned", "using",
+    "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+    0
+};
+
+/// The seed and the size of the keyword hash table.  The seed has
+/// been chosen so that keyword_hash is a perfect hash function for
+/// s_keywords, i.e, no two keywords share the same slot.  It must be
+/// chosen again whenever a keyword is added; test_lexer_keyword_table
+/// in tests/test-cpp-lexer.cc fails otherwise.
+enum {
+    KEYWORD_HASH_SEED = 389316,
+    KEYWORD_TABLE_SIZE = 256
+};
+
+static unsigned
+keyword_hash (const char *a_str, string::size_type a_len)
+{
+    unsigned hash = KEYWORD_HASH_SEED;
+    for (string::size_type i = 0; i < a_len; ++i) {
+        hash = (hash ^ (unsigned char) a_str[i]) * 16777619u;
+    }
+    return (hash ^ (hash >> 15)) & (KEYWORD_TABLE_SIZE - 1);
+}
+
+/// \return the keyword hash table, each slot of which holds either
+/// a keyword or zero.
+static const char**
+get_keyword_table ()
+{
+    static const char *s_table[KEYWORD_TABLE_SIZE];
+    static bool s_initialized = false;
+    if (!s_initialized) {
+        for (const char **kw = s_keywords; *kw; ++kw) {
+            unsigned slot = keyword_hash (*kw, strlen (*kw));
+            // A slot that is taken already means KEYWORD_HASH_SEED
+            // is not valid for s_keywords anymore.  Keep the first
+            // keyword; the others are scanned as identifiers.
+            if (!s_table[slot])
+                s_table[slot] = *kw;
+        }
+        s_initialized = true;
+    }
+    return s_table;
+}
+
+/// Look a word up in the C++ keyword set.
+///
+/// \param a_str the word to look up.  It doesn't have to be zero
+/// terminated.
+///
+/// \param a_len the length of the word.
+///
+/// \return the keyword if a_str is a keyword, zero otherwise.
+static const char*
+lookup_keyword (const char *a_str, string::size_type a_len)
+{
+    const char *keyword = get_keyword_table ()[keyword_hash (a_str, a_len)];
+    if (keyword
+        && !strncmp (keyword, a_str, a_len)
+        && keyword[a_len] == 0)
+        return keyword;
+    return 0;
+}
+
 #define CUR m_priv->cursor
 
 #define INPUT m_priv->input
@@ -71,9 +158,9 @@ struct Lexer::Priv {
 #define CUR_CHAR INPUT[CUR]
 
 #define IN_BOUNDS(cursor) \
-((cursor) < m_priv->input.size ())
+((cursor) < m_priv->input_size)
 
-#define CURSOR_IN_BOUNDS (CUR < INPUT.size ())
+#define CURSOR_IN_BOUNDS (CUR < m_priv->input_size)
 
 #define CHECK_CURSOR_BOUNDS \
 if (!IN_BOUNDS (CUR)) {return false;}
@@ -81,9 +168,6 @@ if (!IN_BOUNDS (CUR)) {return false;}
 #define CHECK_CURSOR_BOUNDS2 \
 if (!IN_BOUNDS (CUR)) {return;}
 
-#define SCAN_KEYWORD(len,key) \
-((!(INPUT.compare (CUR, len, key)) and (key_length=len)))
-
 #define MOVE_FORWARD(nb) CUR += nb
 
 #define MOVE_FORWARD_AND_CHECK(nb) {CUR+=nb;if (!IN_BOUNDS(CUR)) {goto error;}}
@@ -97,6 +181,18 @@ Lexer::Lexer (const string &a_in)
     m_priv = new Lexer::Priv (a_in);
 }
 
+/// Build a lexer that scans a buffer it doesn't own.  The buffer is
+/// not copied so it must outlive the lexer.
+///
+/// \param a_buf the buffer to scan.  It doesn't have to be zero
+/// terminated.
+///
+/// \param a_len the length of a_buf.
+Lexer::Lexer (const char *a_buf, string::size_type a_len)
+{
+    m_priv = new Lexer::Priv (a_buf, a_len);
+}
+
 Lexer::~Lexer ()
 {
     if (m_priv) {
@@ -116,7 +212,7 @@ Lexer::next_is (const char *a_char_seq) const
     int len = strlen (a_char_seq);
     if (!len)
         return false;
-    if (IN_BOUNDS (CUR + len - 1) && !INPUT.compare (CUR, len, a_char_seq)) {
+    if (IN_BOUNDS (CUR + len - 1) && !strncmp (INPUT + CUR, a_char_seq, len)) {
         return true;
     }
     return false;
@@ -811,95 +907,23 @@ bool
 Lexer::scan_keyword (Token &a_token)
 {
     CHECK_CURSOR_BOUNDS
-    int key_length=0;
-
-    if (SCAN_KEYWORD (3, "and") or
-        SCAN_KEYWORD (6, "and_eq") or
-        SCAN_KEYWORD (3, "asm")  or
-        SCAN_KEYWORD (4, "auto")  or
-        SCAN_KEYWORD (6, "bitand") or
-        SCAN_KEYWORD (5, "bitor") or
-        SCAN_KEYWORD (4, "bool") or
-        SCAN_KEYWORD (5, "break") or
-        SCAN_KEYWORD (4, "case") or
-        SCAN_KEYWORD (5, "catch") or
-        SCAN_KEYWORD (4, "char") or
-        SCAN_KEYWORD (5, "class") or
-        SCAN_KEYWORD (5, "compl") or
-        SCAN_KEYWORD (5, "const") or
-        SCAN_KEYWORD (10, "const_cast") or
-        SCAN_KEYWORD (8, "continue") or
-        SCAN_KEYWORD (7, "default") or
-        SCAN_KEYWORD (6, "delete") or
-        SCAN_KEYWORD (2, "do") or
-        SCAN_KEYWORD (6, "double") or
-        SCAN_KEYWORD (12, "dynamic_cast") or
-        SCAN_KEYWORD (4, "else") or
-        SCAN_KEYWORD (4, "enum") or
-        SCAN_KEYWORD (8, "explicit") or
-        SCAN_KEYWORD (6, "export") or
-        SCAN_KEYWORD (6, "extern") or
-        SCAN_KEYWORD (5, "false") or
-        SCAN_KEYWORD (5, "float") or
-        SCAN_KEYWORD (3, "for") or
-        SCAN_KEYWORD (6, "friend") or
-        SCAN_KEYWORD (4, "goto") or
-        SCAN_KEYWORD (2, "if") or
-        SCAN_KEYWORD (6, "inline") or
-        SCAN_KEYWORD (3, "int") or
-        SCAN_KEYWORD (4, "long") or
-        SCAN_KEYWORD (7, "mutable") or
-        SCAN_KEYWORD (9, "namespace") or
-        SCAN_KEYWORD (3, "new") or
-        SCAN_KEYWORD (3, "not") or
-        SCAN_KEYWORD (6, "not_eq") or
-        SCAN_KEYWORD (8, "operator") or
-        SCAN_KEYWORD (2, "or") or
-        SCAN_KEYWORD (5, "or_eq") or
-        SCAN_KEYWORD (7, "private") or
-        SCAN_KEYWORD (9, "protected") or
-        SCAN_KEYWORD (6, "public") or
-        SCAN_KEYWORD (8, "register") or
-        SCAN_KEYWORD (16, "reinterpret_cast") or
-        SCAN_KEYWORD (6, "return") or
-        SCAN_KEYWORD (5, "short") or
-        SCAN_KEYWORD (6, "signed") or
-        SCAN_KEYWORD (6, "sizeof") or
-        SCAN_KEYWORD (6, "static") or
-        SCAN_KEYWORD (11, "static_cast") or
-        SCAN_KEYWORD (6, "struct") or
-        SCAN_KEYWORD (6, "switch") or
-        SCAN_KEYWORD (8, "template") or
-        SCAN_KEYWORD (4, "this") or
-        SCAN_KEYWORD (5, "throw") or
-        SCAN_KEYWORD (4, "true") or
-        SCAN_KEYWORD (3, "try") or
-        SCAN_KEYWORD (7, "typedef") or
-        SCAN_KEYWORD (6, "typeid") or
-        SCAN_KEYWORD (8, "typename") or
-        SCAN_KEYWORD (5, "union") or
-        SCAN_KEYWORD (8, "unsigned") or
-        SCAN_KEYWORD (5, "using") or
-        SCAN_KEYWORD (7, "virtual") or
-        SCAN_KEYWORD (4, "void") or
-        SCAN_KEYWORD (8, "volatile") or
-        SCAN_KEYWORD (7, "wchar_t") or
-        SCAN_KEYWORD (5, "while") or
-        SCAN_KEYWORD (3, "xor") or
-        SCAN_KEYWORD (6, "xor_eq")) {
-            if (IN_BOUNDS (CUR + key_length + 1)
-                && (is_nondigit (INPUT[CUR+key_length])
-                    || is_digit (INPUT[CUR+key_length]))) {
-                //keyword + char following the keyword
-                //could be an identifier
-                return false;
-            }
-            string value = INPUT.substr (CUR, key_length);
-            a_token.set (Token::KEYWORD, value);
-            CUR += key_length;
-            return true;
+
+    //a keyword is a whole word: a keyword followed by identifier
+    //characters is an identifier.
+    string::size_type end = CUR;
+    while (IN_BOUNDS (end)
+           && (is_nondigit (INPUT[end]) || is_digit (INPUT[end]))) {
+        ++end;
     }
-    return false;
+    if (end == CUR)
+        return false;
+
+    const char *keyword = lookup_keyword (INPUT + CUR, end - CUR);
+    if (!keyword)
+        return false;
+    a_token.set (Token::KEYWORD, string (keyword, end - CUR));
+    CUR = end;
+    return true;
 }
 
 bool
@@ -1366,13 +1390,13 @@ Lexer::consume_next_token (Token &a_token)
 bool
 Lexer::reached_eof () const
 {
-    return (CUR >= INPUT.size ());
+    return (CUR >= m_priv->input_size);
 }
 
 void
 Lexer::record_ci_position ()
 {
-    m_priv->recorded_positions.push_front (CUR);
+    m_priv->recorded_positions.push_back (CUR);
 }
 
 void
@@ -1380,8 +1404,8 @@ Lexer::restore_ci_position ()
 {
     if (m_priv->recorded_positions.empty ())
         return;
-    CUR = m_priv->recorded_positions.front ();
-    m_priv->recorded_positions.pop_front ();
+    CUR = m_priv->recorded_positions.back ();
+    m_priv->recorded_positions.pop_back ();
     //m_priv->tokens_queue.clear ();
 }
 
@@ -1390,7 +1414,7 @@ Lexer::pop_recorded_ci_position ()
 {
     if (m_priv->recorded_positions.empty ())
         return;
-    m_priv->recorded_positions.pop_front ();
+    m_priv->recorded_positions.pop_back ();
 }
 
 unsigned
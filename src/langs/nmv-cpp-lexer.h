@@ -99,6 +99,7 @@ private:
 
 public:
     Lexer (const string &a_in);
+    Lexer (const char *a_buf, string::size_type a_len);
     ~Lexer ();
 
 
@@ -57,6 +57,13 @@ struct Parser::Priv {
         in_lt_nesting_context (0)
     {
     }
+
+    Priv (const char *a_buf, string::size_type a_len):
+        lexer (a_buf, a_len),
+        parsing_template_argument (0),
+        in_lt_nesting_context (0)
+    {
+    }
 };
 
 #define LEXER m_priv->lexer
@@ -66,6 +73,13 @@ Parser::Parser (const string &a_in) :
 {
 }
 
+/// Build a parser that reads a buffer it doesn't own.  The buffer is
+/// not copied so it must outlive the parser.
+Parser::Parser (const char *a_buf, string::size_type a_len) :
+    m_priv (new Priv (a_buf, a_len))
+{
+}
+
 Parser::~Parser ()
 {
 }
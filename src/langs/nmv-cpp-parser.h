@@ -46,6 +46,7 @@ class NEMIVER_API Parser {
 
 public:
     Parser (const string&);
+    Parser (const char *a_buf, string::size_type a_len);
     ~Parser ();
     bool parse_primary_expr (PrimaryExprPtr &);
     bool parse_postfix_expr (PostfixExprPtr &);
@@ -94,6 +95,7 @@ public:
     bool parse_simple_declaration (SimpleDeclarationPtr &a_result);
 };//end class Parser
 typedef shared_ptr<Parser> ParserPtr;
+
 NEMIVER_END_NAMESPACE (nemiver)
 NEMIVER_END_NAMESPACE (cpp)
 #endif //__NMV_CPP_PARSER_H__
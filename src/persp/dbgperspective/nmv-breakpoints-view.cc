@@ -24,6 +24,7 @@
  */
 #include "config.h"
 #include <map>
+#include <ctime>
 #include <glib/gi18n.h>
 #include <gtkmm/treeview.h>
 #include <gtkmm/liststore.h>
@@ -52,6 +53,9 @@ struct BPColumns : public Gtk::TreeModelColumnRecord {
     Gtk::TreeModelColumn<int> ignore_count;
     Gtk::TreeModelColumn<IDebugger::Breakpoint> breakpoint;
     Gtk::TreeModelColumn<bool> is_standard;
+    Gtk::TreeModelColumn<Glib::ustring> last_hit;
+    Gtk::TreeModelColumn<Glib::ustring> last_output;
+    Gtk::TreeModelColumn<Glib::ustring> condition_evaluator;
 
     enum INDEXES {
         ENABLE_INDEX = 0,
@@ -65,7 +69,10 @@ struct BPColumns : public Gtk::TreeModelColumnRecord {
         TYPE_INDEX,
         HITS_INDEX,
         EXPRESSION_INDEX,
-        IGNORE_COUNT_INDEX
+        IGNORE_COUNT_INDEX,
+        LAST_HIT_INDEX,
+        LAST_OUTPUT_INDEX,
+        CONDITION_EVALUATOR_INDEX
     };
 
     BPColumns ()
@@ -84,6 +91,9 @@ struct BPColumns : public Gtk::TreeModelColumnRecord {
         add (expression);
         add (ignore_count);
         add (is_standard);
+        add (last_hit);
+        add (last_output);
+        add (condition_evaluator);
     }
 };//end Cols
 
@@ -98,6 +108,12 @@ struct BreakpointsView::Priv {
 public:
     SafePtr<Gtk::TreeView> tree_view;
     Glib::RefPtr<Gtk::ListStore> list_store;
+    // Index of the rows of list_store, keyed by the id of the
+    // breakpoint they show, e.g "2" or "2.1" for the first location
+    // of breakpoint 2.  Rows of a Gtk::ListStore are persistent so
+    // these iterators remain valid until their row is erased.
+    typedef std::map<string, Gtk::TreeModel::iterator> RowIndex;
+    RowIndex row_index;
     Gtk::Widget *breakpoints_menu;
     sigc::signal<void,
                  const IDebugger::Breakpoint&> go_to_breakpoint_signal;
@@ -105,7 +121,6 @@ public:
     IWorkbench& workbench;
     IPerspective& perspective;
     IDebuggerSafePtr& debugger;
-    bool is_up2date;
 
     Priv (IWorkbench& a_workbench,
           IPerspective& a_perspective,
@@ -113,8 +128,7 @@ public:
         breakpoints_menu(0),
         workbench(a_workbench),
         perspective(a_perspective),
-        debugger(a_debugger),
-        is_up2date (true)
+        debugger(a_debugger)
     {
         init_actions ();
         build_tree_view ();
@@ -158,9 +172,14 @@ public:
         tree_view->append_column (_("Hits"), get_bp_cols ().hits);
         tree_view->append_column (_("Expression"),
                                   get_bp_cols ().expression);
+        tree_view->append_column_editable (_("Ignore count"),
+                                           get_bp_cols ().ignore_count);
+        tree_view->append_column (_("Last Hit"), get_bp_cols ().last_hit);
+        tree_view->append_column (_("Last Output"),
+                                  get_bp_cols ().last_output);
         nb_columns =
-            tree_view->append_column_editable (_("Ignore count"),
-                                               get_bp_cols ().ignore_count);
+            tree_view->append_column (_("Condition Evaluated By"),
+                                      get_bp_cols ().condition_evaluator);
 	
 	for (int i = 0; i < nb_columns; ++i) {
             Gtk::TreeViewColumn *col = tree_view->get_column (i);
@@ -216,19 +235,6 @@ public:
         tree_view->signal_key_press_event ().connect
             (sigc::mem_fun
              (*this, &Priv::on_key_press_event));
-        tree_view->signal_draw ().connect_notify
-            (sigc::mem_fun
-             (*this, &Priv::on_draw_signal));
-    }
-
-    bool
-    should_process_now ()
-    {
-        LOG_FUNCTION_SCOPE_NORMAL_DD;
-        THROW_IF_FAIL (tree_view);
-        bool is_visible = tree_view->get_is_drawable ();
-        LOG_DD ("is visible: " << is_visible);
-        return is_visible;
     }
 
     /// If a_bp is a breakpoint already present in the tree model,
@@ -325,18 +331,80 @@ public:
     {
         THROW_IF_FAIL (list_store);
 
-        Gtk::TreeModel::iterator iter;
-        for (iter = list_store->children ().begin ();
-             iter != list_store->children ().end ();
-             ++iter) {
-            if ((*iter)[get_bp_cols ().id] == a_breakpoint.id ()) {
-                return iter;
-            }
-        }
+        RowIndex::const_iterator i = row_index.find (a_breakpoint.id ());
+        if (i != row_index.end ())
+            return i->second;
         // Breakpoint not found in model, return an invalid iter
         return Gtk::TreeModel::iterator();
     }
 
+    /// Erase the row of the breakpoint which id is a_id, if any.
+    void
+    erase_row (const string &a_id)
+    {
+        RowIndex::iterator i = row_index.find (a_id);
+        if (i == row_index.end ())
+            return;
+        list_store->erase (i->second);
+        row_index.erase (i);
+    }
+
+    /// Erase the rows "N.1", "N.2" ... of the locations of the
+    /// breakpoint which number is a_number.  Note that these ids
+    /// are contiguous in row_index.
+    void
+    erase_location_rows (const string &a_number)
+    {
+        string prefix = a_number + ".";
+        RowIndex::iterator i = row_index.lower_bound (prefix);
+        while (i != row_index.end ()
+               && !i->first.compare (0, prefix.size (), prefix)) {
+            list_store->erase (i->second);
+            row_index.erase (i++);
+        }
+    }
+
+    /// Erase all the rows of the breakpoint which number is a_number,
+    /// i.e, the row "N" and the rows of its locations.
+    void
+    erase_rows_of_breakpoint (const string &a_number)
+    {
+        erase_row (a_number);
+        erase_location_rows (a_number);
+    }
+
+    /// Update the rows of a breakpoint that was notified as set.  If
+    /// the breakpoint is already in the model, only its rows are
+    /// touched.  Rows of locations it doesn't have anymore are
+    /// erased.
+    void
+    update_or_append_breakpoint_rows (const IDebugger::Breakpoint &a_bp)
+    {
+        if (!a_bp.has_multiple_locations ()) {
+            // Drop rows of locations the breakpoint might have had.
+            erase_location_rows (a_bp.id ());
+            update_or_append_breakpoint (a_bp);
+            return;
+        }
+
+        // The breakpoint has several locations; drop the row of the
+        // breakpoint itself, if it was shown as a single location.
+        erase_row (a_bp.id ());
+        vector<IDebugger::Breakpoint>::const_iterator si;
+        for (si = a_bp.sub_breakpoints ().begin ();
+             si != a_bp.sub_breakpoints ().end ();
+             ++si)
+            update_or_append_breakpoint (*si);
+    }
+
+    void
+    clear_rows ()
+    {
+        row_index.clear ();
+        if (list_store)
+            list_store->clear ();
+    }
+
     void
     update_breakpoint (Gtk::TreeModel::iterator& a_iter,
                        const IDebugger::Breakpoint &a_breakpoint)
@@ -352,6 +420,14 @@ public:
         (*a_iter)[get_bp_cols ().filename] = a_breakpoint.file_name ();
         (*a_iter)[get_bp_cols ().line] = a_breakpoint.line ();
         (*a_iter)[get_bp_cols ().condition] = a_breakpoint.condition ();
+        // A condition the target evaluates doesn't cost a stop of the
+        // inferior on each hit of the breakpoint.
+        if (!a_breakpoint.has_condition ())
+            (*a_iter)[get_bp_cols ().condition_evaluator] = "";
+        else if (a_breakpoint.is_condition_evaluated_by_target ())
+            (*a_iter)[get_bp_cols ().condition_evaluator] = _("target");
+        else
+            (*a_iter)[get_bp_cols ().condition_evaluator] = _("host");
         (*a_iter)[get_bp_cols ().expression] = a_breakpoint.expression ();
         (*a_iter)[get_bp_cols ().ignore_count] =
                                         a_breakpoint.ignore_count ();
@@ -370,10 +446,30 @@ public:
 	case IDebugger::Breakpoint::COUNTPOINT_TYPE:
 	  (*a_iter)[get_bp_cols ().type] = _("countpoint");
 	  break;
+	case IDebugger::Breakpoint::DPRINTF_TYPE:
+	  (*a_iter)[get_bp_cols ().type] = _("dprintf");
+	  break;
 	default:
 	  (*a_iter)[get_bp_cols ().type] = _("unknown");
         }
         (*a_iter)[get_bp_cols ().hits] = a_breakpoint.nb_times_hit ();
+
+        // Countpoints and dprintf breakpoints don't stop the
+        // inferior; when they were last hit, and what they printed,
+        // is all there is to see about those hits.
+        Glib::ustring last_hit;
+        if (a_breakpoint.last_hit_time ()) {
+            time_t t = a_breakpoint.last_hit_time ();
+            struct tm tm;
+            char buf[16] = {0};
+            localtime_r (&t, &tm);
+            strftime (buf, sizeof (buf), "%H:%M:%S", &tm);
+            last_hit = buf;
+        }
+        (*a_iter)[get_bp_cols ().last_hit] = last_hit;
+        UString last_output = a_breakpoint.last_output ();
+        last_output.chomp ();
+        (*a_iter)[get_bp_cols ().last_output] = last_output;
     }
 
     void
@@ -389,16 +485,10 @@ public:
         } else {
             Gtk::TreeModel::iterator tree_iter = list_store->append ();
             update_breakpoint (tree_iter, a_bp);
+            row_index[a_bp.id ()] = tree_iter;
         }
     }
 
-    void
-    finish_handling_debugger_stopped_event ()
-    {
-        LOG_FUNCTION_SCOPE_NORMAL_DD;
-        debugger->list_breakpoints ();
-    }
-
     Gtk::Widget*
     load_menu (UString a_filename, UString a_widget_name)
     {
@@ -485,20 +575,7 @@ public:
     {
 
         LOG_DD ("asked to erase bp num:" << a_bp_num);
-
-        Gtk::TreeModel::iterator iter;
-        for (iter = list_store->children ().begin ();
-             iter != list_store->children ().end ();
-             ++iter) {
-            if ((*iter)[get_bp_cols ().id] == a_bp_num) {
-                break;
-            }
-        }
-
-        if (iter != list_store->children ().end ()) {
-            LOG_DD ("erased bp");
-            list_store->erase (iter);
-        }
+        erase_row (a_bp_num);
     }
 
     void 
@@ -526,16 +603,9 @@ public:
 
         LOG_DD ("a_reason: " << a_reason << " bkpt num: " << a_bkpt_num);
 
-        if (a_reason == IDebugger::BREAKPOINT_HIT
-            || a_reason == IDebugger::WATCHPOINT_TRIGGER
-            || a_reason == IDebugger::READ_WATCHPOINT_TRIGGER
-            || a_reason == IDebugger::ACCESS_WATCHPOINT_TRIGGER) {
-            if (should_process_now ()) {
-                finish_handling_debugger_stopped_event ();
-            } else {
-                is_up2date = false;
-            }
-        } else if (a_reason == IDebugger::WATCHPOINT_SCOPE) {
+        // The new hit counts of the breakpoints that are hit come
+        // with =breakpoint-modified, as breakpoints_set_signal.
+        if (a_reason == IDebugger::WATCHPOINT_SCOPE) {
             LOG_DD ("erase watchpoint num: " << a_bkpt_num);
             erase_breakpoint (a_bkpt_num);
         }
@@ -549,21 +619,7 @@ public:
                                            const UString &/*a_cookie*/)
     {
         NEMIVER_TRY
-        list<Gtk::TreeModel::iterator> iters_to_erase;
-        for (Gtk::TreeModel::iterator iter = list_store->children ().begin ();
-             iter != list_store->children ().end ();
-             ++iter) {
-            IDebugger::Breakpoint bp = (*iter)[get_bp_cols ().breakpoint];
-            if (bp.parent_id () == a_break_number) {
-                iters_to_erase.push_back (iter);
-            }
-        }
-        list<Gtk::TreeModel::iterator>::iterator it;
-        for (it = iters_to_erase.begin ();
-             it != iters_to_erase.end ();
-             ++it) {
-            list_store->erase (*it);
-        }
+        erase_rows_of_breakpoint (a_break_number);
         NEMIVER_CATCH
     }
 
@@ -576,9 +632,9 @@ public:
 
         std::map<string, IDebugger::Breakpoint>::const_iterator i;
         for (i = a.begin (); i != a.end (); ++i) {
-            LOG_DD ("Adding breakpoints "
+            LOG_DD ("Adding or updating breakpoint "
                     << i->second.id ());
-            append_breakpoint (i->second);
+            update_or_append_breakpoint_rows (i->second);
         }
 
         NEMIVER_CATCH;
@@ -691,18 +747,6 @@ public:
         }
     }
 
-    void
-    on_draw_signal (const Cairo::RefPtr<Cairo::Context> &)
-    {
-        LOG_FUNCTION_SCOPE_NORMAL_DD;
-        NEMIVER_TRY
-        if (!is_up2date) {
-            finish_handling_debugger_stopped_event ();
-            is_up2date = true;
-        }
-        NEMIVER_CATCH
-    }
-
     bool 
     on_key_press_event (GdkEventKey* event)
     {
@@ -839,9 +883,7 @@ void
 BreakpointsView::clear ()
 {
     THROW_IF_FAIL (m_priv);
-    if (m_priv->list_store) {
-        m_priv->list_store->clear ();
-    }
+    m_priv->clear_rows ();
 }
 
 void
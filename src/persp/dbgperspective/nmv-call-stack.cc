@@ -317,12 +317,20 @@ struct CallStack::Priv {
     }
 
     void
-    on_thread_selected_signal (int /*a_thread_id*/,
+    on_thread_selected_signal (int a_thread_id,
                                const IDebugger::Frame* const /*a_frame*/,
                                const UString& a_cookie)
     {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
+        NEMIVER_TRY
+        // In non-stop mode, the selected thread can be running; it
+        // has no call stack then.
+        if (debugger->is_thread_running (a_thread_id)) {
+            clear_frame_list (true /* reset frame window */);
+            return;
+        }
         handle_update (a_cookie);
+        NEMIVER_CATCH
     }
 
     void
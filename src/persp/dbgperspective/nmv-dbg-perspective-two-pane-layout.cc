@@ -74,6 +74,9 @@ struct DBGPerspectiveTwoPaneLayout::Priv {
 #ifdef WITH_MEMORYVIEW
             case MEMORY_VIEW_INDEX:
 #endif // WITH_MEMORYVIEW
+            case PERF_VIEW_INDEX:
+            case STOP_HISTORY_VIEW_INDEX:
+            case LIBRARIES_VIEW_INDEX:
                 return *vertical_statuses_notebook;
 
             default:
@@ -31,6 +31,7 @@
 #include <unistd.h>
 #include <algorithm>
 #include <iostream>
+#include <set>
 #include <sstream>
 #include <glib/gi18n.h>
 
@@ -54,6 +55,7 @@
 #include "common/nmv-address.h"
 #include "common/nmv-loc.h"
 #include "common/nmv-proc-utils.h"
+#include "common/nmv-disassembly-cache.h"
 #include "nmv-sess-mgr.h"
 #include "nmv-dbg-perspective.h"
 #include "nmv-source-editor.h"
@@ -82,6 +84,9 @@
 #include "nmv-choose-overloads-dialog.h"
 #include "nmv-remote-target-dialog.h"
 #include "nmv-registers-view.h"
+#include "nmv-perf-view.h"
+#include "nmv-stop-history-view.h"
+#include "nmv-libraries-view.h"
 #include "nmv-call-function-dialog.h"
 #include "nmv-conf-keys.h"
 #ifdef WITH_MEMORYVIEW
@@ -121,6 +126,9 @@ const char *BREAKPOINTS_VIEW_TITLE       = _("Breakpoints");
 const char *REGISTERS_VIEW_TITLE         = _("Registers");
 const char *MEMORY_VIEW_TITLE            = _("Memory");
 const char *EXPR_MONITOR_VIEW_TITLE      = _("Expression Monitor");
+const char *PERF_VIEW_TITLE              = _("Debugger Performance");
+const char *STOP_HISTORY_VIEW_TITLE      = _("Stop History");
+const char *LIBRARIES_VIEW_TITLE         = _("Libraries");
 
 const char *CAPTION_SESSION_NAME = "captionname";
 const char *SESSION_NAME = "sessionname";
@@ -137,6 +145,8 @@ const char *DISASSEMBLY_TITLE = "<Disassembly>";
 
 static const int NUM_INSTR_TO_DISASSEMBLE = 20;
 
+static const int MAX_RESIDENT_SOURCE_BUFFERS = 32;
+
 const char *DBG_PERSPECTIVE_DEFAULT_LAYOUT = "default-layout";
 
 const Gtk::StockID STOCK_SET_BREAKPOINT (SET_BREAKPOINT);
@@ -263,6 +273,8 @@ private:
     void on_copy_action ();
     void on_stop_debugger_action ();
     void on_run_action ();
+    void on_set_checkpoint_action ();
+    void on_restart_from_checkpoint_action ();
     void on_save_session_action ();
     void on_next_action ();
     void on_step_into_action ();
@@ -340,6 +352,20 @@ private:
 
     void on_debugger_inferior_re_run_signal ();
 
+    void on_debugger_checkpoint_set_signal (int a_checkpoint_id,
+                                            const UString &a_cookie);
+
+    void on_debugger_libraries_changed_signal ();
+
+    void on_debugger_target_output_message_signal (const UString &a_output);
+
+    void on_debugger_memory_set_signal (size_t a_address,
+                                        const std::vector<uint8_t> &a_values,
+                                        const UString &a_cookie);
+
+    void on_debugger_variables_revisualization_progress_signal (int a_done,
+                                                                int a_total);
+
     void on_debugger_detached_from_target_signal ();
 
     void on_debugger_got_target_info_signal (int a_pid,
@@ -384,8 +410,15 @@ private:
 
     void on_debugger_error_signal (const UString &a_msg);
 
+    void on_debugger_command_error_signal (const UString &a_command_name,
+                                           const UString &a_cookie,
+                                           const UString &a_msg);
+
     void on_debugger_state_changed_signal (IDebugger::State a_state);
 
+    void on_debugger_thread_state_changed_signal (int a_thread_id,
+                                                  bool a_is_running);
+
     void on_debugger_variable_value_signal
                                     (const UString &a_var_name,
                                      const IDebugger::VariableSafePtr &a_var,
@@ -412,8 +445,22 @@ private:
                              const std::list<common::Asm> &instrs,
                              const Address &address);
 
+    void on_debugger_asm_signal_to_cache
+                            (const common::DisassembleInfo &a_info,
+                             const std::list<common::Asm> &a_instrs,
+                             Range a_range,
+                             bool a_pure_asm,
+                             IDebugger::DisassSlot a_what_to_do);
+
+    bool on_cached_asm_idle (common::DisassembleInfo a_info,
+                             std::list<common::Asm> a_instrs,
+                             IDebugger::DisassSlot a_what_to_do);
+
     void on_variable_created_for_tooltip_signal
-                                    (const IDebugger::VariableSafePtr);
+                                    (const IDebugger::VariableSafePtr,
+                                     int a_frame_level,
+                                     int a_thread_id,
+                                     unsigned a_generation);
     void on_popup_tip_hide ();
 
     bool on_file_content_changed (const UString &a_path);
@@ -428,6 +475,9 @@ private:
     void on_activate_memory_view ();
 #endif // WITH_MEMORYVIEW
     void on_activate_expr_monitor_view ();
+    void on_activate_perf_view ();
+    void on_activate_stop_history_view ();
+    void on_activate_libraries_view ();
     void on_activate_global_variables ();
     void on_default_config_read ();
 
@@ -436,6 +486,8 @@ private:
     //************
 
     void update_action_group_sensitivity (IDebugger::State a_state);
+
+    IDebugger::State state_of_current_thread (IDebugger::State a_state);
     void update_copy_action_sensitivity ();
     string build_resource_path (const UString &a_dir, const UString &a_name);
     void add_stock_icon (const UString &a_stock_id,
@@ -475,8 +527,11 @@ private:
     void bring_source_as_current (SourceEditor *a_editor);
     void record_and_save_new_session ();
     void record_and_save_session (ISessMgr::Session &a_session);
+    void prewarm_last_session ();
     IProcMgr* get_process_manager ();
     void try_to_request_show_variable_value_at_position (int a_x, int a_y);
+    void request_variable_for_tooltip (const UString &a_expr);
+    void invalidate_tooltip_variables_cache ();
     void show_underline_tip_at_position (int a_x, int a_y,
                                          const UString &a_text);
     void show_underline_tip_at_position (int a_x, int a_y,
@@ -564,6 +619,18 @@ public:
     bool reload_file (const UString &a_file);
     bool reload_file ();
 
+    bool open_file_lazily (const UString &a_path);
+
+    bool touch_source_buffer (SourceEditor *a_editor);
+
+    void release_source_buffer (SourceEditor *a_editor);
+
+    void release_source_buffers_over_budget ();
+
+    bool is_source_buffer_released (const UString &a_path) const;
+
+    void forget_source_buffer (const UString &a_path);
+
     ISessMgr& session_manager ();
 
     void execute_session (ISessMgr::Session &a_session);
@@ -698,6 +765,8 @@ public:
                              bool a_tight = false);
     void disassemble_around_address_and_do (const Address &adress,
                                             IDebugger::DisassSlot &what_to_do);
+    void disassemble_range_and_do (const Range &a_range,
+                                   IDebugger::DisassSlot &a_what_to_do);
 
     void inspect_expression ();
     void inspect_expression (const UString &a_variable_name);
@@ -779,6 +848,12 @@ public:
 
     ExprMonitor& get_expr_monitor_view ();
 
+    PerfView& get_perf_view ();
+
+    StopHistoryView& get_stop_history_view ();
+
+    LibrariesView& get_libraries_view ();
+
     ThreadList& get_thread_list ();
 
     bool set_where (const IDebugger::Frame &a_frame,
@@ -865,6 +940,40 @@ void gio_file_monitor_cb (const Glib::RefPtr<Gio::File>& file,
                           Gio::FileMonitorEvent event,
                           DBGPerspective *a_persp);
 
+/// The key of the cache of variables shown in the source popup
+/// tips.  The same expression can denote different variables in
+/// different frames or threads.
+struct HoverKey {
+    UString expression;
+    int frame_level;
+    int thread_id;
+
+    HoverKey () :
+        frame_level (0),
+        thread_id (0)
+    {
+    }
+
+    HoverKey (const UString &a_expr,
+              int a_frame_level,
+              int a_thread_id) :
+        expression (a_expr),
+        frame_level (a_frame_level),
+        thread_id (a_thread_id)
+    {
+    }
+
+    bool
+    operator< (const HoverKey &a_other) const
+    {
+        if (thread_id != a_other.thread_id)
+            return thread_id < a_other.thread_id;
+        if (frame_level != a_other.frame_level)
+            return frame_level < a_other.frame_level;
+        return expression.raw () < a_other.expression.raw ();
+    }
+};// end struct HoverKey
+
 struct DBGPerspective::Priv {
     bool initialized;
     bool reused_session;
@@ -872,6 +981,9 @@ struct DBGPerspective::Priv {
     // A Flag to know if the debugging
     // engine died or not.
     bool debugger_engine_alive;
+    // The id of the last checkpoint set in the inferior, or -1 if
+    // there is none.
+    int last_checkpoint_id;
     // The path to the program the user requested a debugging session
     // for.
     UString last_prog_path_requested;
@@ -937,6 +1049,9 @@ struct DBGPerspective::Priv {
     SafePtr<MemoryView> memory_view;
 #endif // WITH_MEMORYVIEW
     SafePtr<ExprMonitor> expr_monitor;
+    SafePtr<PerfView> perf_view;
+    SafePtr<StopHistoryView> stop_history_view;
+    SafePtr<LibrariesView> libraries_view;
 
     int current_page_num;
     IDebuggerSafePtr debugger;
@@ -956,7 +1071,20 @@ struct DBGPerspective::Priv {
     UString system_font_name;
     bool use_launch_terminal;
     int num_instr_to_disassemble;
+    // The maximum number of source editors that keep the content of
+    // their file in memory.  0 means there is no limit.
+    int max_resident_source_buffers;
+    // The paths of the source editors that have the content of
+    // their file in memory, the most recently used first.
+    std::list<UString> resident_source_paths;
+    // The paths of the source editors whose buffers were released.
+    // The content of their file is loaded again when their tab gets
+    // activated.
+    std::set<UString> released_source_paths;
     bool asm_style_pure;
+    // The instructions disassembled so far from the inferior.  It
+    // is cleared when the code of the inferior might have changed.
+    common::DisassemblyCache disassembly_cache;
     bool enable_pretty_printing;
     bool pretty_printing_toggled;
     Glib::RefPtr<Gsv::StyleScheme> editor_style;
@@ -979,6 +1107,26 @@ struct DBGPerspective::Priv {
     UString var_to_popup;
     int var_popup_tip_x;
     int var_popup_tip_y;
+    // The variables created to show the value of the word under the
+    // mouse pointer are memoized here, keyed by (expression, frame
+    // level, thread id), so that hovering the same word again during
+    // the same stop doesn't send a new request to the debugger.
+    // The cache is flushed when the inferior stops again or when the
+    // user selects another frame or thread.
+    typedef map<HoverKey, IDebugger::VariableSafePtr> HoverCache;
+    HoverCache hover_cache;
+    // Incremented each time hover_cache is flushed.  Replies
+    // for requests sent before a flush are then not memoized.
+    unsigned hover_cache_generation;
+    // The expression for which a request is currently in flight.
+    // Only one hover request is in flight at any time; words hovered
+    // in the mean time are dropped, except the last one that is
+    // requested when the in-flight request returns.
+    UString hover_expr_in_flight;
+    // The cookie of the in-flight hover request, so that a failure
+    // of that request can be told apart from other errors.
+    UString hover_cookie_in_flight;
+    unsigned num_hover_requests;
     //****************************************
     //</variable value popup tip related data>
     //****************************************
@@ -998,6 +1146,7 @@ struct DBGPerspective::Priv {
         reused_session (false),
         debugger_has_just_run (false),
         debugger_engine_alive (false),
+        last_checkpoint_id (-1),
         menubar_merge_id (0),
         toolbar_merge_id (0),
         contextual_menu_merge_id(0),
@@ -1013,6 +1162,7 @@ struct DBGPerspective::Priv {
         enable_syntax_highlight (true),
         use_launch_terminal (false),
         num_instr_to_disassemble (NUM_INSTR_TO_DISASSEMBLE),
+        max_resident_source_buffers (MAX_RESIDENT_SOURCE_BUFFERS),
         asm_style_pure (true),
         enable_pretty_printing (true),
         pretty_printing_toggled (false),
@@ -1021,6 +1171,8 @@ struct DBGPerspective::Priv {
         in_show_var_value_at_pos_transaction (false),
         var_popup_tip_x (0),
         var_popup_tip_y (0),
+        hover_cache_generation (0),
+        num_hover_requests (0),
         source_view_event_button (0)
     {
     }
@@ -1388,6 +1540,35 @@ DBGPerspective::on_run_action ()
     NEMIVER_CATCH
 }
 
+void
+DBGPerspective::on_set_checkpoint_action ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+    NEMIVER_TRY
+
+    debugger ()->set_checkpoint ("set-checkpoint");
+
+    NEMIVER_CATCH
+}
+
+void
+DBGPerspective::on_restart_from_checkpoint_action ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+    NEMIVER_TRY
+
+    if (m_priv->last_checkpoint_id < 0) {
+        ui_utils::display_info (_("No checkpoint has been set"));
+        return;
+    }
+    // The engine sets a new checkpoint in place of the one the
+    // restart uses up.
+    debugger ()->restart_from_checkpoint (m_priv->last_checkpoint_id,
+                                          "restart-from-checkpoint");
+
+    NEMIVER_CATCH
+}
+
 void
 DBGPerspective::on_save_session_action ()
 {
@@ -1817,7 +1998,19 @@ DBGPerspective::on_thread_list_thread_selected_signal (int a_tid)
     if (m_priv->current_thread_id == a_tid)
         return;
 
+    invalidate_tooltip_variables_cache ();
     m_priv->current_thread_id = a_tid;
+
+    if (debugger ()->is_non_stop_mode ()) {
+        update_action_group_sensitivity
+            (state_of_current_thread (debugger ()->get_state ()));
+        // A running thread has no local variables to show.
+        if (debugger ()->is_thread_running (a_tid)) {
+            get_local_vars_inspector ().re_init_widget ();
+            return;
+        }
+    }
+
     get_local_vars_inspector ().show_local_variables_of_current_function
         (m_priv->current_frame);
 
@@ -1835,6 +2028,7 @@ DBGPerspective::on_switch_page_signal (Gtk::Widget *a_page,
     NEMIVER_TRY
     m_priv->current_page_num = a_page_num;
     LOG_DD ("current_page_num: " << m_priv->current_page_num);
+    touch_source_buffer (dynamic_cast<SourceEditor*> (a_page));
     NEMIVER_CATCH
 }
 
@@ -2268,10 +2462,20 @@ DBGPerspective::on_conf_key_changed_signal (const UString &a_key,
         conf_mgr.get_key_value (a_key, val, a_namespace);
         if (val != 0)
             m_priv->num_instr_to_disassemble = val;
+    } else if (a_key == CONF_KEY_MAX_RESIDENT_SOURCE_BUFFERS) {
+        int val = 0;
+        conf_mgr.get_key_value (a_key, val, a_namespace);
+        m_priv->max_resident_source_buffers = std::max (val, 0);
+        release_source_buffers_over_budget ();
     } else if (a_key == CONF_KEY_ASM_STYLE_PURE) {
         conf_mgr.get_key_value (a_key,
                                 m_priv->asm_style_pure,
                                 a_namespace);
+    } else if (a_key == CONF_KEY_DISASSEMBLY_FLAVOR) {
+        // The debugger engine switches GDB to the new flavor; what
+        // was disassembled in the former one must not be shown
+        // anymore.
+        m_priv->disassembly_cache.clear ();
     } else if (a_key == CONF_KEY_PRETTY_PRINTING) {
         bool e = false;
         conf_mgr.get_key_value (a_key, e, a_namespace);
@@ -2325,6 +2529,105 @@ DBGPerspective::on_debugger_inferior_re_run_signal ()
     NEMIVER_TRY;
 
     m_priv->debugger_has_just_run = true;
+    m_priv->disassembly_cache.clear ();
+    // Re-running the inferior killed the checkpoints of the
+    // previous run.
+    m_priv->last_checkpoint_id = -1;
+
+    NEMIVER_CATCH;
+}
+
+/// Callback invoked when a checkpoint was set in the inferior.
+/// Remember it, so that the inferior can be restarted from there.
+/// Only the checkpoints the user set are announced; the ones the
+/// engine sets in place of those used up, by a restart or by the
+/// exit of the program, are remembered silently.
+void
+DBGPerspective::on_debugger_checkpoint_set_signal (int a_checkpoint_id,
+                                                   const UString &a_cookie)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    m_priv->last_checkpoint_id = a_checkpoint_id;
+    if (a_cookie != "set-checkpoint")
+        return;
+    UString message;
+    message.printf (_("Checkpoint %d set"), a_checkpoint_id);
+    ui_utils::display_info (message);
+
+    NEMIVER_CATCH;
+}
+
+/// Callback invoked when the inferior loaded or unloaded shared
+/// libraries.  The code that was disassembled might not be there
+/// anymore.
+void
+DBGPerspective::on_debugger_libraries_changed_signal ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    m_priv->disassembly_cache.clear ();
+
+    NEMIVER_CATCH;
+}
+
+/// Callback invoked when gdb relayed some output of the inferior,
+/// e.g, when debugging a remote target.  Show it in the terminal,
+/// along with the output the inferior writes there directly.
+void
+DBGPerspective::on_debugger_target_output_message_signal
+                                            (const UString &a_output)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    get_terminal ().feed (a_output);
+
+    NEMIVER_CATCH;
+}
+
+/// Callback invoked when the memory of the inferior was written to.
+/// Forget about the instructions that were disassembled from there.
+void
+DBGPerspective::on_debugger_memory_set_signal
+                            (size_t a_address,
+                             const std::vector<uint8_t> &a_values,
+                             const UString &/*a_cookie*/)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    m_priv->disassembly_cache.invalidate (a_address,
+                                          a_address + a_values.size ());
+
+    NEMIVER_CATCH;
+}
+
+/// Show the progress of the revisualization of variables, e.g. after
+/// pretty printing got toggled, in the tooltip of the throbber.
+void
+DBGPerspective::on_debugger_variables_revisualization_progress_signal
+                                                            (int a_done,
+                                                             int a_total)
+{
+    NEMIVER_TRY;
+
+    THROW_IF_FAIL (m_priv->throbber);
+
+    if (a_done >= a_total) {
+        m_priv->throbber->set_has_tooltip (false);
+        return;
+    }
+    UString msg;
+    msg.printf (_("Updating the display of the variables: %d of %d"),
+                a_done, a_total);
+    m_priv->throbber->set_tooltip_text (msg);
 
     NEMIVER_CATCH;
 }
@@ -2491,9 +2794,13 @@ DBGPerspective::on_debugger_stopped_signal (IDebugger::StopReason a_reason,
         return;
 
     update_src_dependant_bp_actions_sensitiveness ();
+    invalidate_tooltip_variables_cache ();
     m_priv->current_frame = a_frame;
     m_priv->current_thread_id = a_thread_id;
 
+    if (m_priv->terminal)
+        m_priv->terminal->mark_output_stop ();
+
     set_where (a_frame, /*do_scroll=*/true, /*try_hard=*/true);
 
     if (m_priv->debugger_has_just_run) {
@@ -2511,6 +2818,10 @@ DBGPerspective::on_program_finished_signal ()
     NEMIVER_TRY
 
     unset_where ();
+    invalidate_tooltip_variables_cache ();
+    // Had a checkpoint been kept, the program would have gone back
+    // to it rather than finishing.
+    m_priv->last_checkpoint_id = -1;
 
     display_info (_("Program exited"));
     workbench ().set_title_extension ("");
@@ -2566,6 +2877,7 @@ DBGPerspective::on_frame_selected_signal (int /* a_index */,
         return;
     }
 
+    invalidate_tooltip_variables_cache ();
     m_priv->current_frame = a_frame;
 
     get_local_vars_inspector ().show_local_variables_of_current_function
@@ -2667,6 +2979,32 @@ DBGPerspective::on_debugger_error_signal (const UString &a_msg)
     NEMIVER_CATCH
 }
 
+void
+DBGPerspective::on_debugger_command_error_signal (const UString &,
+                                                  const UString &a_cookie,
+                                                  const UString &)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+    NEMIVER_TRY
+
+    // A word hovered in the source view that is not a variable
+    // makes the request sent by request_variable_for_tooltip fail.
+    // Do not let that block the subsequent hover requests.
+    if (m_priv->hover_cookie_in_flight.empty ()
+        || a_cookie != m_priv->hover_cookie_in_flight)
+        return;
+
+    UString failed_expr = m_priv->hover_expr_in_flight;
+    m_priv->hover_expr_in_flight.clear ();
+    m_priv->hover_cookie_in_flight.clear ();
+    if (m_priv->in_show_var_value_at_pos_transaction
+        && !m_priv->var_to_popup.empty ()
+        && m_priv->var_to_popup != failed_expr)
+        request_variable_for_tooltip (m_priv->var_to_popup);
+
+    NEMIVER_CATCH
+}
+
 void
 DBGPerspective::on_debugger_state_changed_signal (IDebugger::State a_state)
 {
@@ -2674,7 +3012,29 @@ DBGPerspective::on_debugger_state_changed_signal (IDebugger::State a_state)
 
     NEMIVER_TRY;
 
-    update_action_group_sensitivity (a_state);
+    update_action_group_sensitivity (state_of_current_thread (a_state));
+
+    NEMIVER_CATCH
+}
+
+/// Called when a thread of the inferior starts or stops running.  In
+/// non-stop mode, the actions that apply to the current thread are
+/// updated accordingly.
+void
+DBGPerspective::on_debugger_thread_state_changed_signal (int a_thread_id,
+                                                         bool)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    if (!debugger ()->is_non_stop_mode ())
+        return;
+    if (a_thread_id != -1
+        && a_thread_id != (int) debugger ()->get_current_thread ())
+        return;
+    update_action_group_sensitivity
+        (state_of_current_thread (debugger ()->get_state ()));
 
     NEMIVER_CATCH
 }
@@ -2778,19 +3138,92 @@ DBGPerspective::on_debugger_asm_signal4
     NEMIVER_CATCH
 }
 
+/// Callback invoked when a range of addresses requested by
+/// disassemble_range_and_do has been disassembled by the debugger.
+/// Add the result to the disassembly cache and pass it on.
+void
+DBGPerspective::on_debugger_asm_signal_to_cache
+                        (const common::DisassembleInfo &a_info,
+                         const std::list<common::Asm> &a_instrs,
+                         Range a_range,
+                         bool a_pure_asm,
+                         IDebugger::DisassSlot a_what_to_do)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY
+
+    m_priv->disassembly_cache.add (a_range.min (), a_range.max (),
+                                   a_instrs, a_pure_asm);
+    a_what_to_do (a_info, a_instrs);
+
+    NEMIVER_CATCH
+}
+
+/// Idle callback that passes instructions served by the disassembly
+/// cache on to the slot that asked for them.
+bool
+DBGPerspective::on_cached_asm_idle (common::DisassembleInfo a_info,
+                                    std::list<common::Asm> a_instrs,
+                                    IDebugger::DisassSlot a_what_to_do)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY
+
+    a_what_to_do (a_info, a_instrs);
+
+    NEMIVER_CATCH
+
+    // Run only once.
+    return false;
+}
+
+/// Callback invoked when the variable requested by
+/// request_variable_for_tooltip has been created.
+///
+/// \param a_var the newly created variable.
+///
+/// \param a_frame_level the level of the frame the variable was
+/// requested in.
+///
+/// \param a_thread_id the id of the thread the variable was requested
+/// in.
+///
+/// \param a_generation the generation of the tooltip variables cache
+/// at the time of the request.
 void
 DBGPerspective::on_variable_created_for_tooltip_signal
-                                (const IDebugger::VariableSafePtr a_var)
+                                (const IDebugger::VariableSafePtr a_var,
+                                 int a_frame_level,
+                                 int a_thread_id,
+                                 unsigned a_generation)
 {
     NEMIVER_TRY
 
-    if (m_priv->in_show_var_value_at_pos_transaction
-        && m_priv->var_to_popup == a_var->name ()) {
+    m_priv->hover_expr_in_flight.clear ();
+    m_priv->hover_cookie_in_flight.clear ();
+
+    // Only memoize the variable if the inferior hasn't been resumed
+    // and no other frame got selected since the request was sent.
+    if (a_generation == m_priv->hover_cache_generation)
+        m_priv->hover_cache[HoverKey (a_var->name (),
+                                      a_frame_level,
+                                      a_thread_id)] = a_var;
+
+    if (!m_priv->in_show_var_value_at_pos_transaction)
+        return;
+
+    if (m_priv->var_to_popup == a_var->name ()) {
         show_underline_tip_at_position (m_priv->var_popup_tip_x,
                                         m_priv->var_popup_tip_y,
                                         a_var);
         m_priv->in_show_var_value_at_pos_transaction = false;
         m_priv->var_to_popup = "";
+    } else if (!m_priv->var_to_popup.empty ()) {
+        // The mouse moved to another word while this request was in
+        // flight.  Now is the time to request the last word hovered.
+        request_variable_for_tooltip (m_priv->var_to_popup);
     }
 
     NEMIVER_CATCH
@@ -2964,6 +3397,45 @@ DBGPerspective::on_activate_expr_monitor_view ()
     NEMIVER_CATCH;
 }
 
+void
+DBGPerspective::on_activate_perf_view ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    THROW_IF_FAIL (m_priv);
+    m_priv->layout ().activate_view (PERF_VIEW_INDEX);
+
+    NEMIVER_CATCH;
+}
+
+void
+DBGPerspective::on_activate_stop_history_view ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    THROW_IF_FAIL (m_priv);
+    m_priv->layout ().activate_view (STOP_HISTORY_VIEW_INDEX);
+
+    NEMIVER_CATCH;
+}
+
+void
+DBGPerspective::on_activate_libraries_view ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY;
+
+    THROW_IF_FAIL (m_priv);
+    m_priv->layout ().activate_view (LIBRARIES_VIEW_INDEX);
+
+    NEMIVER_CATCH;
+}
+
 void
 DBGPerspective::on_activate_global_variables ()
 {
@@ -3004,6 +3476,24 @@ DBGPerspective::on_default_config_read ()
 //<private methods>
 //*******************
 
+/// In non-stop mode, GDB is ready to accept commands while some
+/// threads run, but the stepping actions apply to the current thread
+/// only.  So while the current thread runs, the actions should be
+/// those of a running debugger.
+///
+/// \param a_state the state of the debugger.
+///
+/// \return the state the actions should reflect.
+IDebugger::State
+DBGPerspective::state_of_current_thread (IDebugger::State a_state)
+{
+    if (a_state == IDebugger::READY
+        && debugger ()->is_non_stop_mode ()
+        && debugger ()->is_thread_running (debugger ()->get_current_thread ()))
+        return IDebugger::RUNNING;
+    return a_state;
+}
+
 /// Given a debugger state, update the sensitivity of the various menu
 /// actions of the graphical debugger.
 ///
@@ -3218,6 +3708,18 @@ DBGPerspective::init_actions ()
             "<shift>F5",
             true
         },
+        {
+            "RestartFromCheckpointMenuItemAction",
+            nil_stock_id,
+            _("Restart from Checkpoint"),
+            _("Restart the target from the last checkpoint"),
+            sigc::mem_fun
+                (*this,
+                 &DBGPerspective::on_restart_from_checkpoint_action),
+            ActionEntry::DEFAULT,
+            "",
+            false
+        },
         {
             "SetBreakpointUsingDialogMenuItemAction",
             nil_stock_id,
@@ -3313,6 +3815,16 @@ DBGPerspective::init_actions ()
 
 
     static ui_utils::ActionEntry s_debugger_ready_action_entries [] = {
+        {
+            "SetCheckpointMenuItemAction",
+            nil_stock_id,
+            _("Set _Checkpoint"),
+            _("Save the state of the target, to restart from it later"),
+            sigc::mem_fun (*this, &DBGPerspective::on_set_checkpoint_action),
+            ActionEntry::DEFAULT,
+            "",
+            false
+        },
         {
             "NextMenuItemAction",
             nemiver::STOCK_STEP_OVER,
@@ -3590,6 +4102,38 @@ DBGPerspective::init_actions ()
             "<alt>6",
             false
         },
+        {
+            "ActivatePerfViewMenuAction",
+            nil_stock_id,
+            PERF_VIEW_TITLE,
+            _("Switch to Debugger Performance View"),
+            sigc::mem_fun (*this, &DBGPerspective::on_activate_perf_view),
+            ActionEntry::DEFAULT,
+            "<alt>7",
+            false
+        },
+        {
+            "ActivateStopHistoryViewMenuAction",
+            nil_stock_id,
+            STOP_HISTORY_VIEW_TITLE,
+            _("Switch to Stop History View"),
+            sigc::mem_fun (*this,
+                           &DBGPerspective::on_activate_stop_history_view),
+            ActionEntry::DEFAULT,
+            "<alt>8",
+            false
+        },
+        {
+            "ActivateLibrariesViewMenuAction",
+            nil_stock_id,
+            LIBRARIES_VIEW_TITLE,
+            _("Switch to Libraries View"),
+            sigc::mem_fun (*this,
+                           &DBGPerspective::on_activate_libraries_view),
+            ActionEntry::DEFAULT,
+            "<alt>9",
+            false
+        },
         {
             "DebugMenuAction",
             nil_stock_id,
@@ -3946,19 +4490,45 @@ DBGPerspective::init_debugger_signals ()
     debugger ()->error_signal ().connect (sigc::mem_fun
             (*this, &DBGPerspective::on_debugger_error_signal));
 
+    debugger ()->command_error_signal ().connect (sigc::mem_fun
+            (*this, &DBGPerspective::on_debugger_command_error_signal));
+
     debugger ()->state_changed_signal ().connect (sigc::mem_fun
             (*this, &DBGPerspective::on_debugger_state_changed_signal));
 
+    debugger ()->thread_state_changed_signal ().connect (sigc::mem_fun
+            (*this, &DBGPerspective::on_debugger_thread_state_changed_signal));
+
     debugger ()->variable_value_signal ().connect (sigc::mem_fun
             (*this, &DBGPerspective::on_debugger_variable_value_signal));
 
     debugger ()->got_target_info_signal ().connect (sigc::mem_fun
             (*this, &DBGPerspective::on_debugger_got_target_info_signal));
+
+    debugger ()->checkpoint_set_signal ().connect (sigc::mem_fun
+            (*this, &DBGPerspective::on_debugger_checkpoint_set_signal));
+
+    debugger ()->libraries_changed_signal ().connect (sigc::mem_fun
+            (*this, &DBGPerspective::on_debugger_libraries_changed_signal));
+
+    debugger ()->target_output_message_signal ().connect (sigc::mem_fun
+            (*this,
+             &DBGPerspective::on_debugger_target_output_message_signal));
+
+    debugger ()->set_memory_signal ().connect (sigc::mem_fun
+            (*this, &DBGPerspective::on_debugger_memory_set_signal));
+
+    debugger ()->variables_revisualization_progress_signal ().connect
+        (sigc::mem_fun
+            (*this,
+             &DBGPerspective::
+                on_debugger_variables_revisualization_progress_signal));
 }
 
 void
 DBGPerspective::clear_status_notebook (bool a_restarting)
 {
+    m_priv->disassembly_cache.clear ();
     get_thread_list ().clear ();
     get_call_stack ().clear ();
     get_local_vars_inspector ().re_init_widget ();
@@ -4884,6 +5454,10 @@ DBGPerspective::read_default_config ()
     // setup.
     if (m_priv->num_instr_to_disassemble == 0)
         m_priv->num_instr_to_disassemble = NUM_INSTR_TO_DISASSEMBLE;
+    if (conf_mgr.get_key_value (CONF_KEY_MAX_RESIDENT_SOURCE_BUFFERS,
+                                m_priv->max_resident_source_buffers)
+        && m_priv->max_resident_source_buffers < 0)
+        m_priv->max_resident_source_buffers = MAX_RESIDENT_SOURCE_BUFFERS;
     conf_mgr.get_key_value (CONF_KEY_ASM_STYLE_PURE,
                             m_priv->asm_style_pure);
     conf_mgr.get_key_value (CONF_KEY_PRETTY_PRINTING,
@@ -4963,14 +5537,68 @@ DBGPerspective::try_to_request_show_variable_value_at_position (int a_x,
     int abs_x=0, abs_y=0;
     if (!source_view_to_root_window_coordinates (a_x, a_y, abs_x, abs_y))
         return;
-    m_priv->in_show_var_value_at_pos_transaction = true;
     m_priv->var_popup_tip_x = abs_x;
     m_priv->var_popup_tip_y = abs_y;
+
+    Priv::HoverCache::const_iterator it =
+        m_priv->hover_cache.find (HoverKey (var_name,
+                                            m_priv->current_frame.level (),
+                                            m_priv->current_thread_id));
+    if (it != m_priv->hover_cache.end ()) {
+        LOG_DD ("hover cache hit for: " << var_name);
+        m_priv->in_show_var_value_at_pos_transaction = false;
+        m_priv->var_to_popup = "";
+        show_underline_tip_at_position (abs_x, abs_y, it->second);
+        return;
+    }
+
+    m_priv->in_show_var_value_at_pos_transaction = true;
     m_priv->var_to_popup = var_name;
+
+    // If a request is already in flight, just remember the word.  It
+    // is going to be requested when the pending request returns.
+    if (!m_priv->hover_expr_in_flight.empty ())
+        return;
+    request_variable_for_tooltip (var_name);
+}
+
+/// Ask the debugger to create a variable for the expression a_expr,
+/// so that its value can be shown in the source popup tip.  The
+/// resulting variable is memoized in the tooltip variables cache.
+///
+/// \param a_expr the expression to create the variable for.
+void
+DBGPerspective::request_variable_for_tooltip (const UString &a_expr)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD
+
+    m_priv->hover_expr_in_flight = a_expr;
+    m_priv->hover_cookie_in_flight =
+        "hover-tip-" + UString::from_int (++m_priv->num_hover_requests);
     debugger ()->create_variable
-        (var_name,
-         sigc::mem_fun (*this,
-                        &DBGPerspective::on_variable_created_for_tooltip_signal));
+        (a_expr,
+         sigc::bind
+         (sigc::mem_fun
+          (*this,
+           &DBGPerspective::on_variable_created_for_tooltip_signal),
+          m_priv->current_frame.level (),
+          m_priv->current_thread_id,
+          m_priv->hover_cache_generation),
+         m_priv->hover_cookie_in_flight);
+}
+
+/// Flush the cache of variables created to be shown in the source
+/// popup tips.  This must be called whenever the values of these
+/// variables might have changed, e.g, when the inferior stops again,
+/// or when the frame they were evaluated in is not the current one
+/// anymore.
+void
+DBGPerspective::invalidate_tooltip_variables_cache ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD
+
+    m_priv->hover_cache.clear ();
+    ++m_priv->hover_cache_generation;
 }
 
 /// Popup a tip at a given position, showing some text content.
@@ -5144,6 +5772,15 @@ DBGPerspective::add_views_to_layout ()
     m_priv->layout ().append_view (get_expr_monitor_view ().widget (),
                                    EXPR_MONITOR_VIEW_TITLE,
                                    EXPR_MONITOR_VIEW_INDEX);
+    m_priv->layout ().append_view (get_perf_view ().widget (),
+                                   PERF_VIEW_TITLE,
+                                   PERF_VIEW_INDEX);
+    m_priv->layout ().append_view (get_stop_history_view ().widget (),
+                                   STOP_HISTORY_VIEW_TITLE,
+                                   STOP_HISTORY_VIEW_INDEX);
+    m_priv->layout ().append_view (get_libraries_view ().widget (),
+                                   LIBRARIES_VIEW_TITLE,
+                                   LIBRARIES_VIEW_INDEX);
     m_priv->layout ().do_init ();
 
 }
@@ -5280,6 +5917,40 @@ DBGPerspective::record_and_save_session (ISessMgr::Session &a_session)
 }
 
 
+/// Have the debugging engine start a GDB on the program of the most
+/// recent local session, in the background, as that session is
+/// the one most likely to be resumed.  This is a no-op unless the
+/// gdb-process-pool setting is on.
+void
+DBGPerspective::prewarm_last_session ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    NEMIVER_TRY
+
+    const std::list<ISessMgr::Session> &sessions =
+        session_manager ().sessions ();
+    // Sessions are ordered from the oldest to the most recent.
+    std::list<ISessMgr::Session>::const_reverse_iterator it;
+    for (it = sessions.rbegin (); it != sessions.rend (); ++it) {
+        map<UString, UString>::const_iterator prop,
+            nil = it->properties ().end ();
+        if ((prop = it->properties ().find (REMOTE_TARGET)) != nil
+            && !prop->second.empty ())
+            continue;
+        if ((prop = it->properties ().find (PROGRAM_NAME)) == nil
+            || prop->second.empty ())
+            continue;
+        UString prog = prop->second, cwd;
+        if ((prop = it->properties ().find (PROGRAM_CWD)) != nil)
+            cwd = prop->second;
+        debugger ()->prewarm_program (prog, cwd);
+        break;
+    }
+
+    NEMIVER_CATCH_NOX
+}
+
 //*******************
 //</private methods>
 //*******************
@@ -5305,6 +5976,7 @@ DBGPerspective::do_init (IWorkbench *a_workbench)
     read_default_config ();
     session_manager ().load_sessions
                         (session_manager ().default_transaction ());
+    prewarm_last_session ();
     workbench ().shutting_down_signal ().connect (sigc::mem_fun
             (*this, &DBGPerspective::on_shutdown_signal));
     m_priv->initialized = true;
@@ -5504,6 +6176,7 @@ DBGPerspective::open_file_real (const UString &a_path,
 
     THROW_IF_FAIL (source_editor);
     append_source_editor (*source_editor, a_path);
+    touch_source_buffer (source_editor);
 
     NEMIVER_CATCH_AND_RETURN (0)
     return source_editor;
@@ -5569,6 +6242,7 @@ DBGPerspective::close_file (const UString &a_path)
     if (!do_unmonitor_file (a_path)) {
         LOG_ERROR ("failed to unmonitor file " << a_path);
     }
+    forget_source_buffer (a_path);
 
     if (!get_num_notebook_pages ()) {
         m_priv->opened_file_action_group->set_sensitive (false);
@@ -5846,6 +6520,11 @@ DBGPerspective::reload_file (const UString &a_path)
     if (!editor)
         return open_file (a_path);
 
+    // The content of a released buffer is read from disk anyway when
+    // it becomes resident again.
+    if (is_source_buffer_released (a_path))
+        return true;
+
     Glib::RefPtr<Gsv::Buffer> buffer =
         editor->source_view ().get_source_buffer ();
     int current_line = editor->current_line ();
@@ -5877,6 +6556,168 @@ DBGPerspective::reload_file ()
     return true;
 }
 
+/// Open a file in a new tab without loading its content.  The
+/// content is loaded when the tab gets activated.  If the file cannot
+/// be found as is, it's opened the usual way, so that it can be
+/// looked for in the search paths.
+///
+/// \param a_path the path of the file to open.
+///
+/// \return true upon successful completion, false otherwise.
+bool
+DBGPerspective::open_file_lazily (const UString &a_path)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (a_path.empty ())
+        return false;
+
+    if (get_source_editor_from_path (a_path))
+        return true;
+
+    if (!Glib::file_test (Glib::filename_from_utf8 (a_path),
+                          Glib::FILE_TEST_IS_REGULAR))
+        return open_file (a_path);
+
+    NEMIVER_TRY
+
+    Glib::RefPtr<Gsv::Buffer> source_buffer =
+        SourceEditor::create_source_buffer ();
+    SourceEditor *source_editor =
+        create_source_editor (source_buffer,
+                              /*a_asm_view=*/false,
+                              a_path,
+                              /*a_current_line=*/-1,
+                              /*a_current_address=*/"");
+    THROW_IF_FAIL (source_editor);
+
+    // If this is the first tab, it gets activated by
+    // append_source_editor, which loads its content.
+    m_priv->released_source_paths.insert (a_path);
+    append_source_editor (*source_editor, a_path);
+
+    NEMIVER_CATCH_AND_RETURN (false)
+    return true;
+}
+
+/// Record that a source editor was just used, loading the content of
+/// its file if its buffers were released.  Then release the buffers
+/// of the least recently used source editors, if there are more
+/// resident buffers than the configured maximum.
+///
+/// \param a_editor the source editor that was used.
+///
+/// \return true if the editor has the content of its file in
+/// memory, false otherwise.
+bool
+DBGPerspective::touch_source_buffer (SourceEditor *a_editor)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (!a_editor)
+        return false;
+
+    UString path = a_editor->get_path ();
+    if (path.empty () || path == get_asm_title ())
+        return true;
+
+    std::set<UString>::iterator released =
+        m_priv->released_source_paths.find (path);
+    if (released != m_priv->released_source_paths.end ()) {
+        LOG_DD ("loading released buffer of " << path);
+        Glib::RefPtr<Gsv::Buffer> buffer =
+            a_editor->source_view ().get_source_buffer ();
+        int current_line = a_editor->current_line ();
+        int current_column = a_editor->current_column ();
+        if (!m_priv->load_file (path, buffer))
+            return false;
+        m_priv->released_source_paths.erase (released);
+        a_editor->register_non_assembly_source_buffer (buffer);
+        a_editor->current_line (current_line);
+        a_editor->current_column (current_column);
+        apply_decorations (a_editor);
+    }
+
+    m_priv->resident_source_paths.remove (path);
+    m_priv->resident_source_paths.push_front (path);
+    release_source_buffers_over_budget ();
+    return true;
+}
+
+/// Release the buffers of a source editor, keeping only its path,
+/// cursor position and tab.  The breakpoint and "where" markers are
+/// set again when the buffer gets loaded back by
+/// touch_source_buffer.
+///
+/// \param a_editor the source editor to consider.
+void
+DBGPerspective::release_source_buffer (SourceEditor *a_editor)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    THROW_IF_FAIL (a_editor);
+
+    UString path = a_editor->get_path ();
+    LOG_DD ("releasing buffer of " << path);
+    a_editor->release_source_buffers ();
+    m_priv->resident_source_paths.remove (path);
+    m_priv->released_source_paths.insert (path);
+}
+
+/// Release the buffers of the least recently used source editors
+/// until no more than the configured maximum number of them are
+/// resident.  The editor of the current tab and the editors that
+/// show assembly are never released.
+void
+DBGPerspective::release_source_buffers_over_budget ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    if (m_priv->max_resident_source_buffers <= 0)
+        return;
+
+    SourceEditor *current_editor = get_current_source_editor (false);
+    std::list<UString>::iterator it = m_priv->resident_source_paths.end ();
+    int nb_resident = m_priv->resident_source_paths.size ();
+    while (nb_resident > m_priv->max_resident_source_buffers
+           && it != m_priv->resident_source_paths.begin ()) {
+        --it;
+        SourceEditor *editor = get_source_editor_from_path (*it);
+        if (editor == 0) {
+            it = m_priv->resident_source_paths.erase (it);
+            --nb_resident;
+            continue;
+        }
+        if (editor == current_editor
+            || editor->get_buffer_type ()
+                != SourceEditor::BUFFER_TYPE_SOURCE)
+            continue;
+        // release_source_buffer removes *it from the list.
+        ++it;
+        release_source_buffer (editor);
+        --nb_resident;
+    }
+}
+
+/// \return true if the buffers of the source editor of a given path
+/// were released by release_source_buffer, and have not been loaded
+/// back yet.
+bool
+DBGPerspective::is_source_buffer_released (const UString &a_path) const
+{
+    return (m_priv->released_source_paths.find (a_path)
+            != m_priv->released_source_paths.end ());
+}
+
+/// Forget about the buffers of the source editor of a given path,
+/// e.g, because it was closed.
+void
+DBGPerspective::forget_source_buffer (const UString &a_path)
+{
+    m_priv->resident_source_paths.remove (a_path);
+    m_priv->released_source_paths.erase (a_path);
+}
+
 ISessMgr&
 DBGPerspective::session_manager ()
 {
@@ -5941,11 +6782,12 @@ DBGPerspective::execute_session (ISessMgr::Session &a_session)
         m_priv->session_search_paths.push_back (*path_iter);
     }
 
-    // open the previously opened files
+    // open the previously opened files.  Their content is loaded
+    // only when their tab gets activated.
     for (path_iter = m_priv->session.opened_files ().begin ();
             path_iter != m_priv->session.opened_files ().end ();
             ++path_iter) {
-        open_file(*path_iter);
+        open_file_lazily (*path_iter);
     }
 
     vector<UString> args =
@@ -6244,6 +7086,7 @@ DBGPerspective::execute_program
     }
 
     m_priv->debugger_engine_alive = true;
+    m_priv->last_checkpoint_id = -1;
 
     // set environment variables of the inferior
     dbg_engine->add_env_variables (a_env);
@@ -7440,6 +8283,10 @@ DBGPerspective::apply_decorations_to_source (SourceEditor *a_editor,
     THROW_IF_FAIL (a_editor->get_buffer_type ()
                    == SourceEditor::BUFFER_TYPE_SOURCE);
 
+    // The decorations are applied when the buffer gets loaded back.
+    if (is_source_buffer_released (a_editor->get_path ()))
+        return true;
+
     map<string, IDebugger::Breakpoint>::const_iterator it;
     for (it = m_priv->breakpoints.begin ();
          it != m_priv->breakpoints.end ();
@@ -8009,12 +8856,7 @@ DBGPerspective::disassemble_and_do (IDebugger::DisassSlot &a_what_to_do,
 
     THROW_IF_FAIL (addr_range.min () != addr_range.max ());
 
-    debugger ()->disassemble (/*start_addr=*/addr_range.min (),
-                              /*start_addr_relative_to_pc=*/false,
-                              /*end_addr=*/addr_range.max (),
-                              /*end_addr_relative_to_pc=*/false,
-                              a_what_to_do,
-                              m_priv->asm_style_pure);
+    disassemble_range_and_do (addr_range, a_what_to_do);
 }
 
 void
@@ -8047,11 +8889,50 @@ DBGPerspective::disassemble_around_address_and_do
     addr_range.max (addr_range.max () + total_instrs_size);
     THROW_IF_FAIL (addr_range.min () != addr_range.max ());
 
-    debugger ()->disassemble (/*start_addr=*/addr_range.min (),
+    disassemble_range_and_do (addr_range, a_what_to_do);
+}
+
+/// Disassemble a range of addresses and invoke a slot with the
+/// resulting instructions.  If the range was disassembled already,
+/// the instructions come from the disassembly cache, without asking
+/// the debugger.  Otherwise, the result of the disassembling is
+/// added to the cache.
+///
+/// \param a_range the range of addresses to disassemble.  Its upper
+/// bound is not included in the range.
+///
+/// \param a_what_to_do the slot to invoke with the instructions.
+/// It's always invoked asynchronously, from the main loop.
+void
+DBGPerspective::disassemble_range_and_do (const Range &a_range,
+                                          IDebugger::DisassSlot &a_what_to_do)
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    common::DisassembleInfo info;
+    std::list<common::Asm> instrs;
+    if (m_priv->disassembly_cache.lookup (a_range.min (), a_range.max (),
+                                          m_priv->asm_style_pure,
+                                          info, instrs)) {
+        LOG_DD ("serving range [" << a_range.min ()
+                << ", " << a_range.max () << ") from cache");
+        Glib::signal_idle ().connect
+            (sigc::bind (sigc::mem_fun (*this,
+                                        &DBGPerspective::on_cached_asm_idle),
+                         info, instrs, a_what_to_do));
+        return;
+    }
+
+    IDebugger::DisassSlot slot =
+        sigc::bind (sigc::mem_fun
+                        (*this,
+                         &DBGPerspective::on_debugger_asm_signal_to_cache),
+                    a_range, m_priv->asm_style_pure, a_what_to_do);
+    debugger ()->disassemble (/*start_addr=*/a_range.min (),
                               /*start_addr_relative_to_pc=*/false,
-                              /*end_addr=*/addr_range.max (),
+                              /*end_addr=*/a_range.max (),
                               /*end_addr_relative_to_pc=*/false,
-                              a_what_to_do,
+                              slot,
                               m_priv->asm_style_pure);
 }
 
@@ -8516,6 +9397,46 @@ DBGPerspective::get_expr_monitor_view ()
     return *m_priv->expr_monitor;
 }
 
+/// Return the view showing the timings and counters of the
+/// debugging engine.
+PerfView&
+DBGPerspective::get_perf_view ()
+{
+    THROW_IF_FAIL (m_priv);
+
+    if (!m_priv->perf_view)
+        m_priv->perf_view.reset (new PerfView (debugger ()));
+    THROW_IF_FAIL (m_priv->perf_view);
+    return *m_priv->perf_view;
+}
+
+/// Return the view that lets the user go back through the recent
+/// stops of the inferior.
+StopHistoryView&
+DBGPerspective::get_stop_history_view ()
+{
+    THROW_IF_FAIL (m_priv);
+
+    if (!m_priv->stop_history_view)
+        m_priv->stop_history_view.reset
+                                (new StopHistoryView (debugger ()));
+    THROW_IF_FAIL (m_priv->stop_history_view);
+    return *m_priv->stop_history_view;
+}
+
+/// Return the view that lists the shared libraries loaded by the
+/// inferior.
+LibrariesView&
+DBGPerspective::get_libraries_view ()
+{
+    THROW_IF_FAIL (m_priv);
+
+    if (!m_priv->libraries_view)
+        m_priv->libraries_view.reset (new LibrariesView (debugger ()));
+    THROW_IF_FAIL (m_priv->libraries_view);
+    return *m_priv->libraries_view;
+}
+
 struct ScrollTextViewToEndClosure {
     Gtk::TextView* text_view;
 
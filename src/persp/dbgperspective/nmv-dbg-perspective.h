@@ -49,7 +49,10 @@ enum ViewsIndex
 #ifdef WITH_MEMORYVIEW
     MEMORY_VIEW_INDEX,
 #endif // WITH_MEMORYVIEW
-    EXPR_MONITOR_VIEW_INDEX
+    EXPR_MONITOR_VIEW_INDEX,
+    PERF_VIEW_INDEX,
+    STOP_HISTORY_VIEW_INDEX,
+    LIBRARIES_VIEW_INDEX
 };
 
 class SourceEditor;
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <list>
+#include <vector>
 #include <glib/gi18n.h>
 #include "common/nmv-exception.h"
 #include "nmv-global-vars-inspector-dialog.h"
@@ -33,7 +34,7 @@
 #include "nmv-vars-treeview.h"
 #include "nmv-ui-utils.h"
 #include "nmv-i-workbench.h"
-#include "nmv-i-var-list-walker.h"
+#include "nmv-i-var-walker.h"
 
 using namespace nemiver::common;
 namespace vutil = nemiver::variables_utils2;
@@ -47,7 +48,15 @@ public:
     Gtk::Dialog &dialog;
     Glib::RefPtr<Gtk::Builder> gtkbuilder;
     IDebuggerSafePtr debugger;
-    IVarListWalkerSafePtr global_variables_walker_list;
+    // The walkers of the global variables whose rows came close to
+    // the viewport, keyed by the variable of the row.
+    std::map<const IDebugger::Variable*, IVarWalkerSafePtr> var_walkers;
+    // The rows of the global variables, keyed by the variable the
+    // row was added for.  The iterators of a Gtk::TreeStore remain
+    // valid as long as their row exists, and the top level rows are
+    // only removed when the globals are listed again.  Unlike
+    // Gtk::TreeRowReference, they cost nothing when rows are added.
+    std::map<const IDebugger::Variable*, Gtk::TreeModel::iterator> rows;
 
     IWorkbench &workbench;
     VarsTreeView* tree_view;
@@ -115,20 +124,8 @@ public:
         NEMIVER_CATCH
     }
 
-    IVarListWalkerSafePtr get_global_variables_walker_list ()
-    {
-        if (!global_variables_walker_list) {
-            global_variables_walker_list = create_variable_walker_list ();
-            THROW_IF_FAIL (global_variables_walker_list);
-            global_variables_walker_list->variable_visited_signal ().connect
-            (sigc::mem_fun
-             (*this,
-              &GlobalVarsInspectorDialog::Priv::on_global_variable_visited_signal));
-        }
-        return global_variables_walker_list;
-    }
-
-    IVarListWalkerSafePtr create_variable_walker_list ()
+    IVarWalkerSafePtr create_variable_walker
+                                (const IDebugger::VariableSafePtr &a_var)
     {
         DynamicModule::Loader *loader =
             workbench.get_dynamic_module ().get_module_loader ();
@@ -136,14 +133,46 @@ public:
         DynamicModuleManager *module_manager =
                                     loader->get_dynamic_module_manager ();
         THROW_IF_FAIL (module_manager);
-        IVarListWalkerSafePtr result =
-            module_manager->load_iface<IVarListWalker> ("varlistwalker",
-                                                        "IVarListWalker");
+        IVarWalkerSafePtr result =
+            module_manager->load_iface<IVarWalker> ("varwalker",
+                                                    "IVarWalker");
         THROW_IF_FAIL (result);
-        result->initialize (debugger.get ());
+        result->connect (debugger.get (), a_var);
         return result;
     }
 
+    /// Walk the global variables whose rows are in or near the
+    /// viewport and that have not been walked yet.  A program can
+    /// have tens of thousands of globals; walking them all up
+    /// front floods GDB with queries for rows nobody looks at.
+    void walk_variables_near_viewport ()
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        THROW_IF_FAIL (tree_view);
+
+        std::vector<Gtk::TreeModel::iterator> rows;
+        tree_view->get_root_rows_near_viewport (rows);
+
+        std::vector<Gtk::TreeModel::iterator>::const_iterator it;
+        for (it = rows.begin (); it != rows.end (); ++it) {
+            IDebugger::VariableSafePtr var =
+                (*it)->get_value (vutil::get_variable_columns ().variable);
+            if (!var || var_walkers.count (var.get ()))
+                continue;
+
+            IVarWalkerSafePtr walker = create_variable_walker (var);
+            walker->visited_variable_signal ().connect
+                (sigc::bind
+                 (sigc::mem_fun (*this,
+                                 &Priv::on_global_variable_visited_signal),
+                  var));
+            var_walkers[var.get ()] = walker;
+            LOG_DD ("walking global variable '" << var->name () << "'");
+            walker->do_walk_variable ();
+        }
+    }
+
 
     void connect_to_debugger_signals ()
     {
@@ -169,6 +198,9 @@ public:
         tree_view->signal_row_activated ().connect
             (sigc::mem_fun (*this,
                             &Priv::on_tree_view_row_activated_signal));
+        tree_view->visible_rows_changed_signal ().connect
+            (sigc::mem_fun (*this,
+                            &Priv::on_tree_view_visible_rows_changed_signal));
     }
 
     void set_global_variables
@@ -177,12 +209,55 @@ public:
         LOG_FUNCTION_SCOPE_NORMAL_DD;
 
         THROW_IF_FAIL (tree_view && tree_store);
+        var_walkers.clear ();
+        rows.clear ();
         tree_store->clear ();
+        // Only add the rows here, with the names of the variables.
+        // Their types and values are queried when the rows come
+        // into view.
         std::list<IDebugger::VariableSafePtr>::const_iterator it;
         for (it = a_vars.begin (); it != a_vars.end (); ++it) {
             THROW_IF_FAIL ((*it)->name () != "");
-            append_a_global_variable (*it);
+            Gtk::TreeModel::iterator parent_it, row_it;
+            vutil::append_a_variable (*it,
+                                      static_cast<Gtk::TreeView&> (*tree_view),
+                                      parent_it /* no parent */,
+                                      row_it,
+                                      false /* do not truncate type */);
+            rows[it->get ()] = row_it;
         }
+        walk_variables_near_viewport ();
+    }
+
+    /// Render a global variable that has just been walked into
+    /// the row that was added for it when the globals got listed.
+    /// If there is no such row, a new one is appended.
+    ///
+    /// \param a_var the walked variable.
+    ///
+    /// \param a_row_var the variable the row was added for.
+    void set_a_global_variable (const IDebugger::VariableSafePtr a_var,
+                                const IDebugger::VariableSafePtr a_row_var)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        THROW_IF_FAIL (tree_view && tree_store && a_var);
+
+        std::map<const IDebugger::Variable*,
+                 Gtk::TreeModel::iterator>::const_iterator it =
+            rows.find (a_row_var.get ());
+        if (it == rows.end ()) {
+            append_a_global_variable (a_var);
+            return;
+        }
+        Gtk::TreeModel::iterator row_it = it->second;
+
+        vutil::unlink_member_variable_rows (row_it, tree_store);
+        vutil::set_a_variable (a_var,
+                               static_cast<Gtk::TreeView&> (*tree_view),
+                               row_it,
+                               false /* do not truncate type */);
+        tree_view->expand_row (tree_store->get_path (row_it), false);
     }
 
     void append_a_global_variable (const IDebugger::VariableSafePtr a_var)
@@ -229,13 +304,7 @@ public:
 
         NEMIVER_TRY
 
-        IVarListWalkerSafePtr walker_list =
-                                get_global_variables_walker_list ();
-        THROW_IF_FAIL (walker_list);
-
-        walker_list->remove_variables ();
-        walker_list->append_variables (a_vars);
-        walker_list->do_walk_variables ();
+        set_global_variables (a_vars);
 
         NEMIVER_CATCH
     }
@@ -244,16 +313,36 @@ public:
     //</debugger signal handlers>
     //****************************
 
-    void on_global_variable_visited_signal (const IVarWalkerSafePtr &a_walker)
+    void on_global_variable_visited_signal
+                                (const IDebugger::VariableSafePtr a_var,
+                                 IDebugger::VariableSafePtr a_row_var)
     {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
 
         NEMIVER_TRY
 
-        THROW_IF_FAIL (a_walker->get_variable ());
+        // The walk might belong to a listing that has been replaced
+        // since.
+        std::map<const IDebugger::Variable*, IVarWalkerSafePtr>::iterator it =
+            var_walkers.find (a_row_var.get ());
+        if (it == var_walkers.end ())
+            return;
+        // Do not drop the walker here: it is still emitting.  The
+        // walkers are released when the globals are listed again.
+
+        THROW_IF_FAIL (a_var);
+        set_a_global_variable (a_var, a_row_var);
+        // The row now holds a_var; make sure it is not walked again.
+        if (a_var != a_row_var)
+            var_walkers[a_var.get ()] = it->second;
 
-        append_a_global_variable (a_walker->get_variable ());
+        NEMIVER_CATCH
+    }
 
+    void on_tree_view_visible_rows_changed_signal ()
+    {
+        NEMIVER_TRY
+        walk_variables_near_viewport ();
         NEMIVER_CATCH
     }
 
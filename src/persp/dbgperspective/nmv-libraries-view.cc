@@ -0,0 +1,274 @@
+//Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#include "config.h"
+#include <glib/gi18n.h>
+#include <gtkmm/box.h>
+#include <gtkmm/label.h>
+#include <gtkmm/entry.h>
+#include <gtkmm/button.h>
+#include <gtkmm/scrolledwindow.h>
+#include <gtkmm/treeview.h>
+#include <gtkmm/liststore.h>
+#include "common/nmv-exception.h"
+#include "common/nmv-str-utils.h"
+#include "nmv-libraries-view.h"
+#include "nmv-ui-utils.h"
+
+namespace nemiver {
+
+struct LibraryColumns : public Gtk::TreeModelColumnRecord {
+    Gtk::TreeModelColumn<Glib::ustring> id;
+    Gtk::TreeModelColumn<Glib::ustring> target_name;
+    Gtk::TreeModelColumn<Glib::ustring> address_ranges;
+    Gtk::TreeModelColumn<bool> symbols_loaded;
+
+    LibraryColumns ()
+    {
+        add (id);
+        add (target_name);
+        add (address_ranges);
+        add (symbols_loaded);
+    }
+};//end LibraryColumns
+
+static LibraryColumns&
+get_library_columns ()
+{
+    static LibraryColumns s_cols;
+    return s_cols;
+}
+
+/// \return the address ranges of a library, formatted as
+/// "from-to, from-to".
+static UString
+format_address_ranges (const IDebugger::Library &a_library)
+{
+    UString result;
+    list<IDebugger::Library::AddressRange>::const_iterator it;
+    for (it = a_library.address_ranges ().begin ();
+         it != a_library.address_ranges ().end ();
+         ++it) {
+        if (!result.empty ())
+            result += ", ";
+        result += it->first.to_string () + "-" + it->second.to_string ();
+    }
+    return result;
+}
+
+struct LibrariesView::Priv {
+public:
+    IDebuggerSafePtr& debugger;
+    SafePtr<Gtk::Box> main_box;
+    SafePtr<Gtk::Entry> address_entry;
+    SafePtr<Gtk::Label> lookup_label;
+    SafePtr<Gtk::TreeView> tree_view;
+    Glib::RefPtr<Gtk::ListStore> list_store;
+    bool is_up2date;
+
+    Priv (IDebuggerSafePtr& a_debugger) :
+        debugger (a_debugger),
+        is_up2date (true)
+    {
+        build_widget ();
+
+        debugger->libraries_changed_signal ().connect
+            (sigc::mem_fun (*this, &Priv::on_libraries_changed_signal));
+    }
+
+    void build_widget ()
+    {
+        if (main_box) {return;}
+
+        main_box.reset (new Gtk::Box (Gtk::ORIENTATION_VERTICAL, 4));
+
+        Gtk::Box *top_box =
+            Gtk::manage (new Gtk::Box (Gtk::ORIENTATION_HORIZONTAL, 4));
+        Gtk::Label *address_label =
+            Gtk::manage (new Gtk::Label (_("Address:")));
+        top_box->pack_start (*address_label, Gtk::PACK_SHRINK);
+        address_entry.reset (new Gtk::Entry);
+        address_entry->set_tooltip_text
+            (_("An address, e.g. 0x7ffff7a8f3f0, to find "
+               "the library it belongs to"));
+        address_entry->signal_activate ().connect
+            (sigc::mem_fun (*this, &Priv::on_find_library));
+        top_box->pack_start (*address_entry, Gtk::PACK_SHRINK);
+        Gtk::Button *find_button =
+            Gtk::manage (new Gtk::Button (_("_Find Library"), true));
+        find_button->signal_clicked ().connect
+            (sigc::mem_fun (*this, &Priv::on_find_library));
+        top_box->pack_start (*find_button, Gtk::PACK_SHRINK);
+        lookup_label.reset (new Gtk::Label);
+        lookup_label->set_alignment (0, 0.5);
+        lookup_label->set_selectable (true);
+        top_box->pack_start (*lookup_label, Gtk::PACK_EXPAND_WIDGET);
+        main_box->pack_start (*top_box, Gtk::PACK_SHRINK);
+
+        list_store = Gtk::ListStore::create (get_library_columns ());
+        tree_view.reset (new Gtk::TreeView (list_store));
+        tree_view->append_column (_("Library"),
+                                  get_library_columns ().target_name);
+        tree_view->append_column (_("Address Ranges"),
+                                  get_library_columns ().address_ranges);
+        tree_view->append_column (_("Symbols Loaded"),
+                                  get_library_columns ().symbols_loaded);
+        tree_view->set_search_column (get_library_columns ().target_name);
+
+        Gtk::ScrolledWindow *scr = Gtk::manage (new Gtk::ScrolledWindow);
+        scr->set_policy (Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+        scr->set_shadow_type (Gtk::SHADOW_IN);
+        scr->add (*tree_view);
+        main_box->pack_start (*scr, Gtk::PACK_EXPAND_WIDGET);
+
+        main_box->signal_draw ().connect_notify
+            (sigc::mem_fun (*this, &Priv::on_draw_signal));
+        main_box->show_all ();
+    }
+
+    bool should_process_now ()
+    {
+        THROW_IF_FAIL (main_box);
+        return main_box->get_is_drawable ();
+    }
+
+    void refresh ()
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        list_store->clear ();
+        const map<UString, IDebugger::Library> &libraries =
+            debugger->get_libraries ();
+        map<UString, IDebugger::Library>::const_iterator it;
+        for (it = libraries.begin (); it != libraries.end (); ++it) {
+            Gtk::TreeModel::iterator row = list_store->append ();
+            (*row)[get_library_columns ().id] = it->first;
+            (*row)[get_library_columns ().target_name] =
+                it->second.target_name ().empty ()
+                ? it->first
+                : it->second.target_name ();
+            (*row)[get_library_columns ().address_ranges] =
+                format_address_ranges (it->second);
+            (*row)[get_library_columns ().symbols_loaded] =
+                it->second.symbols_loaded ();
+        }
+        is_up2date = true;
+    }
+
+    /// Select the row of a library.
+    void select_library (const UString &a_id)
+    {
+        Gtk::TreeModel::iterator it;
+        for (it = list_store->children ().begin ();
+             it != list_store->children ().end ();
+             ++it) {
+            if ((Glib::ustring) (*it)[get_library_columns ().id] == a_id) {
+                tree_view->get_selection ()->select (it);
+                tree_view->scroll_to_row (list_store->get_path (it));
+                return;
+            }
+        }
+    }
+
+    void on_find_library ()
+    {
+        NEMIVER_TRY
+
+        UString address_str = address_entry->get_text ();
+        address_str.chomp ();
+        if (address_str.empty ())
+            return;
+        if (!str_utils::string_is_number (address_str.raw ())) {
+            lookup_label->set_text (_("Invalid address"));
+            return;
+        }
+
+        IDebugger::Library library;
+        if (!debugger->find_library_at_address
+                            (Address (address_str.raw ()), library)) {
+            lookup_label->set_text (_("No library is mapped there"));
+            return;
+        }
+        lookup_label->set_text (library.target_name ().empty ()
+                                ? library.id ()
+                                : library.target_name ());
+        if (!is_up2date)
+            refresh ();
+        select_library (library.id ());
+
+        NEMIVER_CATCH
+    }
+
+    void on_libraries_changed_signal ()
+    {
+        NEMIVER_TRY
+        // The engine notifies a burst of library events at once, so
+        // this doesn't happen for each library.
+        if (should_process_now ()) {
+            refresh ();
+        } else {
+            is_up2date = false;
+        }
+        NEMIVER_CATCH
+    }
+
+    void on_draw_signal (const Cairo::RefPtr<Cairo::Context> &)
+    {
+        NEMIVER_TRY
+        if (!is_up2date)
+            refresh ();
+        NEMIVER_CATCH
+    }
+
+};//end struct LibrariesView::Priv
+
+LibrariesView::LibrariesView (IDebuggerSafePtr& a_debugger)
+{
+    m_priv.reset (new Priv (a_debugger));
+}
+
+LibrariesView::~LibrariesView ()
+{
+    LOG_D ("deleted", "destructor-domain");
+}
+
+Gtk::Widget&
+LibrariesView::widget () const
+{
+    THROW_IF_FAIL (m_priv);
+    THROW_IF_FAIL (m_priv->main_box);
+    return *m_priv->main_box;
+}
+
+void
+LibrariesView::clear ()
+{
+    THROW_IF_FAIL (m_priv);
+
+    m_priv->list_store->clear ();
+    m_priv->lookup_label->set_text ("");
+    m_priv->is_up2date = false;
+}
+
+}//end namespace nemiver
@@ -0,0 +1,57 @@
+//Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#ifndef __NMV_LIBRARIES_VIEW_H__
+#define __NMV_LIBRARIES_VIEW_H__
+
+#include <gtkmm/widget.h>
+#include "common/nmv-object.h"
+#include "common/nmv-safe-ptr-utils.h"
+#include "nmv-i-debugger.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+
+/// A view that lists the shared libraries loaded by the inferior,
+/// with the addresses they are mapped at, and that finds the library
+/// an address belongs to without asking GDB.
+class NEMIVER_API LibrariesView : public nemiver::common::Object {
+    //non copyable
+    LibrariesView (const LibrariesView&);
+    LibrariesView& operator= (const LibrariesView&);
+
+    struct Priv;
+    SafePtr<Priv> m_priv;
+
+public:
+
+    LibrariesView (IDebuggerSafePtr& a_debugger);
+    virtual ~LibrariesView ();
+    Gtk::Widget& widget () const;
+    void clear ();
+
+};//end LibrariesView
+
+NEMIVER_END_NAMESPACE (nemiver)
+
+#endif //__NMV_LIBRARIES_VIEW_H__
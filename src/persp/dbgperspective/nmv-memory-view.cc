@@ -26,6 +26,7 @@
 #include <sstream>
 #include <bitset>
 #include <iomanip>
+#include <algorithm>
 #include <gtkmm/entry.h>
 #include <gtkmm/label.h>
 #include <gtkmm/box.h>
@@ -38,6 +39,10 @@
 
 namespace nemiver {
 
+// The time, in milliseconds, during which adjacent edits of the
+// memory are gathered before being written to the inferior at once.
+static const unsigned WRITE_COALESCING_DELAY = 200;
+
 class GroupingComboBox : public Gtk::ComboBox
 {
     public:
@@ -93,6 +98,17 @@ public:
     Hex::EditorSafePtr m_editor;
     IDebuggerSafePtr m_debugger;
     sigc::connection signal_document_changed_connection;
+    // The address of the first byte of the document.
+    size_t m_document_address;
+    // The range of the document [start, end) that has been edited
+    // but not yet written to the inferior, and the address of the
+    // first byte of the document when the edit was made.  The
+    // address entry can be changed by the user in the mean time.
+    bool m_has_pending_write;
+    guint m_pending_write_start;
+    guint m_pending_write_end;
+    size_t m_pending_write_address;
+    sigc::connection m_pending_write_connection;
 
     Priv (IDebuggerSafePtr& a_debugger) :
         m_address_label (new Gtk::Label (_("Address:"))),
@@ -104,7 +120,12 @@ public:
         m_container (new Gtk::ScrolledWindow ()),
         m_document (Hex::Document::create ()),
         m_editor (Hex::Editor::create (m_document)),
-        m_debugger (a_debugger)
+        m_debugger (a_debugger),
+        m_document_address (0),
+        m_has_pending_write (false),
+        m_pending_write_start (0),
+        m_pending_write_end (0),
+        m_pending_write_address (0)
     {
         // For a reason, the hex editor (instance of m_editor) won't
         // properly render itself if it's not put inside a scrolled
@@ -140,6 +161,11 @@ public:
         connect_signals ();
     }
 
+    ~Priv ()
+    {
+        m_pending_write_connection.disconnect ();
+    }
+
     void connect_signals ()
     {
         THROW_IF_FAIL (m_debugger);
@@ -172,7 +198,19 @@ public:
             case IDebugger::READY:
                 set_widgets_sensitive (true);
                 break;
+            case IDebugger::NOT_STARTED:
+            case IDebugger::PROGRAM_EXITED:
+                // There is no inferior to write the edits to
+                // anymore.
+                drop_pending_write ();
+                set_widgets_sensitive (false);
+                break;
             default:
+                // The debugger goes busy for every command it runs,
+                // e.g. a refresh of some view.  Don't lose the edits
+                // made right before that: set_memory is queued
+                // behind the command, like any other.
+                flush_pending_write ();
                 set_widgets_sensitive (false);
         }
         NEMIVER_CATCH
@@ -184,6 +222,9 @@ public:
         NEMIVER_TRY
         THROW_IF_FAIL (m_debugger);
         THROW_IF_FAIL (m_editor);
+        // Write the pending edits before they get replaced by what
+        // is read.
+        flush_pending_write ();
         int editor_cpl, editor_lines;
         m_editor->get_geometry (editor_cpl, editor_lines);
         size_t addr = get_address ();
@@ -269,9 +310,12 @@ public:
     {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
         THROW_IF_FAIL (m_document);
+        // Don't lose the edits made to the data we are replacing.
+        flush_pending_write ();
         // don't want to set memory in gdb in response to data read from gdb
         signal_document_changed_connection.block ();
         m_document->clear ();
+        m_document_address = a_start_addr;
         m_editor->set_starting_offset (a_start_addr);
         m_document->set_data (0 /*offset*/,
                               a_data.size (),
@@ -280,19 +324,86 @@ public:
         signal_document_changed_connection.unblock ();
     }
 
-    void on_document_changed (HexChangeData* a_change_data)
+    /// Write the edited range of the document, if any, to the
+    /// inferior, with a single IDebugger::set_memory call.
+    void flush_pending_write ()
     {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
-        size_t length = a_change_data->end - a_change_data->start + 1;
+
+        m_pending_write_connection.disconnect ();
+        if (!m_has_pending_write)
+            return;
+        m_has_pending_write = false;
+
+        THROW_IF_FAIL (m_document && m_debugger);
+        guint length = m_pending_write_end - m_pending_write_start;
         guchar* new_data =
-                m_document->get_data (a_change_data->start, length);
+                m_document->get_data (m_pending_write_start, length);
         if (new_data) {
-            std::vector<uint8_t> data(new_data, new_data + length);
+            std::vector<uint8_t> data (new_data, new_data + length);
+            g_free (new_data);
             // set data in the debugger
             m_debugger->set_memory
-                (static_cast<size_t> (get_address () + a_change_data->start),
-                 data);
+                (m_pending_write_address + m_pending_write_start, data);
+        }
+    }
+
+    /// Forget about the edited range of the document that has not
+    /// been written to the inferior yet, if any.
+    void drop_pending_write ()
+    {
+        if (m_has_pending_write)
+            LOG_DD ("dropping the write of "
+                    << m_pending_write_end - m_pending_write_start
+                    << " bytes");
+        m_pending_write_connection.disconnect ();
+        m_has_pending_write = false;
+    }
+
+    bool on_pending_write_timeout ()
+    {
+        NEMIVER_TRY
+        flush_pending_write ();
+        NEMIVER_CATCH
+        return false;
+    }
+
+    /// Record an edit of the document.  Edits that touch or overlap
+    /// the range already waiting to be written are merged into it,
+    /// and the range is written once no edit happened for
+    /// WRITE_COALESCING_DELAY milliseconds.  An edit elsewhere
+    /// causes the pending range to be written right away.
+    void on_document_changed (HexChangeData* a_change_data)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        NEMIVER_TRY
+
+        guint start = a_change_data->start;
+        guint end = a_change_data->end + 1;
+
+        if (m_has_pending_write
+            && (end < m_pending_write_start
+                || start > m_pending_write_end)) {
+            flush_pending_write ();
+        }
+
+        if (m_has_pending_write) {
+            m_pending_write_start = std::min (m_pending_write_start, start);
+            m_pending_write_end = std::max (m_pending_write_end, end);
+        } else {
+            m_has_pending_write = true;
+            m_pending_write_start = start;
+            m_pending_write_end = end;
+            m_pending_write_address = m_document_address;
         }
+
+        m_pending_write_connection.disconnect ();
+        m_pending_write_connection = Glib::signal_timeout ().connect
+            (sigc::mem_fun (*this, &Priv::on_pending_write_timeout),
+             WRITE_COALESCING_DELAY);
+
+        NEMIVER_CATCH
     }
 
 };
@@ -316,7 +427,11 @@ void
 MemoryView::clear ()
 {
     THROW_IF_FAIL (m_priv && m_priv->m_document && m_priv->m_address_entry);
+    // The edits that were not written yet are moot now.
+    m_priv->drop_pending_write ();
+    m_priv->signal_document_changed_connection.block ();
     m_priv->m_document->set_data (0, 0, 0, 0, false);
+    m_priv->signal_document_changed_connection.unblock ();
     m_priv->m_address_entry->set_text ("");
 }
 
@@ -0,0 +1,387 @@
+//Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#include "config.h"
+#include <glib/gi18n.h>
+#include <gtkmm/box.h>
+#include <gtkmm/label.h>
+#include <gtkmm/button.h>
+#include <gtkmm/stock.h>
+#include <gtkmm/paned.h>
+#include <gtkmm/scrolledwindow.h>
+#include <gtkmm/treeview.h>
+#include <gtkmm/liststore.h>
+#include <gtkmm/filechooserdialog.h>
+#include "common/nmv-exception.h"
+#include "common/nmv-str-utils.h"
+#include "nmv-perf-view.h"
+#include "nmv-ui-utils.h"
+
+namespace nemiver {
+
+/// The number of recent commands shown in the view.
+static const unsigned MAX_NB_COMMANDS_SHOWN = 100;
+
+/// The minimum delay between two refreshes of the view, in
+/// milliseconds.
+static const unsigned REFRESH_DELAY = 500;
+
+struct HandlerColumns : public Gtk::TreeModelColumnRecord {
+    Gtk::TreeModelColumn<Glib::ustring> name;
+    Gtk::TreeModelColumn<unsigned long> nb_calls;
+    Gtk::TreeModelColumn<Glib::ustring> total_time;
+    Gtk::TreeModelColumn<Glib::ustring> mean_time;
+    Gtk::TreeModelColumn<Glib::ustring> max_time;
+    Gtk::TreeModelColumn<Glib::ustring> histogram;
+
+    HandlerColumns ()
+    {
+        add (name);
+        add (nb_calls);
+        add (total_time);
+        add (mean_time);
+        add (max_time);
+        add (histogram);
+    }
+};//end HandlerColumns
+
+struct CommandColumns : public Gtk::TreeModelColumnRecord {
+    Gtk::TreeModelColumn<Glib::ustring> name;
+    Gtk::TreeModelColumn<Glib::ustring> queued_time;
+    Gtk::TreeModelColumn<Glib::ustring> gdb_time;
+    Gtk::TreeModelColumn<Glib::ustring> handling_time;
+
+    CommandColumns ()
+    {
+        add (name);
+        add (queued_time);
+        add (gdb_time);
+        add (handling_time);
+    }
+};//end CommandColumns
+
+static HandlerColumns&
+get_handler_columns ()
+{
+    static HandlerColumns s_cols;
+    return s_cols;
+}
+
+static CommandColumns&
+get_command_columns ()
+{
+    static CommandColumns s_cols;
+    return s_cols;
+}
+
+/// \return a duration expressed in microseconds, formatted in
+/// milliseconds.
+static UString
+format_duration (gint64 a_duration)
+{
+    return str_utils::printf ("%.3f", a_duration / 1000.0);
+}
+
+struct PerfView::Priv {
+public:
+    IDebuggerSafePtr& debugger;
+    SafePtr<Gtk::Box> main_box;
+    SafePtr<Gtk::Label> summary_label;
+    SafePtr<Gtk::TreeView> handlers_tree_view;
+    Glib::RefPtr<Gtk::ListStore> handlers_list_store;
+    SafePtr<Gtk::TreeView> commands_tree_view;
+    Glib::RefPtr<Gtk::ListStore> commands_list_store;
+    sigc::connection refresh_connection;
+    bool is_up2date;
+
+    Priv (IDebuggerSafePtr& a_debugger) :
+        debugger (a_debugger),
+        is_up2date (true)
+    {
+        build_widget ();
+
+        debugger->state_changed_signal ().connect
+            (sigc::mem_fun (*this, &Priv::on_debugger_state_changed_signal));
+    }
+
+    ~Priv ()
+    {
+        refresh_connection.disconnect ();
+    }
+
+    Gtk::ScrolledWindow*
+    wrap_in_scrolled_window (Gtk::Widget &a_widget)
+    {
+        Gtk::ScrolledWindow *scr = Gtk::manage (new Gtk::ScrolledWindow);
+        scr->set_policy (Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+        scr->set_shadow_type (Gtk::SHADOW_IN);
+        scr->add (a_widget);
+        return scr;
+    }
+
+    void build_widget ()
+    {
+        if (main_box) {return;}
+
+        main_box.reset (new Gtk::Box (Gtk::ORIENTATION_VERTICAL, 4));
+
+        Gtk::Box *top_box =
+            Gtk::manage (new Gtk::Box (Gtk::ORIENTATION_HORIZONTAL, 4));
+        summary_label.reset (new Gtk::Label);
+        summary_label->set_alignment (0, 0.5);
+        summary_label->set_selectable (true);
+        top_box->pack_start (*summary_label, Gtk::PACK_EXPAND_WIDGET);
+
+        Gtk::Button *reset_button =
+            Gtk::manage (new Gtk::Button (_("_Reset"), true));
+        reset_button->set_tooltip_text (_("Reset the timings and counters"));
+        reset_button->signal_clicked ().connect
+            (sigc::mem_fun (*this, &Priv::on_reset_button_clicked));
+        top_box->pack_end (*reset_button, Gtk::PACK_SHRINK);
+
+        Gtk::Button *dump_button =
+            Gtk::manage (new Gtk::Button (_("_Save Trace..."), true));
+        dump_button->set_tooltip_text
+            (_("Save the timings of the recent commands "
+               "in the Chrome trace format"));
+        dump_button->signal_clicked ().connect
+            (sigc::mem_fun (*this, &Priv::on_dump_button_clicked));
+        top_box->pack_end (*dump_button, Gtk::PACK_SHRINK);
+
+        main_box->pack_start (*top_box, Gtk::PACK_SHRINK);
+
+        handlers_list_store = Gtk::ListStore::create (get_handler_columns ());
+        handlers_tree_view.reset (new Gtk::TreeView (handlers_list_store));
+        handlers_tree_view->append_column (_("Output Handler"),
+                                           get_handler_columns ().name);
+        handlers_tree_view->append_column (_("Calls"),
+                                           get_handler_columns ().nb_calls);
+        handlers_tree_view->append_column (_("Total (ms)"),
+                                           get_handler_columns ().total_time);
+        handlers_tree_view->append_column (_("Mean (ms)"),
+                                           get_handler_columns ().mean_time);
+        handlers_tree_view->append_column (_("Max (ms)"),
+                                           get_handler_columns ().max_time);
+        handlers_tree_view->append_column
+                        (_("<10us/<100us/<1ms/<10ms/<100ms/<1s/more"),
+                         get_handler_columns ().histogram);
+
+        commands_list_store = Gtk::ListStore::create (get_command_columns ());
+        commands_tree_view.reset (new Gtk::TreeView (commands_list_store));
+        commands_tree_view->append_column (_("Command"),
+                                           get_command_columns ().name);
+        commands_tree_view->append_column
+                                    (_("Queued (ms)"),
+                                     get_command_columns ().queued_time);
+        commands_tree_view->append_column
+                                    (_("In GDB (ms)"),
+                                     get_command_columns ().gdb_time);
+        commands_tree_view->append_column
+                                    (_("Handling (ms)"),
+                                     get_command_columns ().handling_time);
+
+        Gtk::Paned *paned =
+            Gtk::manage (new Gtk::Paned (Gtk::ORIENTATION_VERTICAL));
+        paned->pack1 (*wrap_in_scrolled_window (*handlers_tree_view));
+        paned->pack2 (*wrap_in_scrolled_window (*commands_tree_view));
+        main_box->pack_start (*paned, Gtk::PACK_EXPAND_WIDGET);
+
+        main_box->signal_draw ().connect_notify
+            (sigc::mem_fun (*this, &Priv::on_draw_signal));
+        main_box->show_all ();
+    }
+
+    bool should_process_now ()
+    {
+        THROW_IF_FAIL (main_box);
+        return main_box->get_is_drawable ();
+    }
+
+    void refresh ()
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        const IDebugger::PerfStats &stats = debugger->get_perf_stats ();
+
+        UString summary;
+        summary.printf (_("Parsed %lu records, %.1f KB/s. "
+                          "Queue depth: %u, max: %u."),
+                        stats.nb_records_parsed (),
+                        stats.parse_bytes_per_second () / 1024,
+                        stats.queue_depth (),
+                        stats.max_queue_depth ());
+        summary_label->set_text (summary);
+
+        handlers_list_store->clear ();
+        map<UString, IDebugger::PerfStats::HandlerStats>::const_iterator h;
+        for (h = stats.handler_stats ().begin ();
+             h != stats.handler_stats ().end ();
+             ++h) {
+            Gtk::TreeModel::iterator row = handlers_list_store->append ();
+            (*row)[get_handler_columns ().name] = h->first;
+            (*row)[get_handler_columns ().nb_calls] = h->second.nb_calls ();
+            (*row)[get_handler_columns ().total_time] =
+                format_duration (h->second.total_time ());
+            if (h->second.nb_calls ())
+                (*row)[get_handler_columns ().mean_time] =
+                    format_duration (h->second.total_time ()
+                                     / (gint64) h->second.nb_calls ());
+            (*row)[get_handler_columns ().max_time] =
+                format_duration (h->second.max_time ());
+            UString histogram;
+            for (int i = 0;
+                 i < IDebugger::PerfStats::NB_HISTOGRAM_BUCKETS;
+                 ++i) {
+                if (i)
+                    histogram += "/";
+                histogram += UString::from_int (h->second.histogram (i));
+            }
+            (*row)[get_handler_columns ().histogram] = histogram;
+        }
+
+        // Show the most recent commands first.
+        commands_list_store->clear ();
+        unsigned nb_shown = 0;
+        list<IDebugger::PerfStats::CommandTiming>::const_reverse_iterator c;
+        for (c = stats.command_timings ().rbegin ();
+             c != stats.command_timings ().rend ()
+             && nb_shown < MAX_NB_COMMANDS_SHOWN;
+             ++c, ++nb_shown) {
+            Gtk::TreeModel::iterator row = commands_list_store->append ();
+            (*row)[get_command_columns ().name] = c->name ();
+            (*row)[get_command_columns ().queued_time] =
+                format_duration (c->issued_time () - c->queued_time ());
+            (*row)[get_command_columns ().gdb_time] =
+                format_duration (c->reply_time () - c->issued_time ());
+            (*row)[get_command_columns ().handling_time] =
+                format_duration (c->handled_time () - c->reply_time ());
+        }
+        is_up2date = true;
+    }
+
+    bool on_refresh_timeout ()
+    {
+        NEMIVER_TRY
+        if (should_process_now ()) {
+            refresh ();
+        } else {
+            is_up2date = false;
+        }
+        NEMIVER_CATCH
+        // This is a one shot timeout.
+        return false;
+    }
+
+    void on_debugger_state_changed_signal (IDebugger::State a_state)
+    {
+        NEMIVER_TRY
+        if (a_state != IDebugger::READY)
+            return;
+        // Commands can complete at a high rate; coalesce the
+        // refreshes so that the view doesn't become a hot path
+        // itself.
+        if (refresh_connection.connected ())
+            return;
+        refresh_connection = Glib::signal_timeout ().connect
+            (sigc::mem_fun (*this, &Priv::on_refresh_timeout),
+             REFRESH_DELAY);
+        NEMIVER_CATCH
+    }
+
+    void on_draw_signal (const Cairo::RefPtr<Cairo::Context> &)
+    {
+        NEMIVER_TRY
+        if (!is_up2date)
+            refresh ();
+        NEMIVER_CATCH
+    }
+
+    void on_reset_button_clicked ()
+    {
+        NEMIVER_TRY
+        debugger->reset_perf_stats ();
+        refresh ();
+        NEMIVER_CATCH
+    }
+
+    void on_dump_button_clicked ()
+    {
+        NEMIVER_TRY
+        Gtk::FileChooserDialog file_chooser (_("Save Trace"),
+                                             Gtk::FILE_CHOOSER_ACTION_SAVE);
+        file_chooser.add_button (Gtk::Stock::CANCEL, Gtk::RESPONSE_CANCEL);
+        file_chooser.add_button (Gtk::Stock::SAVE, Gtk::RESPONSE_OK);
+        file_chooser.set_do_overwrite_confirmation (true);
+        file_chooser.set_current_name ("nemiver-trace.json");
+
+        if (file_chooser.run () != Gtk::RESPONSE_OK) {
+            LOG_DD ("cancelled");
+            return;
+        }
+
+        UString path = file_chooser.get_filename ();
+        if (path.empty ())
+            return;
+
+        if (!debugger->dump_perf_trace (path)) {
+            UString message;
+            message.printf (_("Could not write the trace to %s"),
+                            path.c_str ());
+            ui_utils::display_error (message);
+        }
+        NEMIVER_CATCH
+    }
+
+};//end struct PerfView::Priv
+
+PerfView::PerfView (IDebuggerSafePtr& a_debugger)
+{
+    m_priv.reset (new Priv (a_debugger));
+}
+
+PerfView::~PerfView ()
+{
+    LOG_D ("deleted", "destructor-domain");
+}
+
+Gtk::Widget&
+PerfView::widget () const
+{
+    THROW_IF_FAIL (m_priv);
+    THROW_IF_FAIL (m_priv->main_box);
+    return *m_priv->main_box;
+}
+
+void
+PerfView::clear ()
+{
+    THROW_IF_FAIL (m_priv);
+
+    m_priv->handlers_list_store->clear ();
+    m_priv->commands_list_store->clear ();
+    m_priv->summary_label->set_text ("");
+    m_priv->is_up2date = false;
+}
+
+}//end namespace nemiver
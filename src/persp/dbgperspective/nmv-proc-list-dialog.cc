@@ -41,12 +41,14 @@ struct ProcListCols : public Gtk::TreeModel::ColumnRecord {
     Gtk::TreeModelColumn<unsigned int> pid;
     Gtk::TreeModelColumn<Glib::ustring> user_name;
     Gtk::TreeModelColumn<Glib::ustring> proc_args;
+    Gtk::TreeModelColumn<bool> visible;
 
     enum ColsOffset {
         PROCESS=0,
         PID,
         USER_NAME,
-        PROC_ARGS
+        PROC_ARGS,
+        VISIBLE
     };
 
     ProcListCols ()
@@ -55,9 +57,14 @@ struct ProcListCols : public Gtk::TreeModel::ColumnRecord {
         add (pid);
         add (user_name);
         add (proc_args);
+        add (visible);
     }
 };//end class Gtk::TreeModel
 
+// The interval, in milliseconds, at which the dialog polls the
+// processes listed in the background.
+static const unsigned PROCESS_LISTING_POLL_INTERVAL = 50;
+
 static ProcListCols&
 columns ()
 {
@@ -81,6 +88,11 @@ public:
     Glib::RefPtr<Gtk::TreeModelSort> sort_store;
     IProcMgr::Process selected_process;
     bool process_selected;
+    // The filter term the visibility of the rows was last computed
+    // against.
+    UString filter_term;
+    // Polls the processes listed by the worker thread of proc_mgr.
+    sigc::connection listing_connection;
 
     Priv (Gtk::Dialog &a_dialog,
           const Glib::RefPtr<Gtk::Builder> &a_gtkbuilder,
@@ -115,8 +127,7 @@ public:
         THROW_IF_FAIL (proclist_view);
         proclist_store = Gtk::ListStore::create (columns ());
         filter_store = Gtk::TreeModelFilter::create (proclist_store);
-        filter_store->set_visible_func (sigc::mem_fun
-                                        (*this, &Priv::is_row_visible));
+        filter_store->set_visible_column (columns ().visible);
         sort_store = Gtk::TreeModelSort::create (filter_store);
         proclist_view->set_model (sort_store);
         proclist_view->set_search_column (ProcListCols::PROC_ARGS);
@@ -153,12 +164,37 @@ public:
                 (*this, &Priv::on_row_activated_signal));
     }
 
+    ~Priv ()
+    {
+        listing_connection.disconnect ();
+    }
+
+    /// Update the visibility of the rows after the filter term
+    /// changed.  If the new term contains the previous one, only the
+    /// rows that are visible can match it, so only these are
+    /// considered.
     void on_filter_entry_changed ()
     {
         NEMIVER_TRY
 
+        UString new_term = entry_filter->get_text ();
+        bool narrowing = new_term.find (filter_term) != UString::npos;
+        filter_term = new_term;
+
         nb_filtered_results = 0;
-        filter_store->refilter ();
+        Gtk::TreeModel::iterator it;
+        for (it = proclist_store->children ().begin ();
+             it != proclist_store->children ().end ();
+             ++it) {
+            bool was_visible = (*it)[columns ().visible];
+            if (narrowing && !was_visible)
+                continue;
+            bool visible = is_row_visible (it);
+            if (visible)
+                ++nb_filtered_results;
+            if (visible != was_visible)
+                (*it)[columns ().visible] = visible;
+        }
         if (nb_filtered_results == 1) {
             LOG_DD ("A unique row resulted from filtering. Select it!");
             proclist_view->get_selection ()->select
@@ -168,21 +204,20 @@ public:
         NEMIVER_CATCH
     }
 
+    /// \return true if the row matches the current filter term.
     bool is_row_visible (const Gtk::TreeModel::const_iterator &iter)
     {
-        UString filter_term = entry_filter->get_text ();
+        if (filter_term.empty ())
+            return true;
+
         UString proc = iter->get_value (columns ().proc_args);
         UString user_name = iter->get_value (columns ().user_name);
         UString pid = UString::from_int (iter->get_value (columns ().pid));
 
         // show the row if the search term matches any of the columns
-        bool result = proc.find (filter_term) != UString::npos
-                      || user_name.find (filter_term) != UString::npos
-                      || pid.find (filter_term) != UString::npos;
-        if (result) {
-            ++nb_filtered_results;
-        }
-        return result;
+        return proc.find (filter_term) != UString::npos
+               || user_name.find (filter_term) != UString::npos
+               || pid.find (filter_term) != UString::npos;
     }
 
     void on_selection_changed_signal ()
@@ -204,8 +239,7 @@ public:
 
             Gtk::TreeModel::const_iterator row_it =
                                         sort_store->get_iter (paths[0]);
-            if (row_it != sort_store->children ().end ()
-                && is_row_visible(row_it)) {
+            if (row_it != sort_store->children ().end ()) {
                 selected_process = (*row_it)[columns ().process];
                 process_selected = true;
                 okbutton->set_sensitive (true);
@@ -238,21 +272,22 @@ public:
         NEMIVER_CATCH
     }
 
-    void load_process_list ()
+    /// Append the processes listed so far by proc_mgr to the model.
+    ///
+    /// \return true if the listing is complete.
+    bool append_listed_processes ()
     {
-        process_selected = false;
+        list<IProcMgr::Process> process_list;
+        bool done = proc_mgr.fetch_listed_processes (process_list);
+
         Gtk::TreeModel::iterator store_it;
-        list<IProcMgr::Process> process_list =
-                            proc_mgr.get_all_process_list ();
         list<IProcMgr::Process>::iterator process_iter;
-        list<UString> args;
-        list<UString>::iterator str_iter;
+        list<UString>::const_iterator str_iter;
         UString args_str;
-        proclist_store->clear ();
         for (process_iter = process_list.begin ();
              process_iter != process_list.end ();
              ++process_iter) {
-            args = process_iter->args ();
+            const list<UString> &args = process_iter->args ();
             if (args.empty ()) {continue;}
             store_it = proclist_store->append ();
             (*store_it)[columns ().pid] = process_iter->pid ();
@@ -265,7 +300,36 @@ public:
             }
             (*store_it)[columns ().proc_args] = args_str;
             (*store_it)[columns ().process] = *process_iter;
+            (*store_it)[columns ().visible] = is_row_visible (store_it);
         }
+        return done;
+    }
+
+    bool on_listing_timeout ()
+    {
+        NEMIVER_TRY
+        // Returning false stops the polling once the listing is
+        // complete.
+        return !append_listed_processes ();
+        NEMIVER_CATCH_AND_RETURN (false)
+    }
+
+    /// Start listing the processes in the background.  The rows
+    /// are added to the model by batches as they come in, so that the
+    /// dialog shows up right away.
+    void load_process_list ()
+    {
+        process_selected = false;
+        filter_term = entry_filter->get_text ();
+        proclist_store->clear ();
+        listing_connection.disconnect ();
+
+        proc_mgr.start_listing_processes ();
+        if (append_listed_processes ())
+            return;
+        listing_connection = Glib::signal_timeout ().connect
+            (sigc::mem_fun (*this, &Priv::on_listing_timeout),
+             PROCESS_LISTING_POLL_INTERVAL);
     }
 };//end class ProcListDialog::Priv
 
@@ -282,7 +346,9 @@ gint ProcListDialog::run ()
 {
     THROW_IF_FAIL (m_priv);
     m_priv->load_process_list();
-    return Dialog::run();
+    gint result = Dialog::run();
+    m_priv->listing_connection.disconnect ();
+    return result;
 }
 
 ProcListDialog::~ProcListDialog ()
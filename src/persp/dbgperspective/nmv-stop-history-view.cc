@@ -0,0 +1,434 @@
+//Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#include "config.h"
+#include <set>
+#include <glib/gi18n.h>
+#include <gtkmm/box.h>
+#include <gtkmm/label.h>
+#include <gtkmm/scale.h>
+#include <gtkmm/paned.h>
+#include <gtkmm/scrolledwindow.h>
+#include <gtkmm/treeview.h>
+#include <gtkmm/liststore.h>
+#include <gtkmm/treestore.h>
+#include "common/nmv-exception.h"
+#include "nmv-stop-history-view.h"
+#include "nmv-stop-history.h"
+
+namespace nemiver {
+
+struct FrameColumns : public Gtk::TreeModelColumnRecord {
+    Gtk::TreeModelColumn<int> level;
+    Gtk::TreeModelColumn<Glib::ustring> function_name;
+    Gtk::TreeModelColumn<Glib::ustring> location;
+    Gtk::TreeModelColumn<Glib::ustring> address;
+
+    FrameColumns ()
+    {
+        add (level);
+        add (function_name);
+        add (location);
+        add (address);
+    }
+};//end FrameColumns
+
+struct ValueColumns : public Gtk::TreeModelColumnRecord {
+    Gtk::TreeModelColumn<Glib::ustring> name;
+    Gtk::TreeModelColumn<Glib::ustring> value;
+    Gtk::TreeModelColumn<Gdk::Color> fg_color;
+
+    ValueColumns ()
+    {
+        add (name);
+        add (value);
+        add (fg_color);
+    }
+};//end ValueColumns
+
+static FrameColumns&
+get_frame_columns ()
+{
+    static FrameColumns s_cols;
+    return s_cols;
+}
+
+static ValueColumns&
+get_value_columns ()
+{
+    static ValueColumns s_cols;
+    return s_cols;
+}
+
+/// \return a human readable form of the reason of a stop.
+static UString
+stop_reason_to_string (IDebugger::StopReason a_reason)
+{
+    switch (a_reason) {
+        case IDebugger::BREAKPOINT_HIT:
+            return _("breakpoint hit");
+        case IDebugger::WATCHPOINT_TRIGGER:
+        case IDebugger::READ_WATCHPOINT_TRIGGER:
+        case IDebugger::ACCESS_WATCHPOINT_TRIGGER:
+        case IDebugger::WATCHPOINT_SCOPE:
+            return _("watchpoint triggered");
+        case IDebugger::FUNCTION_FINISHED:
+            return _("function finished");
+        case IDebugger::LOCATION_REACHED:
+            return _("location reached");
+        case IDebugger::END_STEPPING_RANGE:
+            return _("step");
+        case IDebugger::SIGNAL_RECEIVED:
+            return _("signal received");
+        default:
+            return _("stopped");
+    }
+}
+
+static UString
+frame_location (const IDebugger::Frame &a_frame)
+{
+    if (a_frame.file_name ().empty ())
+        return a_frame.library ();
+    return a_frame.file_name () + ":" + UString::from_int (a_frame.line ());
+}
+
+struct StopHistoryView::Priv {
+public:
+    IDebuggerSafePtr& debugger;
+    SafePtr<Gtk::Box> main_box;
+    SafePtr<Gtk::Label> stop_label;
+    SafePtr<Gtk::Scale> scale;
+    SafePtr<Gtk::TreeView> frames_tree_view;
+    Glib::RefPtr<Gtk::ListStore> frames_list_store;
+    SafePtr<Gtk::TreeView> values_tree_view;
+    Glib::RefPtr<Gtk::TreeStore> values_tree_store;
+    sigc::connection refresh_connection;
+    // True if the view should show each new stop as it is recorded,
+    // i.e, unless the user is looking at an older stop.
+    bool follow_latest_stop;
+    // True while the range of the scale is being updated.
+    bool is_setting_range;
+    bool is_up2date;
+
+    Priv (IDebuggerSafePtr& a_debugger) :
+        debugger (a_debugger),
+        follow_latest_stop (true),
+        is_setting_range (false),
+        is_up2date (true)
+    {
+        build_widget ();
+
+        debugger->get_stop_history ().changed_signal ().connect
+            (sigc::mem_fun (*this, &Priv::on_stop_history_changed_signal));
+    }
+
+    ~Priv ()
+    {
+        refresh_connection.disconnect ();
+    }
+
+    const StopHistory& stop_history () const
+    {
+        return debugger->get_stop_history ();
+    }
+
+    Gtk::ScrolledWindow*
+    wrap_in_scrolled_window (Gtk::Widget &a_widget)
+    {
+        Gtk::ScrolledWindow *scr = Gtk::manage (new Gtk::ScrolledWindow);
+        scr->set_policy (Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+        scr->set_shadow_type (Gtk::SHADOW_IN);
+        scr->add (a_widget);
+        return scr;
+    }
+
+    void build_widget ()
+    {
+        if (main_box) {return;}
+
+        main_box.reset (new Gtk::Box (Gtk::ORIENTATION_VERTICAL, 4));
+
+        stop_label.reset (new Gtk::Label);
+        stop_label->set_alignment (0, 0.5);
+        stop_label->set_selectable (true);
+        main_box->pack_start (*stop_label, Gtk::PACK_SHRINK);
+
+        scale.reset (new Gtk::Scale (Gtk::ORIENTATION_HORIZONTAL));
+        scale->set_digits (0);
+        scale->set_draw_value (false);
+        scale->set_increments (1, 10);
+        scale->set_tooltip_text (_("Go back to a previous stop"));
+        scale->signal_value_changed ().connect
+            (sigc::mem_fun (*this, &Priv::on_scale_value_changed_signal));
+        main_box->pack_start (*scale, Gtk::PACK_SHRINK);
+
+        frames_list_store = Gtk::ListStore::create (get_frame_columns ());
+        frames_tree_view.reset (new Gtk::TreeView (frames_list_store));
+        frames_tree_view->append_column (_("Level"),
+                                         get_frame_columns ().level);
+        frames_tree_view->append_column (_("Function"),
+                                         get_frame_columns ().function_name);
+        frames_tree_view->append_column (_("Location"),
+                                         get_frame_columns ().location);
+        frames_tree_view->append_column (_("Address"),
+                                         get_frame_columns ().address);
+
+        values_tree_store = Gtk::TreeStore::create (get_value_columns ());
+        values_tree_view.reset (new Gtk::TreeView (values_tree_store));
+        values_tree_view->append_column (_("Name"),
+                                         get_value_columns ().name);
+        values_tree_view->append_column (_("Value"),
+                                         get_value_columns ().value);
+        Gtk::TreeViewColumn *col = values_tree_view->get_column (1);
+        col->add_attribute (*col->get_first_cell (),
+                            "foreground-gdk",
+                            get_value_columns ().fg_color);
+
+        Gtk::Paned *paned =
+            Gtk::manage (new Gtk::Paned (Gtk::ORIENTATION_HORIZONTAL));
+        paned->pack1 (*wrap_in_scrolled_window (*frames_tree_view));
+        paned->pack2 (*wrap_in_scrolled_window (*values_tree_view));
+        main_box->pack_start (*paned, Gtk::PACK_EXPAND_WIDGET);
+
+        main_box->signal_draw ().connect_notify
+            (sigc::mem_fun (*this, &Priv::on_draw_signal));
+        main_box->show_all ();
+    }
+
+    bool should_process_now ()
+    {
+        THROW_IF_FAIL (main_box);
+        return main_box->get_is_drawable ();
+    }
+
+    Gdk::Color normal_color ()
+    {
+        Gdk::RGBA rgba =
+            values_tree_view->get_style_context ()->get_color
+                                                (Gtk::STATE_FLAG_NORMAL);
+        Gdk::Color color;
+        color.set_rgb (rgba.get_red (), rgba.get_green (), rgba.get_blue ());
+        return color;
+    }
+
+    void clear_stop ()
+    {
+        stop_label->set_text (_("No stop recorded"));
+        frames_list_store->clear ();
+        values_tree_store->clear ();
+    }
+
+    void append_value (Gtk::TreeModel::Row &a_parent,
+                       const UString &a_name,
+                       const UString &a_value,
+                       bool a_changed,
+                       const Gdk::Color &a_normal_color)
+    {
+        Gtk::TreeModel::iterator row =
+            values_tree_store->append (a_parent.children ());
+        (*row)[get_value_columns ().name] = a_name;
+        (*row)[get_value_columns ().value] = a_value;
+        (*row)[get_value_columns ().fg_color] =
+            a_changed ? Gdk::Color ("red") : a_normal_color;
+    }
+
+    void show_stop (unsigned a_index)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        StopHistory::Snapshot snapshot;
+        if (!stop_history ().get_snapshot (a_index, snapshot)) {
+            clear_stop ();
+            return;
+        }
+
+        UString text;
+        text.printf (_("Stop %lu (%s) in thread %d, in %s at %s"),
+                     snapshot.stop_number,
+                     stop_reason_to_string (snapshot.reason).c_str (),
+                     snapshot.thread_id,
+                     snapshot.frame.function_name ().c_str (),
+                     frame_location (snapshot.frame).c_str ());
+        stop_label->set_text (text);
+
+        frames_list_store->clear ();
+        std::vector<IDebugger::Frame>::const_iterator f;
+        for (f = snapshot.call_stack.begin ();
+             f != snapshot.call_stack.end ();
+             ++f) {
+            Gtk::TreeModel::iterator row = frames_list_store->append ();
+            (*row)[get_frame_columns ().level] = f->level ();
+            (*row)[get_frame_columns ().function_name] = f->function_name ();
+            (*row)[get_frame_columns ().location] = frame_location (*f);
+            (*row)[get_frame_columns ().address] =
+                f->address ().to_string ();
+        }
+
+        values_tree_store->clear ();
+        Gdk::Color color = normal_color ();
+
+        std::set<StopHistory::register_id_t> changed_registers
+            (snapshot.changed_registers.begin (),
+             snapshot.changed_registers.end ());
+        const std::map<StopHistory::register_id_t, UString> &names =
+            stop_history ().register_names ();
+        Gtk::TreeModel::Row registers_row = *values_tree_store->append ();
+        registers_row[get_value_columns ().name] = _("Registers");
+        std::map<StopHistory::register_id_t, UString>::const_iterator r;
+        for (r = snapshot.registers.begin ();
+             r != snapshot.registers.end ();
+             ++r) {
+            std::map<StopHistory::register_id_t, UString>::const_iterator n =
+                names.find (r->first);
+            UString name = (n != names.end ())
+                ? n->second
+                : UString::from_int (r->first);
+            append_value (registers_row, name, r->second,
+                          changed_registers.count (r->first), color);
+        }
+
+        // Show the variables of the thread that stopped.  Those of
+        // the other frames than the one it stopped in are named
+        // after their function.
+        std::set<StopHistory::VariableKey> changed_variables
+            (snapshot.changed_variables.begin (),
+             snapshot.changed_variables.end ());
+        Gtk::TreeModel::Row variables_row = *values_tree_store->append ();
+        variables_row[get_value_columns ().name] = _("Variables");
+        std::map<StopHistory::VariableKey, UString>::const_iterator v;
+        for (v = snapshot.variables.begin ();
+             v != snapshot.variables.end ();
+             ++v) {
+            const StopHistory::VariableScope &scope = v->first.first;
+            if (scope.thread_id != snapshot.thread_id)
+                continue;
+            UString name = v->first.second;
+            if (!scope.function_name.empty ()
+                && scope.function_name != snapshot.frame.function_name ())
+                name += " (" + scope.function_name + ")";
+            append_value (variables_row, name, v->second,
+                          changed_variables.count (v->first), color);
+        }
+        values_tree_view->expand_row
+            (values_tree_store->get_path (variables_row), false);
+    }
+
+    void refresh ()
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        unsigned size = stop_history ().size ();
+        if (!size) {
+            scale->set_sensitive (false);
+            clear_stop ();
+            is_up2date = true;
+            return;
+        }
+        scale->set_sensitive (size > 1);
+        is_setting_range = true;
+        scale->set_range (0, size > 1 ? size - 1 : 1);
+        if (follow_latest_stop)
+            scale->set_value (size - 1);
+        is_setting_range = false;
+        show_stop ((unsigned) scale->get_value ());
+        is_up2date = true;
+    }
+
+    bool on_refresh_idle ()
+    {
+        NEMIVER_TRY
+        if (should_process_now ()) {
+            refresh ();
+        } else {
+            is_up2date = false;
+        }
+        NEMIVER_CATCH
+        // This is a one shot idle handler.
+        return false;
+    }
+
+    void on_stop_history_changed_signal ()
+    {
+        NEMIVER_TRY
+        // A single stop is reported through many changes of the
+        // history; show them all at once.
+        if (refresh_connection.connected ())
+            return;
+        refresh_connection = Glib::signal_idle ().connect
+            (sigc::mem_fun (*this, &Priv::on_refresh_idle));
+        NEMIVER_CATCH
+    }
+
+    void on_scale_value_changed_signal ()
+    {
+        NEMIVER_TRY
+        unsigned size = stop_history ().size ();
+        if (is_setting_range || !size)
+            return;
+        unsigned index = (unsigned) scale->get_value ();
+        follow_latest_stop = (index + 1 >= size);
+        show_stop (index);
+        NEMIVER_CATCH
+    }
+
+    void on_draw_signal (const Cairo::RefPtr<Cairo::Context> &)
+    {
+        NEMIVER_TRY
+        if (!is_up2date)
+            refresh ();
+        NEMIVER_CATCH
+    }
+
+};//end struct StopHistoryView::Priv
+
+StopHistoryView::StopHistoryView (IDebuggerSafePtr& a_debugger)
+{
+    m_priv.reset (new Priv (a_debugger));
+}
+
+StopHistoryView::~StopHistoryView ()
+{
+    LOG_D ("deleted", "destructor-domain");
+}
+
+Gtk::Widget&
+StopHistoryView::widget () const
+{
+    THROW_IF_FAIL (m_priv);
+    THROW_IF_FAIL (m_priv->main_box);
+    return *m_priv->main_box;
+}
+
+void
+StopHistoryView::clear ()
+{
+    THROW_IF_FAIL (m_priv);
+
+    m_priv->clear_stop ();
+    m_priv->follow_latest_stop = true;
+    m_priv->is_up2date = false;
+}
+
+}//end namespace nemiver
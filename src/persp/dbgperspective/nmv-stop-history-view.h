@@ -0,0 +1,61 @@
+//Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+#ifndef __NMV_STOP_HISTORY_VIEW_H__
+#define __NMV_STOP_HISTORY_VIEW_H__
+
+#include <gtkmm/widget.h>
+#include "common/nmv-object.h"
+#include "common/nmv-safe-ptr-utils.h"
+#include "nmv-i-debugger.h"
+
+NEMIVER_BEGIN_NAMESPACE (nemiver)
+
+/// A view that lets the user go back through the recent stops of
+/// the inferior.  For the selected stop, it shows the frame the
+/// inferior stopped in, its call stack, and the registers and
+/// variables values that were seen during that stop; the ones that
+/// changed during that stop are highlighted.  All this comes from
+/// the stop history kept by the debugging engine, so going back and
+/// forth doesn't involve GDB at all.
+class NEMIVER_API StopHistoryView : public nemiver::common::Object {
+    //non copyable
+    StopHistoryView (const StopHistoryView&);
+    StopHistoryView& operator= (const StopHistoryView&);
+
+    struct Priv;
+    SafePtr<Priv> m_priv;
+
+public:
+
+    StopHistoryView (IDebuggerSafePtr& a_debugger);
+    virtual ~StopHistoryView ();
+    Gtk::Widget& widget () const;
+    void clear ();
+
+};//end StopHistoryView
+
+NEMIVER_END_NAMESPACE (nemiver)
+
+#endif //__NMV_STOP_HISTORY_VIEW_H__
@@ -35,10 +35,12 @@ NEMIVER_BEGIN_NAMESPACE (nemiver)
 
 struct ThreadListColumns : public Gtk::TreeModelColumnRecord {
     Gtk::TreeModelColumn<int> thread_id;
+    Gtk::TreeModelColumn<Glib::ustring> state;
 
     ThreadListColumns ()
     {
         add (thread_id);
+        add (state);
     }
 };//end class ThreadListColumns
 
@@ -140,6 +142,26 @@ struct ThreadList::Priv {
         NEMIVER_CATCH
     }
 
+    void on_debugger_thread_state_changed_signal (int a_tid,
+                                                  bool /*a_is_running*/)
+    {
+        LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+        NEMIVER_TRY
+
+        THROW_IF_FAIL (list_store);
+        Gtk::TreeModel::iterator it;
+        for (it = list_store->children ().begin ();
+             it != list_store->children ().end ();
+             ++it) {
+            int tid = it->get_value (thread_list_columns ().thread_id);
+            if (a_tid == -1 || tid == a_tid)
+                set_thread_state (it, tid);
+        }
+
+        NEMIVER_CATCH
+    }
+
     void on_draw_signal (const Cairo::RefPtr<Cairo::Context> &)
     {
         LOG_FUNCTION_SCOPE_NORMAL_DD;
@@ -187,6 +209,12 @@ struct ThreadList::Priv {
         THROW_IF_FAIL (column);
         column->set_clickable (false);
         column->set_reorderable (false);
+        // Threads run and stop independently of each other only in
+        // non-stop mode; the state column is shown in that mode.
+        tree_view->append_column (_("State"), thread_list_columns ().state);
+        column = tree_view->get_column (1);
+        THROW_IF_FAIL (column);
+        column->set_visible (false);
     }
 
     void connect_to_debugger_signals ()
@@ -201,6 +229,9 @@ struct ThreadList::Priv {
 
         debugger->thread_selected_signal ().connect (sigc::mem_fun
             (*this, &Priv::on_debugger_thread_selected_signal));
+
+        debugger->thread_state_changed_signal ().connect (sigc::mem_fun
+            (*this, &Priv::on_debugger_thread_state_changed_signal));
     }
 
     void connect_to_widget_signals ()
@@ -220,10 +251,22 @@ struct ThreadList::Priv {
         THROW_IF_FAIL (list_store);
         Gtk::TreeModel::iterator iter = list_store->append ();
         iter->set_value (thread_list_columns ().thread_id, a_id);
+        set_thread_state (iter, a_id);
+    }
+
+    void set_thread_state (Gtk::TreeModel::iterator &a_iter, int a_id)
+    {
+        THROW_IF_FAIL (debugger);
+        a_iter->set_value (thread_list_columns ().state,
+                           Glib::ustring (debugger->is_thread_running (a_id)
+                                          ? _("Running")
+                                          : _("Stopped")));
     }
 
     void set_thread_id_list (const std::list<int> &a_list)
     {
+        tree_view->get_column (1)->set_visible
+                                    (debugger->is_non_stop_mode ());
         std::list<int>::const_iterator it;
         for (it = a_list.begin (); it != a_list.end (); ++it) {
             set_a_thread_id (*it);
@@ -28,6 +28,7 @@
 #include "nmv-variables-utils.h"
 #include "common/nmv-exception.h"
 #include "nmv-ui-utils.h"
+#include "nmv-i-lang-trait.h"
 
 NEMIVER_BEGIN_NAMESPACE (nemiver)
 NEMIVER_BEGIN_NAMESPACE (variables_utils2)
@@ -62,29 +63,26 @@ get_variable_columns ()
     return s_cols;
 }
 
+/// Tell whether a type is a pointer type, using the type descriptors
+/// cached by the language trait of the debugger.
 bool
-is_type_a_pointer (const UString &a_type)
+is_type_a_pointer (IDebugger &a_debugger, const UString &a_type)
 {
-    LOG_FUNCTION_SCOPE_NORMAL_DD;
-    LOG_DD ("type: '" << a_type << "'");
+    return a_debugger.get_language_trait ().get_type_descriptor
+                                                (a_type).is_pointer ();
+}
 
-    UString type (a_type);
-    type.chomp ();
-    if (type[type.size () - 1] == '*') {
-        LOG_DD ("type is a pointer");
-        return true;
-    }
-    if (type.size () < 8) {
-        LOG_DD ("type is not a pointer");
+/// \return true if a variable is a null pointer.  GDB says such a
+/// variable has children, but they can't be read.
+static bool
+is_null_pointer (const IDebugger::VariableSafePtr a_var)
+{
+    if (!a_var
+        || !a_var->debugger ()
+        || a_var->type ().empty ()
+        || a_var->value ().raw () != "0x0")
         return false;
-    }
-    UString::size_type i = type.size () - 7;
-    if (!a_type.compare (i, 7, "* const")) {
-        LOG_DD ("type is a pointer");
-        return true;
-    }
-    LOG_DD ("type is not a pointer");
-    return false;
+    return is_type_a_pointer (*a_var->debugger (), a_var->type ());
 }
 
 /// Populate the type information of the graphical node representing
@@ -208,6 +206,21 @@ update_a_variable_node (const IDebugger::VariableSafePtr a_var,
     LOG_DD ("Updated variable value to " << a_var->value ());
     set_a_variable_node_type (a_iter,  a_var->type (), a_truncate_type);
     LOG_DD ("Updated variable type to " << a_var->type ());
+
+    // Let the user unfold the variable, unless it is a null pointer.
+    // A pointer that was null when its node was made gets unfoldable
+    // as soon as it points somewhere.
+    if (a_var->needs_unfolding ()
+        && !(*a_iter)[get_variable_columns ().needs_unfolding]
+        && a_iter->children ().empty ()
+        && !is_null_pointer (a_var)) {
+        // Mark *a_iter as needing unfolding, and add an empty
+        // child node to it
+        (*a_iter)[get_variable_columns ().needs_unfolding] = true;
+        IDebugger::VariableSafePtr empty_var;
+        append_a_variable (empty_var, a_tree_view,
+                           a_iter, a_truncate_type);
+    }
 }
 
 
@@ -706,15 +719,10 @@ set_a_variable (const IDebugger::VariableSafePtr a_var,
     update_a_variable_node (a_var, a_tree_view, a_row_it,
                             a_truncate_type, true, true);
 
+    // update_a_variable_node made *a_row_it unfoldable if a_var
+    // needs unfolding.
     list<IDebugger::VariableSafePtr>::const_iterator it;
-    if (a_var->needs_unfolding ()) {
-        // Mark *row_it as needing unfolding, and add an empty
-        // child node to it
-        (*a_row_it)[get_variable_columns ().needs_unfolding] = true;
-        IDebugger::VariableSafePtr empty_var;
-        append_a_variable (empty_var, a_tree_view,
-                           a_row_it, a_truncate_type);
-    } else {
+    if (!a_var->needs_unfolding ()) {
         for (it = a_var->members ().begin ();
              it != a_var->members ().end ();
              ++it) {
@@ -75,7 +75,7 @@ struct VariableColumns : public Gtk::TreeModelColumnRecord {
 
 VariableColumns& get_variable_columns ();
 
-bool is_type_a_pointer (const UString &a_type);
+bool is_type_a_pointer (IDebugger &a_debugger, const UString &a_type);
 
 void set_a_variable_node_type (Gtk::TreeModel::iterator &a_var_it,
                                const UString &a_type,
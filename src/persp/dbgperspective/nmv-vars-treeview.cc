@@ -31,6 +31,11 @@ namespace vutil = nemiver::variables_utils2;
 
 NEMIVER_BEGIN_NAMESPACE (nemiver)
 
+/// How many rows above and below the viewport
+/// get_root_rows_near_viewport reports, so that the values are
+/// already there when the user scrolls a bit.
+static const int VIEWPORT_MARGIN = 20;
+
 VarsTreeView*
 VarsTreeView::create ()
 {
@@ -72,6 +77,19 @@ VarsTreeView::VarsTreeView (Glib::RefPtr<Gtk::TreeStore>& model) :
     col = get_column (VARIABLE_TYPE_COLUMN_INDEX);
     THROW_IF_FAIL (col);
     col->set_resizable (true);
+
+    // The scrolled window the view is packed into hands it a new
+    // vertical adjustment; follow it.
+    property_vadjustment ().signal_changed ().connect
+        (sigc::mem_fun (*this, &VarsTreeView::connect_to_vadjustment));
+    connect_to_vadjustment ();
+}
+
+VarsTreeView::~VarsTreeView ()
+{
+    m_vadjustment_value_connection.disconnect ();
+    m_vadjustment_changed_connection.disconnect ();
+    m_visible_rows_idle_connection.disconnect ();
 }
 
 Glib::RefPtr<Gtk::TreeStore>&
@@ -80,5 +98,88 @@ VarsTreeView::get_tree_store ()
     return m_tree_store;
 }
 
+sigc::signal<void>&
+VarsTreeView::visible_rows_changed_signal ()
+{
+    return m_visible_rows_changed_signal;
+}
+
+/// Get the top level rows that are in the viewport, plus
+/// VIEWPORT_MARGIN rows on each side of it.
+///
+/// \param a_rows the resulting rows, in model order.  It is left
+/// empty if the view is not realized yet.
+void
+VarsTreeView::get_root_rows_near_viewport
+                        (std::vector<Gtk::TreeModel::iterator> &a_rows)
+{
+    a_rows.clear ();
+
+    Gtk::TreeModel::Path start, end;
+    if (!m_tree_store
+        || !get_visible_range (start, end)
+        || start.empty ()
+        || end.empty ())
+        return;
+
+    int first = start[0] - VIEWPORT_MARGIN;
+    if (first < 0)
+        first = 0;
+    int last = end[0] + VIEWPORT_MARGIN;
+
+    Gtk::TreeModel::Children rows = m_tree_store->children ();
+    if (last >= (int) rows.size ())
+        last = rows.size () - 1;
+    if (first > last)
+        return;
+
+    Gtk::TreeModel::iterator it = rows[first];
+    for (int i = first; i <= last && it; ++i, ++it)
+        a_rows.push_back (it);
+}
+
+void
+VarsTreeView::connect_to_vadjustment ()
+{
+    m_vadjustment_value_connection.disconnect ();
+    m_vadjustment_changed_connection.disconnect ();
+
+    m_vadjustment = get_vadjustment ();
+    if (!m_vadjustment)
+        return;
+
+    // "value-changed" is a scroll; "changed" is a change of the
+    // page size or of the upper bound, i.e, a resize or rows being
+    // added or removed.
+    m_vadjustment_value_connection =
+        m_vadjustment->signal_value_changed ().connect
+        (sigc::mem_fun (*this, &VarsTreeView::queue_visible_rows_changed));
+    m_vadjustment_changed_connection =
+        m_vadjustment->signal_changed ().connect
+        (sigc::mem_fun (*this, &VarsTreeView::queue_visible_rows_changed));
+    queue_visible_rows_changed ();
+}
+
+void
+VarsTreeView::queue_visible_rows_changed ()
+{
+    // Adjustments fire a lot while rows are being appended or
+    // while the user drags the scrollbar.  Coalesce that into a
+    // single emission once things have settled.
+    if (m_visible_rows_idle_connection.connected ())
+        return;
+    m_visible_rows_idle_connection = Glib::signal_idle ().connect
+        (sigc::mem_fun (*this, &VarsTreeView::on_visible_rows_changed_idle));
+}
+
+bool
+VarsTreeView::on_visible_rows_changed_idle ()
+{
+    NEMIVER_TRY
+    m_visible_rows_changed_signal.emit ();
+    NEMIVER_CATCH
+    return false;
+}
+
 NEMIVER_END_NAMESPACE (nemiver)
 
@@ -25,8 +25,10 @@
 #ifndef __NMV_VARS_TREEVIEW_H__
 #define __NMV_VARS_TREEVIEW_H__
 
+#include <vector>
 #include <gtkmm/treeview.h>
 #include <gtkmm/treestore.h>
+#include <gtkmm/adjustment.h>
 #include "common/nmv-safe-ptr.h"
 #include "nmv-ui-utils.h"
 
@@ -48,14 +50,34 @@ class NEMIVER_API VarsTreeView : public Gtk::TreeView
             VARIABLE_TYPE_COLUMN_INDEX
         };
         static VarsTreeView* create ();
+        virtual ~VarsTreeView ();
         Glib::RefPtr<Gtk::TreeStore>& get_tree_store ();
 
+        /// Emitted, from an idle handler, when the set of rows
+        /// showing in the viewport might have changed, i.e, after a
+        /// scroll, a resize or rows being added or removed.  Views
+        /// that want to query the debugger only for the variables
+        /// the user can actually see listen to this.
+        sigc::signal<void>& visible_rows_changed_signal ();
+
+        void get_root_rows_near_viewport
+                            (std::vector<Gtk::TreeModel::iterator> &a_rows);
+
     protected:
         VarsTreeView ();
         VarsTreeView (Glib::RefPtr<Gtk::TreeStore>& model);
 
     private:
+        void connect_to_vadjustment ();
+        void queue_visible_rows_changed ();
+        bool on_visible_rows_changed_idle ();
+
         Glib::RefPtr<Gtk::TreeStore> m_tree_store;
+        Glib::RefPtr<Gtk::Adjustment> m_vadjustment;
+        sigc::connection m_vadjustment_value_connection;
+        sigc::connection m_vadjustment_changed_connection;
+        sigc::connection m_visible_rows_idle_connection;
+        sigc::signal<void> m_visible_rows_changed_signal;
 };
 NEMIVER_END_NAMESPACE (nemiver)
 #endif // __NMV_VARS_TREEVIEW_H__
@@ -1039,6 +1039,30 @@ SourceEditor::clear_decorations ()
     unset_where_marker ();
 }
 
+/// Drop the text and the markers of the buffers of the editor to
+/// free the memory they use.  The editor is left with an empty
+/// non-assembly source buffer, but keeps its path, as well as the
+/// line and column the cursor was at.  The content of the file can
+/// then be loaded again into that buffer.
+void
+SourceEditor::release_source_buffers ()
+{
+    LOG_FUNCTION_SCOPE_NORMAL_DD;
+
+    int line = m_priv->non_asm_ctxt.current_line;
+    int column = m_priv->non_asm_ctxt.current_column;
+
+    m_priv->non_asm_ctxt.markers.clear ();
+    m_priv->asm_ctxt.markers.clear ();
+    m_priv->asm_ctxt.buffer.reset ();
+
+    Glib::RefPtr<Buffer> empty_buffer = create_source_buffer ();
+    m_priv->register_non_assembly_source_buffer (empty_buffer);
+
+    m_priv->non_asm_ctxt.current_line = line;
+    m_priv->non_asm_ctxt.current_column = column;
+}
+
 bool
 SourceEditor::is_visual_breakpoint_set_at_line (int a_line) const
 {
@@ -93,6 +93,7 @@ public:
 					bool a_enabled);
     bool remove_visual_breakpoint_from_line (int a_line);
     void clear_decorations ();
+    void release_source_buffers ();
     bool is_visual_breakpoint_set_at_line (int a_line) const;
     bool scroll_to_line (int a_line);
     void scroll_to_iter (Gtk::TextIter &a_iter);
@@ -26,6 +26,7 @@
 #include "nmv-terminal.h"
 #if !(defined(__FreeBSD__) || defined(__OpenBSD__))
 # include <pty.h>
+# include <sys/ioctl.h>
 #else
 # include <sys/types.h>
 # include <sys/ioctl.h>
@@ -37,6 +38,10 @@
 #endif
 #endif
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <cstring>
+#include <algorithm>
 #include <iostream>
 #include <tr1/tuple>
 #include <gtkmm/bin.h>
@@ -44,6 +49,11 @@
 #include <gtkmm/window.h>
 #include <gtkmm/adjustment.h>
 #include <gtkmm/menu.h>
+#include <gtkmm/dialog.h>
+#include <gtkmm/entry.h>
+#include <gtkmm/spinbutton.h>
+#include <gtkmm/label.h>
+#include <gtkmm/stock.h>
 #include <gtkmm/builder.h>
 #include <gtkmm/uimanager.h>
 #include <vte/vte.h>
@@ -51,12 +61,33 @@
 #include "common/nmv-exception.h"
 #include "common/nmv-log-stream-utils.h"
 #include "common/nmv-env.h"
+#include "common/nmv-output-log.h"
 #include "nmv-ui-utils.h"
 
 NEMIVER_BEGIN_NAMESPACE(nemiver)
 
 using namespace common;
 
+// The number of lines the terminal widget keeps.  The whole output
+// is kept in the output log anyway.
+static const int SCROLLBACK_LINES = 1000;
+
+// The size of the chunks read from the master pty.
+static const size_t READ_CHUNK_SIZE = 16 * 1024;
+
+// The maximum number of bytes read from the master pty before
+// letting the main loop handle other events.
+static const size_t MAX_READ_PER_WAKEUP = 256 * 1024;
+
+// The interval, in milliseconds, at which the new output is rendered
+// by the terminal widget.
+static const unsigned RENDER_INTERVAL = 50;
+
+// The maximum number of bytes rendered by the terminal widget at each
+// interval.  If more output than that came in, only its last lines
+// are rendered.
+static const size_t MAX_RENDERED_BYTES = 128 * 1024;
+
 typedef std::tr1::tuple<VteTerminal*&,
                    Gtk::Menu*&,
                    Glib::RefPtr<Gtk::ActionGroup>&> TerminalPrivDataTuple;
@@ -111,6 +142,24 @@ struct Terminal::Priv {
     // Point to vte, menu, and action_group variables
     // Used by the on_button_press_signal event to show contextual menu
     TerminalPrivDataTuple popup_user_data;
+    // Everything the inferior wrote to the terminal.
+    OutputLog output_log;
+    // The offset in output_log up to which the output was rendered
+    // by the terminal widget.  It includes the bytes discarded from
+    // the log, so that it stays valid when the log gets trimmed.
+    size_t rendered_offset;
+    // The input typed in the terminal widget that the inferior
+    // didn't read yet.
+    std::string pending_input;
+    // The text last looked for in the output, and the line it was
+    // last found at, so that looking for it again finds the next
+    // occurrence.
+    UString searched_text;
+    size_t found_line;
+    bool found;
+    sigc::connection master_pty_connection;
+    sigc::connection master_pty_writable_connection;
+    sigc::connection render_connection;
 
     Priv (const string &a_menu_file_path,
           const Glib::RefPtr<Gtk::UIManager> &a_ui_manager) :
@@ -120,7 +169,10 @@ struct Terminal::Priv {
         widget (0),
         adjustment (0),
         menu (0),
-        popup_user_data (vte, menu, action_group)
+        popup_user_data (vte, menu, action_group),
+        rendered_offset (0),
+        found_line (0),
+        found (false)
     {
         init_actions ();
         init_body (a_menu_file_path, a_ui_manager);
@@ -137,7 +189,7 @@ struct Terminal::Priv {
         vte_terminal_set_font_from_string (vte, "monospace");
 
         vte_terminal_set_scroll_on_output (vte, TRUE);
-        vte_terminal_set_scrollback_lines (vte, 1000);
+        vte_terminal_set_scrollback_lines (vte, SCROLLBACK_LINES);
         vte_terminal_set_emulation (vte, "xterm");
 
         widget = Glib::wrap (w);
@@ -163,6 +215,15 @@ struct Terminal::Priv {
                           "button-press-event",
                           G_CALLBACK (on_button_press_signal),
                           &popup_user_data);
+        g_signal_connect (vte,
+                          "commit",
+                          G_CALLBACK (&Terminal::Priv::on_commit_signal),
+                          this);
+        g_signal_connect (vte,
+                          "size-allocate",
+                          G_CALLBACK
+                                (&Terminal::Priv::on_size_allocate_signal),
+                          this);
     }
 
     void init_actions ()
@@ -189,6 +250,138 @@ struct Terminal::Priv {
                  _("Reset the terminal")),
                  sigc::mem_fun (*this,
                                 &Terminal::Priv::on_reset_signal));
+        action_group->add (Gtk::Action::create
+                ("FindOutputAction",
+                 Gtk::Stock::FIND,
+                 _("_Find in Output..."),
+                 _("Look for a text in the whole output of the program")),
+                 sigc::mem_fun (*this,
+                                &Terminal::Priv::on_find_output_signal));
+        action_group->add (Gtk::Action::create
+                ("ShowOutputAtStopAction",
+                 Gtk::StockID (""),
+                 _("_Show Output at Stop..."),
+                 _("Show the output the program wrote after a given stop")),
+                 sigc::mem_fun
+                    (*this, &Terminal::Priv::on_show_output_at_stop_signal));
+    }
+
+    void on_find_output_signal ()
+    {
+        NEMIVER_TRY
+
+        UString text = searched_text;
+        if (!ask_text_to_find (text))
+            return;
+        find_output (text);
+
+        NEMIVER_CATCH
+    }
+
+    void on_show_output_at_stop_signal ()
+    {
+        NEMIVER_TRY
+
+        size_t nb_stops = output_log.num_stops ();
+        if (!nb_stops) {
+            ui_utils::display_info (_("The program has not stopped yet"));
+            return;
+        }
+        size_t stop = nb_stops - 1;
+        if (!ask_stop_to_show (nb_stops, stop))
+            return;
+        if (!show_output_at_stop (stop))
+            ui_utils::display_info
+                (_("The output of that stop is not kept anymore"));
+
+        NEMIVER_CATCH
+    }
+
+    /// Ask the user for the text to look for in the output.
+    ///
+    /// \param a_text in/out parameter.  The text proposed to the
+    /// user, then the text the user chose.
+    ///
+    /// \return true if the user chose a text, false otherwise.
+    bool ask_text_to_find (UString &a_text)
+    {
+        Gtk::Dialog dialog (_("Find in Output"), true);
+        dialog.add_button (Gtk::Stock::CANCEL, Gtk::RESPONSE_CANCEL);
+        dialog.add_button (Gtk::Stock::FIND, Gtk::RESPONSE_OK);
+        dialog.set_default_response (Gtk::RESPONSE_OK);
+
+        Gtk::Label label (_("Text to look for:"), Gtk::ALIGN_START);
+        Gtk::Entry entry;
+        entry.set_text (a_text);
+        entry.set_activates_default (true);
+        dialog.get_vbox ()->pack_start (label, false, false, 6);
+        dialog.get_vbox ()->pack_start (entry, false, false, 6);
+        dialog.show_all ();
+
+        if (dialog.run () != Gtk::RESPONSE_OK
+            || entry.get_text ().empty ())
+            return false;
+        a_text = entry.get_text ();
+        return true;
+    }
+
+    /// Ask the user for the stop to show the output of.
+    ///
+    /// \param a_nb_stops the number of stops of the inferior.
+    ///
+    /// \param a_stop in/out parameter.  The stop proposed to the
+    /// user, then the stop the user chose.
+    ///
+    /// \return true if the user chose a stop, false otherwise.
+    bool ask_stop_to_show (size_t a_nb_stops, size_t &a_stop)
+    {
+        Gtk::Dialog dialog (_("Show Output at Stop"), true);
+        dialog.add_button (Gtk::Stock::CANCEL, Gtk::RESPONSE_CANCEL);
+        dialog.add_button (Gtk::Stock::OK, Gtk::RESPONSE_OK);
+        dialog.set_default_response (Gtk::RESPONSE_OK);
+
+        Gtk::Label label (_("Show the output written after stop:"),
+                          Gtk::ALIGN_START);
+        Gtk::SpinButton spin;
+        spin.set_range (0, a_nb_stops - 1);
+        spin.set_increments (1, 10);
+        spin.set_digits (0);
+        spin.set_value (a_stop);
+        spin.set_activates_default (true);
+        dialog.get_vbox ()->pack_start (label, false, false, 6);
+        dialog.get_vbox ()->pack_start (spin, false, false, 6);
+        dialog.show_all ();
+
+        if (dialog.run () != Gtk::RESPONSE_OK)
+            return false;
+        a_stop = spin.get_value_as_int ();
+        return true;
+    }
+
+    /// Look for a text in the whole output log, and show the output
+    /// from the line it is found at.  Looking for the same text
+    /// again finds its next occurrence, and wraps around at the end
+    /// of the log.
+    void find_output (const UString &a_text)
+    {
+        size_t from = 0;
+        if (found && a_text == searched_text)
+            from = found_line + 1;
+        searched_text = a_text;
+
+        size_t line = 0;
+        found = output_log.find (a_text.raw (), from, line);
+        if (!found && from)
+            found = output_log.find (a_text.raw (), 0, line);
+        if (!found) {
+            UString msg;
+            msg.printf (_("Could not find \"%s\" in the output"),
+                        a_text.c_str ());
+            ui_utils::display_info (msg);
+            return;
+        }
+        found_line = line;
+        show_output_from_line (line);
     }
 
     void on_reset_signal ()
@@ -238,6 +431,10 @@ struct Terminal::Priv {
 
     ~Priv ()
     {
+        master_pty_connection.disconnect ();
+        master_pty_writable_connection.disconnect ();
+        render_connection.disconnect ();
+
         if (slave_pty) {
             close (slave_pty);
             slave_pty = 0;
@@ -264,9 +461,262 @@ struct Terminal::Priv {
         THROW_IF_FAIL (slave_pty);
         THROW_IF_FAIL (master_pty);
 
-        vte_terminal_set_pty (vte, master_pty);
+        // Rather than letting the terminal widget read the output of
+        // the inferior from the master pty, read it ourselves so
+        // that it can be logged, and rendered at a bounded rate.
+        int flags = fcntl (master_pty, F_GETFL);
+        if (flags == -1
+            || fcntl (master_pty, F_SETFL, flags | O_NONBLOCK) == -1) {
+            LOG_ERROR ("could not make the master pty non blocking");
+            return false;
+        }
+        master_pty_connection = Glib::signal_io ().connect
+            (sigc::mem_fun (*this, &Terminal::Priv::on_master_pty_readable),
+             master_pty,
+             Glib::IO_IN | Glib::IO_HUP | Glib::IO_ERR,
+             Glib::PRIORITY_LOW);
         return true;
     }
+
+    /// Append what the inferior wrote to the master pty to the
+    /// output log, until the pty has nothing more to read.
+    ///
+    /// \param a_max the maximum number of bytes to read, or 0 to
+    /// read everything there is.
+    ///
+    /// \return the number of bytes read.
+    size_t read_master_pty (size_t a_max)
+    {
+        char buf[READ_CHUNK_SIZE];
+        size_t total = 0;
+        while (!a_max || total < a_max) {
+            ssize_t n = ::read (master_pty, buf, sizeof (buf));
+            if (n > 0) {
+                output_log.append (buf, n);
+                total += n;
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                break;
+            }
+        }
+        if (total)
+            schedule_render ();
+        return total;
+    }
+
+    bool on_master_pty_readable (Glib::IOCondition)
+    {
+        NEMIVER_TRY
+
+        read_master_pty (MAX_READ_PER_WAKEUP);
+
+        NEMIVER_CATCH
+        return true;
+    }
+
+    size_t mark_output_stop ()
+    {
+        // The pty is read at a low priority, so some of the output
+        // the inferior wrote before stopping might still be unread.
+        // Read it now, lest it be filed under this stop.  The
+        // inferior is stopped, so this terminates.
+        read_master_pty (0);
+        return output_log.mark_stop ();
+    }
+
+    /// Write the text typed or pasted in the terminal widget to the
+    /// master pty, so that the inferior can read it.  What the pty
+    /// cannot take right away is queued, and written when the pty
+    /// becomes writable again.
+    void write_input (const gchar *a_text, guint a_size)
+    {
+        pending_input.append (a_text, a_size);
+        if (!master_pty_writable_connection.connected ())
+            flush_input ();
+    }
+
+    /// Write as much of the pending input as the master pty takes.
+    ///
+    /// \return true if some input is still pending.
+    bool flush_input ()
+    {
+        size_t written = 0;
+        while (written < pending_input.size ()) {
+            ssize_t n = ::write (master_pty,
+                                 pending_input.data () + written,
+                                 pending_input.size () - written);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN) {
+                    LOG_ERROR ("could not write to the master pty");
+                    pending_input.clear ();
+                    return false;
+                }
+                break;
+            }
+            written += n;
+        }
+        pending_input.erase (0, written);
+        if (pending_input.empty ())
+            return false;
+        if (!master_pty_writable_connection.connected ())
+            master_pty_writable_connection = Glib::signal_io ().connect
+                (sigc::mem_fun (*this,
+                                &Terminal::Priv::on_master_pty_writable),
+                 master_pty,
+                 Glib::IO_OUT | Glib::IO_HUP | Glib::IO_ERR);
+        return true;
+    }
+
+    bool on_master_pty_writable (Glib::IOCondition a_cond)
+    {
+        NEMIVER_TRY
+
+        if (a_cond & (Glib::IO_HUP | Glib::IO_ERR)) {
+            pending_input.clear ();
+            return false;
+        }
+        return flush_input ();
+
+        NEMIVER_CATCH
+        pending_input.clear ();
+        return false;
+    }
+
+    /// Let the inferior know about the size of the terminal widget.
+    void update_pty_size ()
+    {
+        struct winsize size;
+        memset (&size, 0, sizeof (size));
+        size.ws_row = vte_terminal_get_row_count (vte);
+        size.ws_col = vte_terminal_get_column_count (vte);
+        if (ioctl (master_pty, TIOCSWINSZ, &size))
+            LOG_ERROR ("could not set the size of the pty");
+    }
+
+    void schedule_render ()
+    {
+        if (!render_connection.connected ())
+            render_connection = Glib::signal_timeout ().connect
+                (sigc::mem_fun (*this, &Terminal::Priv::on_render_timeout),
+                 RENDER_INTERVAL);
+    }
+
+    bool on_render_timeout ()
+    {
+        NEMIVER_TRY
+
+        render ();
+
+        NEMIVER_CATCH
+        return false;
+    }
+
+    void feed_vte (const std::string &a_text)
+    {
+        if (!a_text.empty ())
+            vte_terminal_feed (vte, a_text.c_str (), a_text.size ());
+    }
+
+    /// Feed the terminal widget with the part of the output log
+    /// that starts at a_offset.  If that part is too big, only its
+    /// last lines are fed, after a note saying how much output was
+    /// skipped.
+    ///
+    /// \param a_offset the offset to start from.
+    ///
+    /// \param a_nb_lost the number of bytes that were not rendered
+    /// before a_offset, because they were discarded from the log.
+    void feed_vte_from (size_t a_offset, size_t a_nb_lost = 0)
+    {
+        size_t end = output_log.size ();
+        if (a_offset >= end)
+            return;
+
+        if (a_nb_lost || end - a_offset > MAX_RENDERED_BYTES) {
+            size_t last_line = output_log.num_lines () - 1;
+            size_t first_line = last_line > (size_t) SCROLLBACK_LINES
+                ? last_line - SCROLLBACK_LINES
+                : 0;
+            size_t from = std::max (output_log.line_offset (first_line),
+                                    a_offset);
+            if (end - from > MAX_RENDERED_BYTES)
+                from = end - MAX_RENDERED_BYTES;
+            UString note;
+            note.printf (_("\r\n[%lu bytes of output not shown]\r\n"),
+                         (unsigned long) (from - a_offset + a_nb_lost));
+            feed_vte (note.raw ());
+            a_offset = from;
+        }
+
+        std::string text;
+        if (output_log.read (a_offset, end - a_offset, text))
+            feed_vte (text);
+    }
+
+    void render ()
+    {
+        size_t discarded = output_log.num_discarded_bytes ();
+        if (rendered_offset < discarded)
+            feed_vte_from (0, discarded - rendered_offset);
+        else
+            feed_vte_from (rendered_offset - discarded);
+        rendered_offset = discarded + output_log.size ();
+    }
+
+    bool show_output_at_stop (size_t a_stop)
+    {
+        size_t line = 0;
+        if (!output_log.stop_to_line (a_stop, line))
+            return false;
+        show_output_from_line (line);
+        return true;
+    }
+
+    /// Show the output from a given line of the output log, up to
+    /// what the terminal widget can hold.  The output that comes
+    /// afterwards is rendered after it, as usual.
+    void show_output_from_line (size_t a_line)
+    {
+        size_t line = a_line;
+        render_connection.disconnect ();
+        reset ();
+        size_t from = output_log.line_offset (line);
+        size_t to = output_log.line_offset (line + SCROLLBACK_LINES);
+        to = std::min (to, from + MAX_RENDERED_BYTES);
+        std::string text;
+        if (output_log.read (from, to - from, text))
+            feed_vte (text);
+        rendered_offset = output_log.num_discarded_bytes ()
+                          + output_log.size ();
+    }
+
+    static void on_commit_signal (VteTerminal*,
+                                  gchar *a_text,
+                                  guint a_size,
+                                  Terminal::Priv *a_priv)
+    {
+        NEMIVER_TRY
+
+        THROW_IF_FAIL (a_priv);
+        a_priv->write_input (a_text, a_size);
+
+        NEMIVER_CATCH
+    }
+
+    static void on_size_allocate_signal (GtkWidget*,
+                                         GdkRectangle*,
+                                         Terminal::Priv *a_priv)
+    {
+        NEMIVER_TRY
+
+        THROW_IF_FAIL (a_priv);
+        a_priv->update_pty_size ();
+
+        NEMIVER_CATCH
+    }
 };//end Terminal::Priv
 
 Terminal::Terminal (const string &a_menu_file_path,
@@ -328,12 +778,61 @@ Terminal::modify_font (const Pango::FontDescription &font_desc)
     vte_terminal_set_font (m_priv->vte, font_desc.gobj());
 }
 
+/// Write some text to the terminal.  The text is logged along with
+/// the output of the inferior.
 void
 Terminal::feed (const UString &a_text)
 {
     THROW_IF_FAIL (m_priv);
-    if (!a_text.empty ())
-        vte_terminal_feed (m_priv->vte, a_text.c_str (), a_text.size ());
+    if (!a_text.empty ()) {
+        m_priv->output_log.append (a_text.c_str (), a_text.bytes ());
+        m_priv->schedule_render ();
+    }
+}
+
+/// Record that the inferior stopped, so that the output it emits
+/// from now on can be shown again with show_output_at_stop.
+///
+/// \return the number of the stop.
+size_t
+Terminal::mark_output_stop ()
+{
+    THROW_IF_FAIL (m_priv);
+    return m_priv->mark_output_stop ();
+}
+
+/// Look for a piece of text in the whole output that was written to
+/// the terminal, including what doesn't fit in the terminal anymore.
+///
+/// \param a_text the text to look for.
+///
+/// \param a_from_line the line to start looking from.
+///
+/// \param a_line out parameter.  Set to the first line that contains
+/// a_text.
+///
+/// \return true if a_text was found, false otherwise.
+bool
+Terminal::find_output (const UString &a_text,
+                       size_t a_from_line,
+                       size_t &a_line) const
+{
+    THROW_IF_FAIL (m_priv);
+    return m_priv->output_log.find (a_text.raw (), a_from_line, a_line);
+}
+
+/// Show the output that was written to the terminal after a given
+/// stop of the inferior.
+///
+/// \param a_stop the number of the stop, as returned by
+/// mark_output_stop.
+///
+/// \return true upon successful completion, false otherwise.
+bool
+Terminal::show_output_at_stop (size_t a_stop)
+{
+    THROW_IF_FAIL (m_priv);
+    return m_priv->show_output_at_stop (a_stop);
 }
 
 
@@ -70,6 +70,11 @@ public:
     UString slave_pts_name () const;
     void modify_font (const Pango::FontDescription &font_desc);
     void feed (const UString &a_text);
+    size_t mark_output_stop ();
+    bool find_output (const UString &a_text,
+                      size_t a_from_line,
+                      size_t &a_line) const;
+    bool show_output_at_stop (size_t a_stop);
 };//end class Terminal
 
 NEMIVER_END_NAMESPACE(nemiver)
@@ -0,0 +1,543 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+
+// Throughput benchmarks of GDBMIParser and GDBEngine.
+//
+// The engine is driven against fakegdb (see fake-gdb.cc) which
+// replays synthetic MI transcripts: deep call stacks, huge
+// -var-list-children replies, big breakpoint tables, memory dumps
+// and stepping.  For each scenario, this reports the time spent
+// parsing the reply, the time spent handing the parsed replies over
+// to the output handlers (the dispatch, as measured by the engine
+// around OutputHandlerList::submit_command_and_output), the time
+// from the IDebugger request to the corresponding signal and the
+// number of heap allocations.
+//
+// Usage: benchgdbengine [scale]
+// where scale (default 1) multiplies the size of every scenario.
+
+#include "config.h"
+#include <cstdlib>
+#include <unistd.h>
+#include <new>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <glibmm.h>
+#include <glib/gstdio.h>
+#include "common/nmv-initializer.h"
+#include "common/nmv-safe-ptr-utils.h"
+#include "common/nmv-exception.h"
+#include "nmv-i-debugger.h"
+#include "nmv-gdbmi-parser.h"
+#include "nmv-dbg-common.h"
+#include "nmv-debugger-utils.h"
+
+using namespace nemiver;
+using namespace nemiver::common;
+using namespace std;
+
+//************************
+//<allocations accounting>
+//************************
+static size_t gv_nb_allocations = 0;
+
+void*
+operator new (size_t a_size)
+{
+    ++gv_nb_allocations;
+    void *p = malloc (a_size ? a_size : 1);
+    if (!p)
+        throw std::bad_alloc ();
+    return p;
+}
+
+void
+operator delete (void *a_ptr)
+{
+    free (a_ptr);
+}
+
+void*
+operator new[] (size_t a_size)
+{
+    return operator new (a_size);
+}
+
+void
+operator delete[] (void *a_ptr)
+{
+    operator delete (a_ptr);
+}
+//************************
+//</allocations accounting>
+//************************
+
+static Glib::RefPtr<Glib::MainLoop> loop =
+    Glib::MainLoop::create (Glib::MainContext::get_default ());
+
+static const int NB_PARSE_ITERATIONS = 20;
+static const int NB_ENGINE_ITERATIONS = 10;
+
+static const char *STOP_RECORD =
+"*stopped,reason=\"end-stepping-range\",thread-id=\"1\","
+"frame={addr=\"0x0000000000400520\",func=\"main\",args=[],"
+"file=\"bench.cc\",fullname=\"/tmp/bench.cc\",line=\"10\"},"
+"stopped-threads=\"all\"";
+
+static UString
+make_stack_reply (int a_nb_frames)
+{
+    ostringstream out;
+    out << "^done,stack=[";
+    for (int i = 0; i < a_nb_frames; ++i) {
+        if (i)
+            out << ",";
+        out << "frame={level=\"" << i << "\","
+            << "addr=\"0x" << hex << 0x400000 + i * 16 << dec << "\","
+            << "func=\"recurse_" << i << "\","
+            << "file=\"deep.cc\",fullname=\"/tmp/deep.cc\","
+            << "line=\"" << i + 1 << "\"}";
+    }
+    out << "]";
+    return out.str ();
+}
+
+static UString
+make_breakpoint_table_reply (int a_nb_breakpoints)
+{
+    ostringstream out;
+    out << "^done,BreakpointTable={nr_rows=\"" << a_nb_breakpoints << "\","
+        << "nr_cols=\"6\",hdr=["
+        << "{width=\"3\",alignment=\"-1\",col_name=\"number\",colhdr=\"Num\"},"
+        << "{width=\"14\",alignment=\"-1\",col_name=\"type\",colhdr=\"Type\"},"
+        << "{width=\"4\",alignment=\"-1\",col_name=\"disp\",colhdr=\"Disp\"},"
+        << "{width=\"3\",alignment=\"-1\",col_name=\"enabled\",colhdr=\"Enb\"},"
+        << "{width=\"10\",alignment=\"-1\",col_name=\"addr\","
+        << "colhdr=\"Address\"},"
+        << "{width=\"40\",alignment=\"2\",col_name=\"what\",colhdr=\"What\"}"
+        << "],body=[";
+    for (int i = 1; i <= a_nb_breakpoints; ++i) {
+        if (i > 1)
+            out << ",";
+        out << "bkpt={number=\"" << i << "\",type=\"breakpoint\","
+            << "disp=\"keep\",enabled=\"y\","
+            << "addr=\"0x" << hex << 0x400000 + i * 16 << dec << "\","
+            << "func=\"func_" << i << "\",file=\"many.cc\","
+            << "fullname=\"/tmp/many.cc\",line=\"" << i << "\","
+            << "times=\"0\"}";
+    }
+    out << "]}";
+    return out.str ();
+}
+
+static UString
+make_memory_reply (size_t a_start_addr, int a_nb_bytes)
+{
+    ostringstream out;
+    out << "^done,addr=\"0x" << hex << a_start_addr << "\","
+        << dec << "nr-bytes=\"" << a_nb_bytes << "\","
+        << "total-bytes=\"" << a_nb_bytes << "\","
+        << hex
+        << "next-row=\"0x" << a_start_addr + a_nb_bytes << "\","
+        << "prev-row=\"0x" << a_start_addr - a_nb_bytes << "\","
+        << "next-page=\"0x" << a_start_addr + a_nb_bytes << "\","
+        << "prev-page=\"0x" << a_start_addr - a_nb_bytes << "\","
+        << "memory=[{addr=\"0x" << a_start_addr << "\",data=[";
+    for (int i = 0; i < a_nb_bytes; ++i) {
+        if (i)
+            out << ",";
+        out << "\"0x" << setw (2) << setfill ('0') << (i & 0xff) << "\"";
+    }
+    out << dec << "],ascii=\"" << string (a_nb_bytes, 'x') << "\"}]";
+    return out.str ();
+}
+
+static UString
+make_var_create_reply (int a_nb_children)
+{
+    ostringstream out;
+    out << "^done,name=\"var1\",numchild=\"" << a_nb_children << "\","
+        << "value=\"{...}\",type=\"Big\",thread-id=\"1\",has_more=\"0\"";
+    return out.str ();
+}
+
+static UString
+make_var_children_reply (int a_nb_children)
+{
+    ostringstream out;
+    out << "^done,numchild=\"" << a_nb_children << "\",children=[";
+    for (int i = 0; i < a_nb_children; ++i) {
+        if (i)
+            out << ",";
+        out << "child={name=\"var1.m_" << i << "\",exp=\"m_" << i << "\","
+            << "numchild=\"0\",value=\"" << i << "\",type=\"int\","
+            << "thread-id=\"1\"}";
+    }
+    out << "],has_more=\"0\"";
+    return out.str ();
+}
+
+/// The measures of one scenario.
+struct Measure {
+    UString name;
+    size_t reply_size;
+    double parse_time;
+    size_t parse_allocations;
+    double dispatch_time;
+    double end_to_end_time;
+    size_t end_to_end_allocations;
+
+    Measure () :
+        reply_size (0),
+        parse_time (0),
+        parse_allocations (0),
+        dispatch_time (0),
+        end_to_end_time (0),
+        end_to_end_allocations (0)
+    {
+    }
+};
+
+/// Measure the time and the number of allocations it takes
+/// GDBMIParser to parse a_reply, the way GDBEngine parses it.
+static void
+measure_parsing (const UString &a_reply, Measure &a_measure)
+{
+    UString input = a_reply + "\n(gdb)\n";
+    a_measure.reply_size = input.bytes ();
+
+    Glib::Timer timer;
+    size_t nb_allocs = gv_nb_allocations;
+    timer.start ();
+    for (int i = 0; i < NB_PARSE_ITERATIONS; ++i) {
+        GDBMIParser parser (input, GDBMIParser::BROKEN_MODE);
+        Output output (input);
+        UString::size_type to = 0;
+        if (!parser.parse_output_record (0, to, output))
+            MESSAGE ("failed to parse reply of " << a_measure.name);
+    }
+    timer.stop ();
+    a_measure.parse_time = timer.elapsed () / NB_PARSE_ITERATIONS;
+    a_measure.parse_allocations =
+        (gv_nb_allocations - nb_allocs) / NB_PARSE_ITERATIONS;
+}
+
+//*****************************
+//<end to end engine scenarios>
+//*****************************
+static IDebuggerSafePtr gv_debugger;
+static Glib::Timer gv_timer;
+static size_t gv_allocs_at_request = 0;
+static int gv_nb_pending_replies = 0;
+static double gv_total_time = 0;
+static size_t gv_total_allocations = 0;
+static IDebugger::VariableSafePtr gv_big_var;
+// The members of gv_big_var listed by previous iterations.  They are
+// kept alive during the measures, otherwise their destruction would
+// queue as many -var-delete commands in front of the next request.
+static IDebugger::VariableList gv_previous_members;
+
+static void
+start_request ()
+{
+    gv_allocs_at_request = gv_nb_allocations;
+    gv_timer.start ();
+}
+
+static void
+reply_received ()
+{
+    if (gv_nb_pending_replies <= 0) {
+        // This is not a reply to a measured request.
+        loop->quit ();
+        return;
+    }
+    gv_timer.stop ();
+    gv_total_time += gv_timer.elapsed ();
+    gv_total_allocations += gv_nb_allocations - gv_allocs_at_request;
+    if (--gv_nb_pending_replies <= 0)
+        loop->quit ();
+}
+
+static void
+on_engine_died_signal ()
+{
+    MESSAGE ("engine died");
+    loop->quit ();
+}
+
+static void
+on_stopped_signal (IDebugger::StopReason,
+                   bool,
+                   const IDebugger::Frame &,
+                   int,
+                   const string &,
+                   const UString &)
+{
+    reply_received ();
+}
+
+static void
+on_frames_listed_signal (const vector<IDebugger::Frame> &,
+                         const UString &)
+{
+    reply_received ();
+}
+
+static void
+on_breakpoints_list_signal (const map<string, IDebugger::Breakpoint> &,
+                            const UString &)
+{
+    reply_received ();
+}
+
+static void
+on_read_memory_signal (size_t,
+                       const std::vector<uint8_t> &,
+                       const UString &)
+{
+    reply_received ();
+}
+
+static void
+on_variable_created (const IDebugger::VariableSafePtr a_var)
+{
+    gv_big_var = a_var;
+    loop->quit ();
+}
+
+static void
+on_variable_unfolded (const IDebugger::VariableSafePtr)
+{
+    reply_received ();
+}
+
+/// Issue the request a_request a number of times, one after the
+/// other, wait for its replies and record the average time,
+/// dispatch time and number of allocations in a_measure.
+static void
+measure_engine (const sigc::slot<void> &a_request, Measure &a_measure)
+{
+    gv_total_time = 0;
+    gv_total_allocations = 0;
+    gv_debugger->reset_perf_stats ();
+    for (int i = 0; i < NB_ENGINE_ITERATIONS; ++i) {
+        gv_nb_pending_replies = 1;
+        start_request ();
+        a_request ();
+        loop->run ();
+    }
+    a_measure.end_to_end_time = gv_total_time / NB_ENGINE_ITERATIONS;
+    // The engine measures the dispatch time in microseconds.
+    a_measure.dispatch_time =
+        gv_debugger->get_perf_stats ().dispatch_time ()
+        / 1000000.0 / NB_ENGINE_ITERATIONS;
+    a_measure.end_to_end_allocations =
+        gv_total_allocations / NB_ENGINE_ITERATIONS;
+}
+
+static void
+request_step ()
+{
+    gv_debugger->step_over ("bench");
+}
+
+static void
+request_frames ()
+{
+    gv_debugger->list_frames (-1, -1, "bench");
+}
+
+static void
+request_breakpoints ()
+{
+    gv_debugger->list_breakpoints ("bench");
+}
+
+static void
+request_memory ()
+{
+    gv_debugger->read_memory (0x1000, 4096, "bench");
+}
+
+static void
+request_children ()
+{
+    // Folding the variable is necessary so that unfolding it again
+    // re-lists its children.
+    gv_previous_members.splice (gv_previous_members.end (),
+                                gv_big_var->members ());
+    gv_debugger->unfold_variable (gv_big_var,
+                                  sigc::ptr_fun (&on_variable_unfolded));
+}
+//*****************************
+//</end to end engine scenarios>
+//*****************************
+
+static void
+write_script (const string &a_path,
+              const vector<pair<UString, UString> > &a_rules)
+{
+    ofstream out (a_path.c_str ());
+    THROW_IF_FAIL (out.good ());
+    out << "# Generated by benchgdbengine\n"
+        << "<- -exec-run\n"
+        << "^running\n"
+        << "*running,thread-id=\"all\"\n"
+        << "(gdb)\n"
+        << STOP_RECORD << "\n";
+    vector<pair<UString, UString> >::const_iterator it;
+    for (it = a_rules.begin (); it != a_rules.end (); ++it)
+        out << it->first << "\n" << it->second << "\n";
+}
+
+static void
+report (const Measure &a_measure)
+{
+    cout << left << setw (24) << a_measure.name << right
+         << setw (10) << a_measure.reply_size / 1024 << " KiB"
+         << setw (10) << fixed << setprecision (3)
+         << a_measure.parse_time * 1000 << " ms"
+         << setw (9) << setprecision (1)
+         << (a_measure.parse_time > 0
+             ? a_measure.reply_size / a_measure.parse_time / (1024 * 1024)
+             : 0)
+         << " MiB/s"
+         << setw (10) << setprecision (3)
+         << a_measure.dispatch_time * 1000 << " ms"
+         << setw (10) << a_measure.end_to_end_time * 1000 << " ms"
+         << setw (10) << a_measure.parse_allocations
+         << setw (10) << a_measure.end_to_end_allocations
+         << endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    int scale = 1;
+    if (argc > 1)
+        scale = atoi (argv[1]);
+    if (scale <= 0)
+        scale = 1;
+
+    const int nb_frames = 2000 * scale;
+    const int nb_breakpoints = 10000 * scale;
+    const int nb_children = 10000 * scale;
+
+    vector<Measure> measures (5);
+    measures[0].name = "stop";
+    measures[1].name = "-stack-list-frames";
+    measures[2].name = "-break-list";
+    measures[3].name = "-data-read-memory";
+    measures[4].name = "-var-list-children";
+
+    vector<pair<UString, UString> > rules;
+    rules.push_back (make_pair (UString ("<-* -exec-next"),
+                                UString ("^running\n"
+                                         "*running,thread-id=\"all\"\n"
+                                         "(gdb)\n") + STOP_RECORD));
+    rules.push_back (make_pair (UString ("<-* -stack-list-frames"),
+                                make_stack_reply (nb_frames)));
+    rules.push_back (make_pair (UString ("<-* -break-list"),
+                                make_breakpoint_table_reply
+                                                    (nb_breakpoints)));
+    rules.push_back (make_pair (UString ("<-* -data-read-memory"),
+                                make_memory_reply (0x1000, 4096)));
+    rules.push_back (make_pair (UString ("<- -var-create"),
+                                make_var_create_reply (nb_children)));
+    rules.push_back (make_pair (UString ("<-* -var-list-children"),
+                                make_var_children_reply (nb_children)));
+
+    measure_parsing (STOP_RECORD, measures[0]);
+    for (unsigned i = 1; i < measures.size (); ++i) {
+        // The -var-create rule has no measure of its own.
+        unsigned rule = i < 4 ? i : i + 1;
+        measure_parsing (rules[rule].second, measures[i]);
+    }
+
+    string script_path;
+    int fd = Glib::file_open_tmp (script_path, "nemiver-fake-gdb");
+    close (fd);
+    write_script (script_path, rules);
+    Glib::setenv ("NEMIVER_FAKE_GDB_SCRIPT", script_path, true);
+
+    gv_debugger = debugger_utils::load_debugger_iface_with_confmgr ();
+    gv_debugger->set_event_loop_context (loop->get_context ());
+    gv_debugger->set_non_persistent_debugger_path
+                                    (NEMIVER_BUILDDIR "/fakegdb");
+    gv_debugger->engine_died_signal ().connect (&on_engine_died_signal);
+    gv_debugger->stopped_signal ().connect (&on_stopped_signal);
+    gv_debugger->frames_listed_signal ().connect
+                                            (&on_frames_listed_signal);
+    gv_debugger->breakpoints_list_signal ().connect
+                                            (&on_breakpoints_list_signal);
+    gv_debugger->read_memory_signal ().connect (&on_read_memory_signal);
+
+    // The inferior is never run for real, so any existing file will
+    // do as far as GDBEngine is concerned.
+    vector<UString> args;
+    gv_debugger->load_program (NEMIVER_BUILDDIR "/fakegdb", args, ".");
+    gv_debugger->run ();
+    loop->run ();
+
+    measure_engine (sigc::ptr_fun (&request_step), measures[0]);
+    measure_engine (sigc::ptr_fun (&request_frames), measures[1]);
+    measure_engine (sigc::ptr_fun (&request_breakpoints), measures[2]);
+    measure_engine (sigc::ptr_fun (&request_memory), measures[3]);
+
+    gv_debugger->create_variable ("big",
+                                  sigc::ptr_fun (&on_variable_created));
+    loop->run ();
+    THROW_IF_FAIL (gv_big_var);
+    measure_engine (sigc::ptr_fun (&request_children), measures[4]);
+
+    cout << left << setw (24) << "scenario" << right
+         << setw (14) << "reply"
+         << setw (13) << "parse"
+         << setw (15) << "throughput"
+         << setw (13) << "dispatch"
+         << setw (13) << "end-to-end"
+         << setw (10) << "allocs/p"
+         << setw (10) << "allocs/e"
+         << endl;
+    for (unsigned i = 0; i < measures.size (); ++i)
+        report (measures[i]);
+
+    gv_previous_members.clear ();
+    gv_big_var.reset ();
+    gv_debugger->exit_engine ();
+    gv_debugger.reset ();
+    g_unlink (script_path.c_str ());
+
+    NEMIVER_CATCH_NOX
+
+    return 0;
+}
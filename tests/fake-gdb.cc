@@ -0,0 +1,180 @@
+// Authors: The Nemiver contributors
+/*
+ *This file is part of the Nemiver project
+ *
+ *Nemiver is free software; you can redistribute
+ *it and/or modify it under the terms of
+ *the GNU General Public License as published by the
+ *Free Software Foundation; either version 2,
+ *or (at your option) any later version.
+ *
+ *Nemiver is distributed in the hope that it will
+ *be useful, but WITHOUT ANY WARRANTY;
+ *without even the implied warranty of
+ *MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *See the GNU General Public License for more details.
+ *
+ *You should have received a copy of the
+ *GNU General Public License along with Nemiver;
+ *see the file COPYING.
+ *If not, write to the Free Software Foundation,
+ *Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ *See COPYRIGHT file copyright information.
+ */
+
+// A stand-in for gdb that replays recorded GDB/MI transcripts.
+//
+// GDBEngine launches it exactly like it launches gdb, i.e, with
+// --interpreter=mi2 and the path of the inferior on the command
+// line.  Those arguments are ignored.  The transcript to replay is
+// read from the file named by the NEMIVER_FAKE_GDB_SCRIPT
+// environment variable.  Its format is:
+//
+//   # A comment.
+//   =some-output-emitted-at-startup
+//   <- -exec-run
+//   ^running
+//   *running,thread-id="all"
+//   (gdb)
+//   *stopped,reason="breakpoint-hit",...
+//   <-* -exec-next
+//   ^running
+//   ...
+//
+// Lines that appear before the first rule are emitted at startup.  A
+// line starting with "<- " starts a rule that matches the first
+// command received which starts with the rest of the line; the lines
+// that follow are emitted when the rule matches.  Such a rule is
+// consumed once it has matched.  A line starting with "<-* " starts
+// a rule that can match any number of times.  Rules are tried in the
+// order of the transcript.  A command that matches no rule gets a
+// plain "^done" reply.  Every reply is terminated by a "(gdb)"
+// prompt, unless the transcript already ends it with one.
+
+#include <cstdlib>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <list>
+#include <iostream>
+#include <fstream>
+
+struct Rule {
+    std::string command_prefix;
+    std::vector<std::string> output;
+    bool repeatable;
+    bool consumed;
+
+    Rule () :
+        repeatable (false),
+        consumed (false)
+    {
+    }
+};
+
+static const char *PROMPT = "(gdb)";
+
+static bool
+starts_with (const std::string &a_str, const std::string &a_prefix)
+{
+    return !a_str.compare (0, a_prefix.size (), a_prefix);
+}
+
+static bool
+load_script (const char *a_path,
+             std::vector<std::string> &a_startup,
+             std::list<Rule> &a_rules)
+{
+    std::ifstream in (a_path);
+    if (!in.good ())
+        return false;
+
+    std::string line;
+    Rule *current = 0;
+    while (std::getline (in, line)) {
+        if (!line.empty () && line[line.size () - 1] == '\r')
+            line.erase (line.size () - 1);
+        if (starts_with (line, "#"))
+            continue;
+        if (starts_with (line, "<-* ") || starts_with (line, "<- ")) {
+            a_rules.push_back (Rule ());
+            current = &a_rules.back ();
+            current->repeatable = starts_with (line, "<-* ");
+            current->command_prefix =
+                line.substr (current->repeatable ? 4 : 3);
+            continue;
+        }
+        if (current)
+            current->output.push_back (line);
+        else
+            a_startup.push_back (line);
+    }
+    return true;
+}
+
+static void
+emit (const std::vector<std::string> &a_lines)
+{
+    std::vector<std::string>::const_iterator it;
+    for (it = a_lines.begin (); it != a_lines.end (); ++it)
+        std::cout << *it << '\n';
+    if (a_lines.empty () || a_lines.back () != PROMPT)
+        std::cout << PROMPT << '\n';
+    std::cout.flush ();
+}
+
+int
+main ()
+{
+    const char *script_path = getenv ("NEMIVER_FAKE_GDB_SCRIPT");
+    std::vector<std::string> startup;
+    std::list<Rule> rules;
+
+    if (script_path && !load_script (script_path, startup, rules)) {
+        std::cerr << "fake-gdb: could not read script "
+                  << script_path << '\n';
+        return 1;
+    }
+
+    emit (startup);
+
+    std::string command;
+    while (std::getline (std::cin, command)) {
+        if (!command.empty () && command[command.size () - 1] == '\r')
+            command.erase (command.size () - 1);
+
+        // Strip the optional numerical token of the MI command.
+        std::string::size_type i = 0;
+        while (i < command.size () && isdigit (command[i]))
+            ++i;
+        command.erase (0, i);
+
+        if (command.empty ())
+            continue;
+
+        if (starts_with (command, "-gdb-exit")
+            || starts_with (command, "quit")) {
+            std::cout << "^exit" << std::endl;
+            return 0;
+        }
+
+        std::list<Rule>::iterator it;
+        for (it = rules.begin (); it != rules.end (); ++it) {
+            if (!it->consumed
+                && starts_with (command, it->command_prefix))
+                break;
+        }
+
+        if (it == rules.end ()) {
+            std::vector<std::string> done (1, "^done");
+            emit (done);
+            continue;
+        }
+
+        emit (it->output);
+        if (!it->repeatable)
+            it->consumed = true;
+    }
+    return 0;
+}
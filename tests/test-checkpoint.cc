@@ -0,0 +1,161 @@
+#include "config.h"
+#include <iostream>
+#include <vector>
+#include <boost/test/minimal.hpp>
+#include <glibmm.h>
+#include "common/nmv-initializer.h"
+#include "common/nmv-safe-ptr-utils.h"
+#include "nmv-i-debugger.h"
+#include "nmv-debugger-utils.h"
+
+// Stop fooprog in func4 and set a checkpoint there.  Restart from
+// it right away, while the inferior is stopped.  The restart uses
+// the checkpoint up, and the engine sets a new one in its place:
+// restart from that one too.  Then let the program exit: GDB goes
+// back to the checkpoint by itself, and the engine notifies that as
+// a restart, with a new checkpoint.  Restart from that last one,
+// once more.  Check that the inferior is back in func4 each time,
+// and that the program never finishes.
+
+using namespace nemiver;
+using namespace nemiver::common;
+
+Glib::RefPtr<Glib::MainLoop> loop =
+    Glib::MainLoop::create (Glib::MainContext::get_default ());
+
+static const int NB_RESTARTS = 2;
+// The restarts from a stop, then the one at the exit of the
+// program, then the one after it.
+static const int NB_STOPS_AT_CHECKPOINT = NB_RESTARTS + 2;
+static std::vector<int> checkpoint_ids;
+static int nb_stops_at_checkpoint;
+static int nb_stops_at_checkpoint_in_func4;
+static int nb_program_finished;
+
+void
+on_engine_died_signal ()
+{
+    MESSAGE ("engine died");
+    loop->quit ();
+}
+
+void
+on_program_finished_signal ()
+{
+    MESSAGE ("program finished");
+    ++nb_program_finished;
+    loop->quit ();
+}
+
+void
+on_checkpoint_set_signal (int a_checkpoint_id,
+                          const UString &/*a_cookie*/,
+                          IDebuggerSafePtr &a_debugger)
+{
+    MESSAGE ("checkpoint set: " << a_checkpoint_id);
+    checkpoint_ids.push_back (a_checkpoint_id);
+    int nb_checkpoints = checkpoint_ids.size ();
+    if (nb_checkpoints <= NB_RESTARTS
+        || nb_checkpoints == NB_RESTARTS + 2) {
+        MESSAGE ("restarting from checkpoint " << a_checkpoint_id);
+        a_debugger->restart_from_checkpoint (a_checkpoint_id);
+    } else if (nb_checkpoints == NB_RESTARTS + 1) {
+        MESSAGE ("letting the program exit");
+        a_debugger->do_continue ();
+    } else {
+        loop->quit ();
+    }
+}
+
+void
+on_stopped_signal (IDebugger::StopReason a_reason,
+                   bool a_has_frame,
+                   const IDebugger::Frame &a_frame,
+                   int /*a_thread_id*/,
+                   const string &/*a_bp_num*/,
+                   const UString &/*a_cookie*/,
+                   IDebuggerSafePtr &a_debugger)
+{
+    if (IDebugger::is_exited (a_reason) || !a_has_frame)
+        return;
+
+    MESSAGE ("stopped in: " << a_frame.function_name ());
+
+    if (a_reason == IDebugger::BREAKPOINT_HIT) {
+        if (checkpoint_ids.empty ())
+            a_debugger->set_checkpoint ();
+        else
+            a_debugger->do_continue ();
+        return;
+    }
+
+    if (a_reason == IDebugger::UNDEFINED_REASON) {
+        // This is the stop notified once the inferior got back to
+        // the checkpoint.  The new checkpoint is notified next.
+        ++nb_stops_at_checkpoint;
+        if (a_frame.function_name () == "func4")
+            ++nb_stops_at_checkpoint_in_func4;
+    }
+}
+
+bool
+on_timeout ()
+{
+    MESSAGE ("timed out");
+    loop->quit ();
+    return false;
+}
+
+NEMIVER_API int
+test_main (int, char **)
+{
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    THROW_IF_FAIL (loop);
+
+    IDebuggerSafePtr debugger =
+        debugger_utils::load_debugger_iface_with_confmgr ();
+
+    debugger->set_event_loop_context (loop->get_context ());
+
+    //*****************************
+    //<connect to IDebugger events>
+    //*****************************
+    debugger->engine_died_signal ().connect (&on_engine_died_signal);
+
+    debugger->program_finished_signal ().connect
+        (&on_program_finished_signal);
+
+    debugger->checkpoint_set_signal ().connect
+        (sigc::bind (&on_checkpoint_set_signal, debugger));
+
+    debugger->stopped_signal ().connect
+        (sigc::bind (&on_stopped_signal, debugger));
+
+    std::vector<UString> args, source_search_dir;
+    source_search_dir.push_back (".");
+    debugger->load_program ("fooprog", args, ".",
+                            source_search_dir, "", false);
+    debugger->set_breakpoint ("func4");
+    debugger->run ();
+
+    Glib::signal_timeout ().connect_seconds (&on_timeout, 60);
+    loop->run ();
+
+    NEMIVER_CATCH_NOX
+
+    BOOST_REQUIRE (nb_stops_at_checkpoint == NB_STOPS_AT_CHECKPOINT);
+    BOOST_REQUIRE (nb_stops_at_checkpoint_in_func4
+                   == NB_STOPS_AT_CHECKPOINT);
+    BOOST_REQUIRE (nb_program_finished == 0);
+    // One checkpoint set by hand, then one per stop at a checkpoint.
+    // Each differs from the one it replaces, but GDB can reuse the
+    // ids once it keeps no fork anymore.
+    BOOST_REQUIRE ((int) checkpoint_ids.size ()
+                   == NB_STOPS_AT_CHECKPOINT + 1);
+    for (size_t i = 1; i < checkpoint_ids.size (); ++i)
+        BOOST_REQUIRE (checkpoint_ids[i] != checkpoint_ids[i - 1]);
+    return 0;
+}
@@ -49,6 +49,63 @@ test_lexer2 ()
     std::cout << "tokenization done okay" << std::endl;
 }
 
+void
+test_lexer_keywords ()
+{
+    // Keywords are whole words, even at the end of the input.
+    const char *input = "intx int and_eq returns unsigned";
+    const Token::Kind kinds[] = {Token::IDENTIFIER, Token::KEYWORD,
+                                 Token::KEYWORD, Token::IDENTIFIER,
+                                 Token::KEYWORD};
+    const unsigned nb_kinds = sizeof (kinds) / sizeof (kinds[0]);
+
+    // Scan the input through a buffer the lexer doesn't own.
+    std::string buf (input);
+    Lexer lexer (buf.data (), buf.size ());
+    Token token;
+    unsigned i = 0;
+    while (lexer.consume_next_token (token)) {
+        BOOST_REQUIRE_MESSAGE (i < nb_kinds, "got too many tokens");
+        BOOST_REQUIRE_MESSAGE (token.get_kind () == kinds[i],
+                               "wrong kind for token " << i
+                               << ": " << token);
+        ++i;
+        token.clear ();
+    }
+    BOOST_REQUIRE_MESSAGE (i == nb_kinds, "got " << i << " number of tokens");
+}
+
+void
+test_lexer_keyword_table ()
+{
+    // The keyword table of the lexer relies on a hash function that
+    // is perfect for this exact set of keywords.  A keyword that
+    // doesn't get its own slot is scanned as an identifier.
+    const char *keywords[] = {
+        "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+        "case", "catch", "char", "class", "compl", "const", "const_cast",
+        "continue", "default", "delete", "do", "double", "dynamic_cast",
+        "else", "enum", "explicit", "export", "extern", "false", "float",
+        "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+        "namespace", "new", "not", "not_eq", "operator", "or", "or_eq",
+        "private", "protected", "public", "register", "reinterpret_cast",
+        "return", "short", "signed", "sizeof", "static", "static_cast",
+        "struct", "switch", "template", "this", "throw", "true", "try",
+        "typedef", "typeid", "typename", "union", "unsigned", "using",
+        "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+        0
+    };
+
+    for (const char **kw = keywords; *kw; ++kw) {
+        Lexer lexer (*kw);
+        Token token;
+        BOOST_REQUIRE_MESSAGE (lexer.consume_next_token (token),
+                               "could not scan " << *kw);
+        BOOST_REQUIRE_MESSAGE (token.get_kind () != Token::IDENTIFIER,
+                               *kw << " was scanned as an identifier");
+    }
+}
+
 using boost::unit_test::test_suite;
 
 test_suite*
@@ -63,6 +120,8 @@ init_unit_test_suite (int argc, char** argv)
     test_suite *suite = BOOST_TEST_SUITE ("c++ lexer tests");
     suite->add (BOOST_TEST_CASE (&test_lexer));
     suite->add (BOOST_TEST_CASE (&test_lexer2));
+    suite->add (BOOST_TEST_CASE (&test_lexer_keywords));
+    suite->add (BOOST_TEST_CASE (&test_lexer_keyword_table));
     return suite;
 
     NEMIVER_CATCH_NOX
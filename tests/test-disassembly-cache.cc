@@ -0,0 +1,166 @@
+#include "config.h"
+#include <list>
+#include <boost/test/unit_test.hpp>
+#include <glibmm.h>
+#include "common/nmv-disassembly-cache.h"
+#include "common/nmv-initializer.h"
+#include "common/nmv-exception.h"
+
+using namespace std;
+using namespace nemiver;
+using nemiver::common::Initializer;
+using nemiver::common::Asm;
+using nemiver::common::AsmInstr;
+using nemiver::common::MixedAsmInstr;
+using nemiver::common::DisassembleInfo;
+using nemiver::common::DisassemblyCache;
+
+// Build four instructions, each 4 bytes long, starting at 0x1000.
+static void
+build_instrs (list<Asm> &a_instrs)
+{
+    a_instrs.push_back (AsmInstr ("0x1000", "main", "0", "push %rbp"));
+    a_instrs.push_back (AsmInstr ("0x1004", "main", "4", "mov %rsp,%rbp"));
+    a_instrs.push_back (AsmInstr ("0x1008", "main", "8", "nop"));
+    a_instrs.push_back (AsmInstr ("0x100c", "main", "12", "leaveq"));
+}
+
+void
+test_lookup ()
+{
+    DisassemblyCache cache;
+    list<Asm> instrs, found;
+    DisassembleInfo info;
+
+    build_instrs (instrs);
+    BOOST_REQUIRE (cache.empty ());
+    BOOST_REQUIRE (!cache.lookup (0x1000, 0x1010, true, info, found));
+
+    cache.add (0x1000, 0x1010, instrs, true);
+    BOOST_REQUIRE (!cache.empty ());
+
+    BOOST_REQUIRE (cache.lookup (0x1000, 0x1010, true, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 4u);
+    BOOST_REQUIRE_EQUAL (info.start_address (), "0x1000");
+    BOOST_REQUIRE_EQUAL (info.end_address (), "0x100c");
+
+    // A sub-range is served from the cache too.
+    found.clear ();
+    BOOST_REQUIRE (cache.lookup (0x1004, 0x100c, true, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 2u);
+
+    // A range that is only partly known is not.
+    found.clear ();
+    BOOST_REQUIRE (!cache.lookup (0x1008, 0x1020, true, info, found));
+
+    // Neither is a range disassembled in another style.
+    BOOST_REQUIRE (!cache.lookup (0x1000, 0x1010, false, info, found));
+}
+
+void
+test_merge_and_invalidate ()
+{
+    DisassemblyCache cache;
+    list<Asm> instrs, first, second, found;
+    DisassembleInfo info;
+
+    build_instrs (instrs);
+    first.assign (instrs.begin (), ++++instrs.begin ());
+    second.assign (++++instrs.begin (), instrs.end ());
+
+    // Two adjacent ranges make up a single known range.
+    cache.add (0x1000, 0x1008, first, true);
+    cache.add (0x1008, 0x1010, second, true);
+    BOOST_REQUIRE (cache.lookup (0x1000, 0x1010, true, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 4u);
+
+    // Writing to the memory of the range forgets about it.
+    cache.invalidate (0x1009, 0x100a);
+    found.clear ();
+    BOOST_REQUIRE (!cache.lookup (0x1000, 0x1004, true, info, found));
+    BOOST_REQUIRE (cache.empty ());
+
+    // Writing elsewhere does not.
+    cache.add (0x1000, 0x1010, instrs, true);
+    cache.invalidate (0x2000, 0x2004);
+    BOOST_REQUIRE (cache.lookup (0x1000, 0x1010, true, info, found));
+
+    cache.clear ();
+    BOOST_REQUIRE (cache.empty ());
+}
+
+void
+test_mixed ()
+{
+    DisassemblyCache cache;
+    list<AsmInstr> block1, block2;
+    list<Asm> instrs, found;
+    DisassembleInfo info;
+
+    block1.push_back (AsmInstr ("0x1000", "main", "0", "push %rbp"));
+    block1.push_back (AsmInstr ("0x1004", "main", "4", "mov %rsp,%rbp"));
+    block2.push_back (AsmInstr ("0x1008", "main", "8", "nop"));
+    block2.push_back (AsmInstr ("0x100c", "main", "12", "leaveq"));
+    instrs.push_back (MixedAsmInstr ("main.c", 3, block1));
+    instrs.push_back (MixedAsmInstr ("main.c", 4, block2));
+
+    cache.add (0x1000, 0x1010, instrs, false);
+    BOOST_REQUIRE (cache.lookup (0x1000, 0x1010, false, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 2u);
+    BOOST_REQUIRE_EQUAL (info.start_address (), "0x1000");
+
+    // A sub-range would cut the source blocks; it is not served.
+    found.clear ();
+    BOOST_REQUIRE (!cache.lookup (0x1000, 0x1008, false, info, found));
+
+    // Overlapping mixed ranges are not merged.
+    list<Asm> tail;
+    tail.push_back (MixedAsmInstr ("main.c", 4, block2));
+    cache.add (0x1008, 0x1010, tail, false);
+    BOOST_REQUIRE (cache.lookup (0x1008, 0x1010, false, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 1u);
+    found.clear ();
+    BOOST_REQUIRE (cache.lookup (0x1000, 0x1010, false, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 2u);
+
+    // Both styles are kept side by side.
+    list<Asm> pure;
+    build_instrs (pure);
+    cache.add (0x1000, 0x1010, pure, true);
+    found.clear ();
+    BOOST_REQUIRE (cache.lookup (0x1000, 0x1010, true, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 4u);
+    found.clear ();
+    BOOST_REQUIRE (cache.lookup (0x1000, 0x1010, false, info, found));
+    BOOST_REQUIRE_EQUAL (found.size (), 2u);
+
+    // Writing to the memory of a range forgets about all the mixed
+    // ranges that contain it.
+    cache.invalidate (0x100c, 0x100d);
+    found.clear ();
+    BOOST_REQUIRE (!cache.lookup (0x1000, 0x1010, false, info, found));
+    BOOST_REQUIRE (!cache.lookup (0x1008, 0x1010, false, info, found));
+    BOOST_REQUIRE (cache.empty ());
+}
+
+using boost::unit_test::test_suite;
+
+NEMIVER_API test_suite*
+init_unit_test_suite (int argc, char** argv)
+{
+    if (argc || argv) {/*keep compiler happy*/}
+
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    test_suite *suite = BOOST_TEST_SUITE ("Disassembly cache tests");
+    suite->add (BOOST_TEST_CASE (&test_lookup));
+    suite->add (BOOST_TEST_CASE (&test_merge_and_invalidate));
+    suite->add (BOOST_TEST_CASE (&test_mixed));
+    return suite;
+
+    NEMIVER_CATCH_NOX
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "config.h"
+#include <iostream>
+#include <boost/test/minimal.hpp>
+#include <glibmm.h>
+#include "common/nmv-initializer.h"
+#include "common/nmv-safe-ptr-utils.h"
+#include "nmv-i-debugger.h"
+#include "nmv-debugger-utils.h"
+
+// Stop fooprog in func4, fast-forward two lines, then fast-forward
+// until the variable 'i' changes, and check that each fast-forward
+// is notified by a single stop, at the expected line.  Each
+// fast-forward is requested from the handler of the previous stop,
+// like any other command.
+
+using namespace nemiver;
+using namespace nemiver::common;
+
+Glib::RefPtr<Glib::MainLoop> loop =
+    Glib::MainLoop::create (Glib::MainContext::get_default ());
+
+static int nb_steps_stops;
+static int line_after_step_over;
+static int line_after_i_changed;
+static bool program_finished;
+
+void
+on_engine_died_signal ()
+{
+    MESSAGE ("engine died");
+    loop->quit ();
+}
+
+void
+on_program_finished_signal ()
+{
+    MESSAGE ("program finished");
+    program_finished = true;
+    loop->quit ();
+}
+
+void
+on_stopped_signal (IDebugger::StopReason a_reason,
+                   bool a_has_frame,
+                   const IDebugger::Frame &a_frame,
+                   int /*a_thread_id*/,
+                   const string &/*a_bp_num*/,
+                   const UString &/*a_cookie*/,
+                   IDebuggerSafePtr &a_debugger)
+{
+    if (IDebugger::is_exited (a_reason) || !a_has_frame)
+        return;
+
+    MESSAGE ("stopped in: " << a_frame.function_name ()
+             << ":" << a_frame.line ());
+
+    if (a_reason == IDebugger::BREAKPOINT_HIT) {
+        // fooprog.cc:87 is the first line of func4.
+        a_debugger->fast_forward_step_over (2);
+        return;
+    }
+
+    if (a_reason != IDebugger::END_STEPPING_RANGE)
+        return;
+
+    ++nb_steps_stops;
+    if (nb_steps_stops == 1) {
+        line_after_step_over = a_frame.line ();
+        a_debugger->fast_forward_until_changed ("i");
+    } else {
+        line_after_i_changed = a_frame.line ();
+        a_debugger->do_continue ();
+    }
+}
+
+bool
+on_timeout ()
+{
+    MESSAGE ("timed out");
+    loop->quit ();
+    return false;
+}
+
+NEMIVER_API int
+test_main (int, char **)
+{
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    THROW_IF_FAIL (loop);
+
+    IDebuggerSafePtr debugger =
+        debugger_utils::load_debugger_iface_with_confmgr ();
+
+    debugger->set_event_loop_context (loop->get_context ());
+
+    //*****************************
+    //<connect to IDebugger events>
+    //*****************************
+    debugger->engine_died_signal ().connect (&on_engine_died_signal);
+
+    debugger->program_finished_signal ().connect
+                                            (&on_program_finished_signal);
+
+    debugger->stopped_signal ().connect
+        (sigc::bind (&on_stopped_signal, debugger));
+
+    std::vector<UString> args, source_search_dir;
+    source_search_dir.push_back (".");
+    debugger->load_program ("fooprog", args, ".",
+                            source_search_dir, "", false);
+    debugger->set_breakpoint ("func4");
+    debugger->run ();
+
+    Glib::signal_timeout ().connect_seconds (&on_timeout, 60);
+    loop->run ();
+
+    NEMIVER_CATCH_NOX
+
+    BOOST_REQUIRE (program_finished);
+    BOOST_REQUIRE (nb_steps_stops == 2);
+    // "i=0", then "for (j=0; ...)", then "i = j".
+    BOOST_REQUIRE (line_after_step_over == 89);
+    // 'i' gets 1 at the second iteration of the loop, once "i = j"
+    // is stepped over.
+    BOOST_REQUIRE (line_after_i_changed == 90);
+    return 0;
+}
@@ -15,6 +15,7 @@ static const char* gv_str1 = "\"/home/dodji/misc/no\\303\\253l-\\303\\251-\\303\
 static const char* gv_str2 = "\"No symbol \\\"events_ecal\\\" in current context.\\n\"";
 static const char* gv_str3 = "\"Reading symbols from /home/dodji/devel/tests/éçà/test...\"";
 static const char* gv_str4 = "\"\\\"Eins\\\"\"";
+static const char* gv_str5 = "\"C:\\\\\",\"caf\\351\"";
 static const char* gv_attrs0 = "msg=\"No symbol \\\"g_return_if_fail\\\" in current context.\"";
 static const char* gv_attrs1 = "script=[\"silent\",\"return\"]";
 
@@ -24,6 +25,13 @@ static const char* gv_stopped_async_output0 =
 static const char* gv_stopped_async_output1 =
 "*stopped,reason=\"breakpoint-hit\",bkptno=\"1\",thread-id=\"1\",frame={addr=\"0x08048d38\",func=\"main\",args=[],file=\"fooprog.cc\",fullname=\"/opt/dodji/git/nemiver.git/tests/fooprog.cc\",line=\"80\"}\n";
 
+// What GDB emits in non-stop mode.
+static const char *gv_stopped_async_output2 =
+"*stopped,reason=\"breakpoint-hit\",disp=\"keep\",bkptno=\"1\",frame={addr=\"0x08048d38\",func=\"main\",args=[],file=\"fooprog.cc\",fullname=\"/opt/dodji/git/nemiver.git/tests/fooprog.cc\",line=\"80\"},thread-id=\"2\",stopped-threads=[\"2\"]\n";
+
+// The reply to -thread-select on a running thread, in non-stop mode.
+static const char *gv_new_thread_id0 = "new-thread-id=\"3\"\n";
+
 static const char *gv_running_async_output0 =
 "*running,thread-id=\"all\"\n";
 
@@ -168,9 +176,34 @@ static const char* gv_breakpoint2 =
 static const char* gv_breakpoint3 =
     "bkpt={number=\"2\",type=\"breakpoint\",disp=\"keep\",enabled=\"y\",addr=\"<MULTIPLE>\",times=\"0\",original-location=\"error\"},{number=\"2.1\",enabled=\"y\",addr=\"0x000000000132d2f7\",func=\"error(char const*,...)\",file=\"/home/dodji/git/gcc/PR56782/gcc/diagnostic.c\",fullname=\"/home/dodji/git/gcc/PR56782/gcc/diagnostic.c\",line=\"1038\"},{number=\"2.2\",enabled=\"y\",addr=\"0x00000032026f1490\",at=\"<error>\"}";
 
+static const char* gv_breakpoint4 =
+    "bkpt={number=\"4\",type=\"breakpoint\",disp=\"keep\",enabled=\"y\",addr=\"0x0000000000400b1e\",func=\"func4(Person&)\",file=\"fooprog.cc\",fullname=\"/home/dodji/devel/nemiver/tests/fooprog.cc\",line=\"89\",thread-groups=[\"i1\"],cond=\"j == 900\",evaluated-by=\"target\",times=\"0\",original-location=\"fooprog.cc:89\"}";
+
 static const char* gv_breakpoint_modified_async_output0 =
     "=breakpoint-modified,bkpt={number=\"2\",type=\"breakpoint\",disp=\"keep\",enabled=\"y\",addr=\"<MULTIPLE>\",times=\"0\",original-location=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h:1322\"},{number=\"2.1\",enabled=\"y\",addr=\"0x00007ffff7d70922\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::base_spec> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::base_spec>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::base_spec> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::base_spec> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::base_spec>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::base_spec> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::base_spec> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::base_spec>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::base_spec> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::base_spec> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::base_spec>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::base_spec> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::base_spec> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::base_spec>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::base_spec> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::base_spec> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::base_spec>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::base_spec> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::base_spec> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::base_spec>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::base_spec> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.2\",enabled=\"y\",addr=\"0x00007ffff7d71536\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_type> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_type>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_type> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_type> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_type>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_type> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_type> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_type>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_type> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_type> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_type>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_type> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_type> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_type>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_type> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_type> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_type>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_type> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_type> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_type>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_type> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.3\",enabled=\"y\",addr=\"0x00007ffff7d7214a\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::data_member> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::data_member>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::data_member> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::data_member> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::data_member>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::data_member> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::data_member> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::data_member>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::data_member> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::data_member> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::data_member>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::data_member> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::data_member> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::data_member>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::data_member> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::data_member> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::data_member>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::data_member> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::data_member> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::data_member>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::data_member> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.4\",enabled=\"y\",addr=\"0x00007ffff7d72d5e\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.5\",enabled=\"y\",addr=\"0x00007ffff7d73972\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_function_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_function_template> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.6\",enabled=\"y\",addr=\"0x00007ffff7d74586\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_class_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_class_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_class_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_class_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_class_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_class_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> const*, std::vector<std::tr1::shared_ptr<abigail::class_decl::member_class_template>, std::allocator<std::tr1::shared_ptr<abigail::class_decl::member_class_template> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.7\",enabled=\"y\",addr=\"0x00007ffff7d75928\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::decl_base> const*, std::vector<std::tr1::shared_ptr<abigail::decl_base>, std::allocator<std::tr1::shared_ptr<abigail::decl_base> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::decl_base> const*, std::vector<std::tr1::shared_ptr<abigail::decl_base>, std::allocator<std::tr1::shared_ptr<abigail::decl_base> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::decl_base> const*, std::vector<std::tr1::shared_ptr<abigail::decl_base>, std::allocator<std::tr1::shared_ptr<abigail::decl_base> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::decl_base> const*, std::vector<std::tr1::shared_ptr<abigail::decl_base>, std::allocator<std::tr1::shared_ptr<abigail::decl_base> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::decl_base> const*, std::vector<std::tr1::shared_ptr<abigail::decl_base>, std::allocator<std::tr1::shared_ptr<abigail::decl_base> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::decl_base> const*, std::vector<std::tr1::shared_ptr<abigail::decl_base>, std::allocator<std::tr1::shared_ptr<abigail::decl_base> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::decl_base> const*, std::vector<std::tr1::shared_ptr<abigail::decl_base>, std::allocator<std::tr1::shared_ptr<abigail::decl_base> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.8\",enabled=\"y\",addr=\"0x00007ffff7d76f1a\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::function_decl::parameter> const*, std::vector<std::tr1::shared_ptr<abigail::function_decl::parameter>, std::allocator<std::tr1::shared_ptr<abigail::function_decl::parameter> > > > >(__gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::function_decl::parameter> const*, std::vector<std::tr1::shared_ptr<abigail::function_decl::parameter>, std::allocator<std::tr1::shared_ptr<abigail::function_decl::parameter> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::function_decl::parameter> const*, std::vector<std::tr1::shared_ptr<abigail::function_decl::parameter>, std::allocator<std::tr1::shared_ptr<abigail::function_decl::parameter> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::function_decl::parameter> const*, std::vector<std::tr1::shared_ptr<abigail::function_decl::parameter>, std::allocator<std::tr1::shared_ptr<abigail::function_decl::parameter> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::function_decl::parameter> const*, std::vector<std::tr1::shared_ptr<abigail::function_decl::parameter>, std::allocator<std::tr1::shared_ptr<abigail::function_decl::parameter> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::function_decl::parameter> const*, std::vector<std::tr1::shared_ptr<abigail::function_decl::parameter>, std::allocator<std::tr1::shared_ptr<abigail::function_decl::parameter> > > >, __gnu_cxx::__normal_iterator<std::tr1::shared_ptr<abigail::function_decl::parameter> const*, std::vector<std::tr1::shared_ptr<abigail::function_decl::parameter>, std::allocator<std::tr1::shared_ptr<abigail::function_decl::parameter> > > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.9\",enabled=\"y\",addr=\"0x00007ffff7d77b2e\",func=\"abigail::diff_utils::compute_diff<__gnu_cxx::__normal_iterator<char*, std::vector<char, std::allocator<char> > > >(__gnu_cxx::__normal_iterator<char*, std::vector<char, std::allocator<char> > >, __gnu_cxx::__normal_iterator<char*, std::vector<char, std::allocator<char> > >, __gnu_cxx::__normal_iterator<char*, std::vector<char, std::allocator<char> > >, __gnu_cxx::__normal_iterator<char*, std::vector<char, std::allocator<char> > >, __gnu_cxx::__normal_iterator<char*, std::vector<char, std::allocator<char> > >, __gnu_cxx::__normal_iterator<char*, std::vector<char, std::allocator<char> > >, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"},{number=\"2.10\",enabled=\"y\",addr=\"0x00007ffff7d573c8\",func=\"abigail::diff_utils::compute_diff<char const*>(char const*, char const*, char const*, char const*, char const*, char const*, std::vector<abigail::diff_utils::point, std::allocator<abigail::diff_utils::point> >&, abigail::diff_utils::edit_script&, int&)\",file=\"/home/dodji/git/libabigail/abi-diff/build/../include/abg-diff-utils.h\",fullname=\"/home/dodji/git/libabigail/abi-diff/include/abg-diff-utils.h\",line=\"1322\"}";
 
+static const char* gv_breakpoint_created_async_output0 =
+    "=breakpoint-created,bkpt={number=\"3\",type=\"catchpoint\",disp=\"keep\",enabled=\"y\",what=\"exception throw\",times=\"0\"}\n"
+    "^done\n";
+
+static const char* gv_dprintf_hit_async_output0 =
+    "~\"i = 3\\n\"\n"
+    "=breakpoint-modified,bkpt={number=\"5\",type=\"dprintf\",disp=\"keep\",enabled=\"y\",addr=\"0x0000000000400531\",func=\"main\",file=\"test.c\",fullname=\"/tmp/test.c\",line=\"6\",thread-groups=[\"i1\"],times=\"4\",script={\"printf \\\"i = %d\\\\n\\\", i\"},original-location=\"test.c:6\"}\n"
+    "(gdb)\n";
+
+static const char* gv_breakpoint_deleted_async_output0 =
+    "=breakpoint-deleted,id=\"3\"\n"
+    "^done\n";
+
+static const char* gv_watchpoint_set_output0 =
+    "^done,hw-awpt={number=\"4\",exp=\"counter\"}\n";
+
+static const char* gv_library_loaded_async_output0 =
+    "=library-loaded,id=\"/lib64/libm.so.6\",target-name=\"/lib64/libm.so.6\",host-name=\"/lib64/libm.so.6\",symbols-loaded=\"0\",thread-group=\"i1\",ranges=[{from=\"0x00007ffff7a8f3f0\",to=\"0x00007ffff7b0a6a6\"}]\n"
+    "=library-loaded,id=\"/lib64/libc.so.6\",target-name=\"/lib64/libc.so.6\",host-name=\"/lib64/libc.so.6\",symbols-loaded=\"0\",thread-group=\"i1\",low-address=\"0x00007ffff7838c40\",high-address=\"0x00007ffff7978fcc\"\n"
+    "=library-unloaded,id=\"/lib64/libdl.so.2\",target-name=\"/lib64/libdl.so.2\",host-name=\"/lib64/libdl.so.2\",thread-group=\"i1\"\n"
+    "(gdb)\n";
+
  const char *gv_disassemble0 =
  "asm_insns=[{address=\"0x08048dc3\",func-name=\"main\",offset=\"0\",inst=\"lea    0x4(%esp),%ecx\"},{address=\"0x08048dc7\",func-name=\"main\",offset=\"4\",inst=\"and    $0xfffffff0,%esp\"},{address=\"0x08048dca\",func-name=\"main\",offset=\"7\",inst=\"pushl  -0x4(%ecx)\"},{address=\"0x08048dcd\",func-name=\"main\",offset=\"10\",inst=\"push   %ebp\"},{address=\"0x08048dce\",func-name=\"main\",offset=\"11\",inst=\"mov    %esp,%ebp\"},{address=\"0x08048dd0\",func-name=\"main\",offset=\"13\",inst=\"push   %esi\"},{address=\"0x08048dd1\",func-name=\"main\",offset=\"14\",inst=\"push   %ebx\"},{address=\"0x08048dd2\",func-name=\"main\",offset=\"15\",inst=\"push   %ecx\"},{address=\"0x08048dd3\",func-name=\"main\",offset=\"16\",inst=\"sub    $0x5c,%esp\"},{address=\"0x08048dd6\",func-name=\"main\",offset=\"19\",inst=\"lea    -0x25(%ebp),%eax\"},{address=\"0x08048dd9\",func-name=\"main\",offset=\"22\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048ddc\",func-name=\"main\",offset=\"25\",inst=\"call   0x8048be4 <_ZNSaIcEC1Ev@plt>\"},{address=\"0x08048de1\",func-name=\"main\",offset=\"30\",inst=\"lea    -0x25(%ebp),%eax\"},{address=\"0x08048de4\",func-name=\"main\",offset=\"33\",inst=\"mov    %eax,0x8(%esp)\"},{address=\"0x08048de8\",func-name=\"main\",offset=\"37\",inst=\"movl   $0x8049485,0x4(%esp)\"},{address=\"0x08048df0\",func-name=\"main\",offset=\"45\",inst=\"lea    -0x2c(%ebp),%eax\"},{address=\"0x08048df3\",func-name=\"main\",offset=\"48\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048df6\",func-name=\"main\",offset=\"51\",inst=\"call   0x8048b84 <_ZNSsC1EPKcRKSaIcE@plt>\"},{address=\"0x08048dfb\",func-name=\"main\",offset=\"56\",inst=\"lea    -0x1d(%ebp),%eax\"},{address=\"0x08048dfe\",func-name=\"main\",offset=\"59\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048e01\",func-name=\"main\",offset=\"62\",inst=\"call   0x8048be4 <_ZNSaIcEC1Ev@plt>\"},{address=\"0x08048e06\",func-name=\"main\",offset=\"67\",inst=\"lea    -0x1d(%ebp),%eax\"},{address=\"0x08048e09\",func-name=\"main\",offset=\"70\",inst=\"mov    %eax,0x8(%esp)\"},{address=\"0x08048e0d\",func-name=\"main\",offset=\"74\",inst=\"movl   $0x804948c,0x4(%esp)\"},{address=\"0x08048e15\",func-name=\"main\",offset=\"82\",inst=\"lea    -0x24(%ebp),%eax\"},{address=\"0x08048e18\",func-name=\"main\",offset=\"85\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048e1b\",func-name=\"main\",offset=\"88\",inst=\"call   0x8048b84 <_ZNSsC1EPKcRKSaIcE@plt>\"},{address=\"0x08048e20\",func-name=\"main\",offset=\"93\",inst=\"movl   $0xf,0xc(%esp)\"},{address=\"0x08048e28\",func-name=\"main\",offset=\"101\",inst=\"lea    -0x2c(%ebp),%eax\"},{address=\"0x08048e2b\",func-name=\"main\",offset=\"104\",inst=\"mov    %eax,0x8(%esp)\"},{address=\"0x08048e2f\",func-name=\"main\",offset=\"108\",inst=\"lea    -0x24(%ebp),%eax\"},{address=\"0x08048e32\",func-name=\"main\",offset=\"111\",inst=\"mov    %eax,0x4(%esp)\"},{address=\"0x08048e36\",func-name=\"main\",offset=\"115\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x08048e39\",func-name=\"main\",offset=\"118\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048e3c\",func-name=\"main\",offset=\"121\",inst=\"call   0x8049178 <Person>\"},{address=\"0x08048e41\",func-name=\"main\",offset=\"126\",inst=\"lea    -0x24(%ebp),%eax\"},{address=\"0x08048e44\",func-name=\"main\",offset=\"129\",inst=\"mov    %eax,-0x48(%ebp)\"},{address=\"0x08048e47\",func-name=\"main\",offset=\"132\",inst=\"mov    -0x48(%ebp),%eax\"},{address=\"0x08048e4a\",func-name=\"main\",offset=\"135\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048e4d\",func-name=\"main\",offset=\"138\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08048e52\",func-name=\"main\",offset=\"143\",inst=\"jmp    0x8048e79 <main+182>\"},{address=\"0x08048e54\",func-name=\"main\",offset=\"145\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08048e57\",func-name=\"main\",offset=\"148\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x08048e5a\",func-name=\"main\",offset=\"151\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08048e5d\",func-name=\"main\",offset=\"154\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08048e60\",func-name=\"main\",offset=\"157\",inst=\"lea    -0x24(%ebp),%eax\"},{address=\"0x08048e63\",func-name=\"main\",offset=\"160\",inst=\"mov    %eax,-0x48(%ebp)\"},{address=\"0x08048e66\",func-name=\"main\",offset=\"163\",inst=\"mov    -0x48(%ebp),%eax\"},{address=\"0x08048e69\",func-name=\"main\",offset=\"166\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048e6c\",func-name=\"main\",offset=\"169\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08048e71\",func-name=\"main\",offset=\"174\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08048e74\",func-name=\"main\",offset=\"177\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08048e77\",func-name=\"main\",offset=\"180\",inst=\"jmp    0x8048ebc <main+249>\"},{address=\"0x08048e79\",func-name=\"main\",offset=\"182\",inst=\"lea    -0x1d(%ebp),%eax\"},{address=\"0x08048e7c\",func-name=\"main\",offset=\"185\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048e7f\",func-name=\"main\",offset=\"188\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x08048e84\",func-name=\"main\",offset=\"193\",inst=\"lea    -0x2c(%ebp),%eax\"},{address=\"0x08048e87\",func-name=\"main\",offset=\"196\",inst=\"mov    %eax,-0x4c(%ebp)\"},{address=\"0x08048e8a\",func-name=\"main\",offset=\"199\",inst=\"mov    -0x4c(%ebp),%eax\"},{address=\"0x08048e8d\",func-name=\"main\",offset=\"202\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048e90\",func-name=\"main\",offset=\"205\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08048e95\",func-name=\"main\",offset=\"210\",inst=\"jmp    0x8048ef2 <main+303>\"},{address=\"0x08048e97\",func-name=\"main\",offset=\"212\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08048e9a\",func-name=\"main\",offset=\"215\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x08048e9d\",func-name=\"main\",offset=\"218\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08048ea0\",func-name=\"main\",offset=\"221\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08048ea3\",func-name=\"main\",offset=\"224\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x08048ea6\",func-name=\"main\",offset=\"227\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048ea9\",func-name=\"main\",offset=\"230\",inst=\"call   0x804921a <~Person>\"},{address=\"0x08048eae\",func-name=\"main\",offset=\"235\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08048eb1\",func-name=\"main\",offset=\"238\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08048eb4\",func-name=\"main\",offset=\"241\",inst=\"jmp    0x8048ebc <main+249>\"},{address=\"0x08048eb6\",func-name=\"main\",offset=\"243\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08048eb9\",func-name=\"main\",offset=\"246\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x08048ebc\",func-name=\"main\",offset=\"249\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08048ebf\",func-name=\"main\",offset=\"252\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08048ec2\",func-name=\"main\",offset=\"255\",inst=\"lea    -0x1d(%ebp),%eax\"},{address=\"0x08048ec5\",func-name=\"main\",offset=\"258\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048ec8\",func-name=\"main\",offset=\"261\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x08048ecd\",func-name=\"main\",offset=\"266\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08048ed0\",func-name=\"main\",offset=\"269\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08048ed3\",func-name=\"main\",offset=\"272\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08048ed6\",func-name=\"main\",offset=\"275\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08048ed9\",func-name=\"main\",offset=\"278\",inst=\"lea    -0x2c(%ebp),%eax\"},{address=\"0x08048edc\",func-name=\"main\",offset=\"281\",inst=\"mov    %eax,-0x4c(%ebp)\"},{address=\"0x08048edf\",func-name=\"main\",offset=\"284\",inst=\"mov    -0x4c(%ebp),%eax\"},{address=\"0x08048ee2\",func-name=\"main\",offset=\"287\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048ee5\",func-name=\"main\",offset=\"290\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08048eea\",func-name=\"main\",offset=\"295\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08048eed\",func-name=\"main\",offset=\"298\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08048ef0\",func-name=\"main\",offset=\"301\",inst=\"jmp    0x8048f62 <main+415>\"},{address=\"0x08048ef2\",func-name=\"main\",offset=\"303\",inst=\"lea    -0x25(%ebp),%eax\"},{address=\"0x08048ef5\",func-name=\"main\",offset=\"306\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048ef8\",func-name=\"main\",offset=\"309\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x08048efd\",func-name=\"main\",offset=\"314\",inst=\"call   0x8048cd4 <_Z5func1v>\"},{address=\"0x08048f02\",func-name=\"main\",offset=\"319\",inst=\"movl   $0x2,0x4(%esp)\"},{address=\"0x08048f0a\",func-name=\"main\",offset=\"327\",inst=\"movl   $0x1,(%esp)\"},{address=\"0x08048f11\",func-name=\"main\",offset=\"334\",inst=\"call   0x8048ce7 <_Z5func2ii>\"},{address=\"0x08048f16\",func-name=\"main\",offset=\"339\",inst=\"lea    -0x15(%ebp),%eax\"},{address=\"0x08048f19\",func-name=\"main\",offset=\"342\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048f1c\",func-name=\"main\",offset=\"345\",inst=\"call   0x8048be4 <_ZNSaIcEC1Ev@plt>\"},{address=\"0x08048f21\",func-name=\"main\",offset=\"350\",inst=\"lea    -0x15(%ebp),%eax\"},{address=\"0x08048f24\",func-name=\"main\",offset=\"353\",inst=\"mov    %eax,0x8(%esp)\"},{address=\"0x08048f28\",func-name=\"main\",offset=\"357\",inst=\"movl   $0x8049490,0x4(%esp)\"},{address=\"0x08048f30\",func-name=\"main\",offset=\"365\",inst=\"lea    -0x1c(%ebp),%eax\"},{address=\"0x08048f33\",func-name=\"main\",offset=\"368\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048f36\",func-name=\"main\",offset=\"371\",inst=\"call   0x8048b84 <_ZNSsC1EPKcRKSaIcE@plt>\"},{address=\"0x08048f3b\",func-name=\"main\",offset=\"376\",inst=\"jmp    0x8048f84 <main+449>\"},{address=\"0x08048f3d\",func-name=\"main\",offset=\"378\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08048f40\",func-name=\"main\",offset=\"381\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x08048f43\",func-name=\"main\",offset=\"384\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08048f46\",func-name=\"main\",offset=\"387\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08048f49\",func-name=\"main\",offset=\"390\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x08048f4c\",func-name=\"main\",offset=\"393\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048f4f\",func-name=\"main\",offset=\"396\",inst=\"call   0x804921a <~Person>\"},{address=\"0x08048f54\",func-name=\"main\",offset=\"401\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08048f57\",func-name=\"main\",offset=\"404\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08048f5a\",func-name=\"main\",offset=\"407\",inst=\"jmp    0x8048f62 <main+415>\"},{address=\"0x08048f5c\",func-name=\"main\",offset=\"409\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08048f5f\",func-name=\"main\",offset=\"412\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x08048f62\",func-name=\"main\",offset=\"415\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08048f65\",func-name=\"main\",offset=\"418\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08048f68\",func-name=\"main\",offset=\"421\",inst=\"lea    -0x25(%ebp),%eax\"},{address=\"0x08048f6b\",func-name=\"main\",offset=\"424\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048f6e\",func-name=\"main\",offset=\"427\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x08048f73\",func-name=\"main\",offset=\"432\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08048f76\",func-name=\"main\",offset=\"435\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08048f79\",func-name=\"main\",offset=\"438\",inst=\"mov    -0x54(%ebp),%eax\"},{address=\"0x08048f7c\",func-name=\"main\",offset=\"441\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048f7f\",func-name=\"main\",offset=\"444\",inst=\"call   0x8048bd4 <_Unwind_Resume@plt>\"},{address=\"0x08048f84\",func-name=\"main\",offset=\"449\",inst=\"lea    -0x1c(%ebp),%eax\"},{address=\"0x08048f87\",func-name=\"main\",offset=\"452\",inst=\"mov    %eax,0x4(%esp)\"},{address=\"0x08048f8b\",func-name=\"main\",offset=\"456\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x08048f8e\",func-name=\"main\",offset=\"459\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048f91\",func-name=\"main\",offset=\"462\",inst=\"call   0x8049140 <_ZN6Person14set_first_nameERKSs>\"},{address=\"0x08048f96\",func-name=\"main\",offset=\"467\",inst=\"lea    -0x1c(%ebp),%eax\"},{address=\"0x08048f99\",func-name=\"main\",offset=\"470\",inst=\"mov    %eax,-0x44(%ebp)\"},{address=\"0x08048f9c\",func-name=\"main\",offset=\"473\",inst=\"mov    -0x44(%ebp),%eax\"},{address=\"0x08048f9f\",func-name=\"main\",offset=\"476\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048fa2\",func-name=\"main\",offset=\"479\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08048fa7\",func-name=\"main\",offset=\"484\",inst=\"jmp    0x8048fce <main+523>\"},{address=\"0x08048fa9\",func-name=\"main\",offset=\"486\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08048fac\",func-name=\"main\",offset=\"489\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x08048faf\",func-name=\"main\",offset=\"492\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08048fb2\",func-name=\"main\",offset=\"495\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08048fb5\",func-name=\"main\",offset=\"498\",inst=\"lea    -0x1c(%ebp),%eax\"},{address=\"0x08048fb8\",func-name=\"main\",offset=\"501\",inst=\"mov    %eax,-0x44(%ebp)\"},{address=\"0x08048fbb\",func-name=\"main\",offset=\"504\",inst=\"mov    -0x44(%ebp),%eax\"},{address=\"0x08048fbe\",func-name=\"main\",offset=\"507\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048fc1\",func-name=\"main\",offset=\"510\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08048fc6\",func-name=\"main\",offset=\"515\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08048fc9\",func-name=\"main\",offset=\"518\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08048fcc\",func-name=\"main\",offset=\"521\",inst=\"jmp    0x8049006 <main+579>\"},{address=\"0x08048fce\",func-name=\"main\",offset=\"523\",inst=\"lea    -0x15(%ebp),%eax\"},{address=\"0x08048fd1\",func-name=\"main\",offset=\"526\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048fd4\",func-name=\"main\",offset=\"529\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x08048fd9\",func-name=\"main\",offset=\"534\",inst=\"lea    -0xd(%ebp),%eax\"},{address=\"0x08048fdc\",func-name=\"main\",offset=\"537\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048fdf\",func-name=\"main\",offset=\"540\",inst=\"call   0x8048be4 <_ZNSaIcEC1Ev@plt>\"},{address=\"0x08048fe4\",func-name=\"main\",offset=\"545\",inst=\"lea    -0xd(%ebp),%eax\"},{address=\"0x08048fe7\",func-name=\"main\",offset=\"548\",inst=\"mov    %eax,0x8(%esp)\"},{address=\"0x08048feb\",func-name=\"main\",offset=\"552\",inst=\"movl   $0x8049494,0x4(%esp)\"},{address=\"0x08048ff3\",func-name=\"main\",offset=\"560\",inst=\"lea    -0x14(%ebp),%eax\"},{address=\"0x08048ff6\",func-name=\"main\",offset=\"563\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08048ff9\",func-name=\"main\",offset=\"566\",inst=\"call   0x8048b84 <_ZNSsC1EPKcRKSaIcE@plt>\"},{address=\"0x08048ffe\",func-name=\"main\",offset=\"571\",inst=\"jmp    0x8049022 <main+607>\"},{address=\"0x08049000\",func-name=\"main\",offset=\"573\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08049003\",func-name=\"main\",offset=\"576\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x08049006\",func-name=\"main\",offset=\"579\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08049009\",func-name=\"main\",offset=\"582\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x0804900c\",func-name=\"main\",offset=\"585\",inst=\"lea    -0x15(%ebp),%eax\"},{address=\"0x0804900f\",func-name=\"main\",offset=\"588\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08049012\",func-name=\"main\",offset=\"591\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x08049017\",func-name=\"main\",offset=\"596\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x0804901a\",func-name=\"main\",offset=\"599\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x0804901d\",func-name=\"main\",offset=\"602\",inst=\"jmp    0x80490fa <main+823>\"},{address=\"0x08049022\",func-name=\"main\",offset=\"607\",inst=\"lea    -0x14(%ebp),%eax\"},{address=\"0x08049025\",func-name=\"main\",offset=\"610\",inst=\"mov    %eax,0x4(%esp)\"},{address=\"0x08049029\",func-name=\"main\",offset=\"614\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x0804902c\",func-name=\"main\",offset=\"617\",inst=\"mov    %eax,(%esp)\"},{address=\"0x0804902f\",func-name=\"main\",offset=\"620\",inst=\"call   0x804915a <_ZN6Person15set_family_nameERKSs>\"},{address=\"0x08049034\",func-name=\"main\",offset=\"625\",inst=\"lea    -0x14(%ebp),%eax\"},{address=\"0x08049037\",func-name=\"main\",offset=\"628\",inst=\"mov    %eax,-0x40(%ebp)\"},{address=\"0x0804903a\",func-name=\"main\",offset=\"631\",inst=\"mov    -0x40(%ebp),%eax\"},{address=\"0x0804903d\",func-name=\"main\",offset=\"634\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08049040\",func-name=\"main\",offset=\"637\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08049045\",func-name=\"main\",offset=\"642\",inst=\"jmp    0x804906c <main+681>\"},{address=\"0x08049047\",func-name=\"main\",offset=\"644\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x0804904a\",func-name=\"main\",offset=\"647\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x0804904d\",func-name=\"main\",offset=\"650\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x08049050\",func-name=\"main\",offset=\"653\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08049053\",func-name=\"main\",offset=\"656\",inst=\"lea    -0x14(%ebp),%eax\"},{address=\"0x08049056\",func-name=\"main\",offset=\"659\",inst=\"mov    %eax,-0x40(%ebp)\"},{address=\"0x08049059\",func-name=\"main\",offset=\"662\",inst=\"mov    -0x40(%ebp),%eax\"},{address=\"0x0804905c\",func-name=\"main\",offset=\"665\",inst=\"mov    %eax,(%esp)\"},{address=\"0x0804905f\",func-name=\"main\",offset=\"668\",inst=\"call   0x8048bb4 <_ZNSsD1Ev@plt>\"},{address=\"0x08049064\",func-name=\"main\",offset=\"673\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x08049067\",func-name=\"main\",offset=\"676\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x0804906a\",func-name=\"main\",offset=\"679\",inst=\"jmp    0x804908a <main+711>\"},{address=\"0x0804906c\",func-name=\"main\",offset=\"681\",inst=\"lea    -0xd(%ebp),%eax\"},{address=\"0x0804906f\",func-name=\"main\",offset=\"684\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08049072\",func-name=\"main\",offset=\"687\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x08049077\",func-name=\"main\",offset=\"692\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x0804907a\",func-name=\"main\",offset=\"695\",inst=\"mov    %eax,(%esp)\"},{address=\"0x0804907d\",func-name=\"main\",offset=\"698\",inst=\"call   0x8049272 <_ZN6Person7do_thisEv>\"},{address=\"0x08049082\",func-name=\"main\",offset=\"703\",inst=\"jmp    0x80490a3 <main+736>\"},{address=\"0x08049084\",func-name=\"main\",offset=\"705\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x08049087\",func-name=\"main\",offset=\"708\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x0804908a\",func-name=\"main\",offset=\"711\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x0804908d\",func-name=\"main\",offset=\"714\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08049090\",func-name=\"main\",offset=\"717\",inst=\"lea    -0xd(%ebp),%eax\"},{address=\"0x08049093\",func-name=\"main\",offset=\"720\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08049096\",func-name=\"main\",offset=\"723\",inst=\"call   0x8048b74 <_ZNSaIcED1Ev@plt>\"},{address=\"0x0804909b\",func-name=\"main\",offset=\"728\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x0804909e\",func-name=\"main\",offset=\"731\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x080490a1\",func-name=\"main\",offset=\"734\",inst=\"jmp    0x80490fa <main+823>\"},{address=\"0x080490a3\",func-name=\"main\",offset=\"736\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x080490a6\",func-name=\"main\",offset=\"739\",inst=\"mov    %eax,(%esp)\"},{address=\"0x080490a9\",func-name=\"main\",offset=\"742\",inst=\"call   0x804911c <_ZN6Person8overloadEv>\"},{address=\"0x080490ae\",func-name=\"main\",offset=\"747\",inst=\"movl   $0x0,0x4(%esp)\"},{address=\"0x080490b6\",func-name=\"main\",offset=\"755\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x080490b9\",func-name=\"main\",offset=\"758\",inst=\"mov    %eax,(%esp)\"},{address=\"0x080490bc\",func-name=\"main\",offset=\"761\",inst=\"call   0x8049130 <_ZN6Person8overloadEi>\"},{address=\"0x080490c1\",func-name=\"main\",offset=\"766\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x080490c4\",func-name=\"main\",offset=\"769\",inst=\"mov    %eax,(%esp)\"},{address=\"0x080490c7\",func-name=\"main\",offset=\"772\",inst=\"call   0x8048db0 <_Z5func3R6Person>\"},{address=\"0x080490cc\",func-name=\"main\",offset=\"777\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x080490cf\",func-name=\"main\",offset=\"780\",inst=\"mov    %eax,(%esp)\"},{address=\"0x080490d2\",func-name=\"main\",offset=\"783\",inst=\"call   0x8048cff <_Z5func4R6Person>\"},{address=\"0x080490d7\",func-name=\"main\",offset=\"788\",inst=\"mov    $0x0,%ebx\"},{address=\"0x080490dc\",func-name=\"main\",offset=\"793\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x080490df\",func-name=\"main\",offset=\"796\",inst=\"mov    %eax,(%esp)\"},{address=\"0x080490e2\",func-name=\"main\",offset=\"799\",inst=\"call   0x804921a <~Person>\"},{address=\"0x080490e7\",func-name=\"main\",offset=\"804\",inst=\"mov    %ebx,%eax\"},{address=\"0x080490e9\",func-name=\"main\",offset=\"806\",inst=\"add    $0x5c,%esp\"},{address=\"0x080490ec\",func-name=\"main\",offset=\"809\",inst=\"pop    %ecx\"},{address=\"0x080490ed\",func-name=\"main\",offset=\"810\",inst=\"pop    %ebx\"},{address=\"0x080490ee\",func-name=\"main\",offset=\"811\",inst=\"pop    %esi\"},{address=\"0x080490ef\",func-name=\"main\",offset=\"812\",inst=\"pop    %ebp\"},{address=\"0x080490f0\",func-name=\"main\",offset=\"813\",inst=\"lea    -0x4(%ecx),%esp\"},{address=\"0x080490f3\",func-name=\"main\",offset=\"816\",inst=\"ret    \"},{address=\"0x080490f4\",func-name=\"main\",offset=\"817\",inst=\"mov    %eax,-0x54(%ebp)\"},{address=\"0x080490f7\",func-name=\"main\",offset=\"820\",inst=\"mov    %edx,-0x50(%ebp)\"},{address=\"0x080490fa\",func-name=\"main\",offset=\"823\",inst=\"mov    -0x50(%ebp),%esi\"},{address=\"0x080490fd\",func-name=\"main\",offset=\"826\",inst=\"mov    -0x54(%ebp),%ebx\"},{address=\"0x08049100\",func-name=\"main\",offset=\"829\",inst=\"lea    -0x38(%ebp),%eax\"},{address=\"0x08049103\",func-name=\"main\",offset=\"832\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08049106\",func-name=\"main\",offset=\"835\",inst=\"call   0x804921a <~Person>\"},{address=\"0x0804910b\",func-name=\"main\",offset=\"840\",inst=\"mov    %ebx,-0x54(%ebp)\"},{address=\"0x0804910e\",func-name=\"main\",offset=\"843\",inst=\"mov    %esi,-0x50(%ebp)\"},{address=\"0x08049111\",func-name=\"main\",offset=\"846\",inst=\"mov    -0x54(%ebp),%eax\"},{address=\"0x08049114\",func-name=\"main\",offset=\"849\",inst=\"mov    %eax,(%esp)\"},{address=\"0x08049117\",func-name=\"main\",offset=\"852\",inst=\"call   0x8048bd4 <_Unwind_Resume@plt>\"}]";
   
@@ -266,6 +299,29 @@ test_str4 ()
     BOOST_REQUIRE_MESSAGE (res == "\"Eins\"", "res was: " << res);
 }
 
+void
+test_str5 ()
+{
+    bool is_ok =false;
+
+    UString res;
+    UString::size_type to=0;
+
+    GDBMIParser parser (gv_str5);
+
+    // An escaped backslash right before the closing double quote
+    // must not be taken for an escaped double quote.
+    is_ok = parser.parse_c_string (0, to, res);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE_MESSAGE (res == "C:\\\\", "res was: " << res);
+    BOOST_REQUIRE_EQUAL (to, 6u);
+
+    // A byte that is not valid UTF-8 is kept as an escape sequence.
+    is_ok = parser.parse_c_string (to + 1, to, res);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE_MESSAGE (res == "caf\\351", "res was: " << res);
+}
+
 
 void
 test_attr0 ()
@@ -315,6 +371,28 @@ test_stoppped_async_output ()
     BOOST_REQUIRE (is_ok);
     BOOST_REQUIRE (got_frame);
     BOOST_REQUIRE (attrs.size ());
+
+    to=0;
+    attrs.clear ();
+    parser.push_input (gv_stopped_async_output2);
+    is_ok = parser.parse_stopped_async_output (0, to, got_frame, frame, attrs);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE (got_frame);
+    BOOST_REQUIRE (attrs["thread-id"] == "2");
+}
+
+void
+test_new_thread_id ()
+{
+    UString::size_type to=0;
+    int thread_id=0;
+    IDebugger::Frame frame;
+
+    GDBMIParser parser (gv_new_thread_id0);
+    bool is_ok = parser.parse_new_thread_id (0, to, thread_id, frame);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE (thread_id == 3);
+    BOOST_REQUIRE (frame.function_name ().empty ());
 }
 
 void
@@ -939,6 +1017,19 @@ test_breakpoint ()
     BOOST_REQUIRE_EQUAL (breakpoint.sub_breakpoints ()[0].id (), "2.1");
     BOOST_REQUIRE_EQUAL (breakpoint.sub_breakpoints ()[1].id (), "2.2");
 
+    parser.push_input (gv_breakpoint4);
+    breakpoint.clear ();
+    is_ok = parser.parse_breakpoint (0, cur, breakpoint);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE_EQUAL (breakpoint.condition (), "j == 900");
+    BOOST_REQUIRE (breakpoint.is_condition_evaluated_by_target ());
+
+    parser.push_input (gv_breakpoint1);
+    breakpoint.clear ();
+    is_ok = parser.parse_breakpoint (0, cur, breakpoint);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE (!breakpoint.is_condition_evaluated_by_target ());
+
     parser.push_input (gv_breakpoint_modified_async_output0);
     breakpoint.clear ();
     is_ok = parser.parse_breakpoint_modified_async_output (0, cur, breakpoint);
@@ -949,6 +1040,96 @@ test_breakpoint ()
     BOOST_REQUIRE_EQUAL (breakpoint.sub_breakpoints ()[9].id (), "2.10");
 }
 
+void
+test_breakpoint_notifications ()
+{
+    UString::size_type to = 0;
+    Output output;
+
+    GDBMIParser parser (gv_breakpoint_created_async_output0);
+    bool is_ok = parser.parse_output_record (0, to, output);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE (output.has_out_of_band_record ());
+    Output::OutOfBandRecord &created =
+        output.out_of_band_records ().front ();
+    BOOST_REQUIRE (created.has_modified_breakpoint ());
+    BOOST_REQUIRE_EQUAL (created.modified_breakpoint ().id (), "3");
+
+    output.clear ();
+    parser.push_input (gv_breakpoint_deleted_async_output0);
+    is_ok = parser.parse_output_record (0, to, output);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE (output.has_out_of_band_record ());
+    Output::OutOfBandRecord &deleted =
+        output.out_of_band_records ().front ();
+    BOOST_REQUIRE (deleted.has_deleted_breakpoint ());
+    BOOST_REQUIRE_EQUAL (deleted.deleted_breakpoint_id (), "3");
+
+    output.clear ();
+    parser.push_input (gv_dprintf_hit_async_output0);
+    is_ok = parser.parse_output_record (0, to, output);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE_EQUAL (output.out_of_band_records ().size (), 2);
+    Output::OutOfBandRecord &printed =
+        output.out_of_band_records ().front ();
+    BOOST_REQUIRE (printed.has_stream_record ());
+    BOOST_REQUIRE_EQUAL (printed.stream_record ().debugger_console (),
+                         "i = 3\n");
+    Output::OutOfBandRecord &hit = output.out_of_band_records ().back ();
+    BOOST_REQUIRE (hit.has_modified_breakpoint ());
+    BOOST_REQUIRE_EQUAL (hit.modified_breakpoint ().id (), "5");
+    BOOST_REQUIRE_EQUAL (hit.modified_breakpoint ().type (),
+                         IDebugger::Breakpoint::DPRINTF_TYPE);
+    BOOST_REQUIRE_EQUAL (hit.modified_breakpoint ().nb_times_hit (), 4);
+    BOOST_REQUIRE (hit.modified_breakpoint ().is_traced ());
+
+    output.clear ();
+    parser.push_input (gv_watchpoint_set_output0);
+    is_ok = parser.parse_output_record (0, to, output);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE (output.has_result_record ());
+    BOOST_REQUIRE_EQUAL
+        (output.result_record ().attrs ().find ("watchpoint-number")->second,
+         "4");
+}
+
+void
+test_library_notifications ()
+{
+    UString::size_type to = 0;
+    Output output;
+
+    GDBMIParser parser (gv_library_loaded_async_output0);
+    bool is_ok = parser.parse_output_record (0, to, output);
+    BOOST_REQUIRE (is_ok);
+    BOOST_REQUIRE_EQUAL (output.out_of_band_records ().size (), 3);
+
+    Output::OutOfBandRecords::const_iterator it =
+        output.out_of_band_records ().begin ();
+    BOOST_REQUIRE (it->library_event ());
+    BOOST_REQUIRE (it->library_loaded ());
+    BOOST_REQUIRE_EQUAL (it->library ().id (), "/lib64/libm.so.6");
+    BOOST_REQUIRE_EQUAL (it->library ().thread_group (), "i1");
+    BOOST_REQUIRE (!it->library ().symbols_loaded ());
+    BOOST_REQUIRE_EQUAL (it->library ().address_ranges ().size (), 1);
+    BOOST_REQUIRE (it->library ().contains_address (0x7ffff7a8f3f0));
+    BOOST_REQUIRE (!it->library ().contains_address (0x7ffff7b0a6a6));
+
+    // Older versions of GDB give the address range of the library
+    // with the low-address and high-address attributes.
+    ++it;
+    BOOST_REQUIRE (it->library_event ());
+    BOOST_REQUIRE (it->library_loaded ());
+    BOOST_REQUIRE_EQUAL (it->library ().id (), "/lib64/libc.so.6");
+    BOOST_REQUIRE (it->library ().contains_address (0x7ffff7900000));
+
+    ++it;
+    BOOST_REQUIRE (it->library_event ());
+    BOOST_REQUIRE (!it->library_loaded ());
+    BOOST_REQUIRE_EQUAL (it->library ().id (), "/lib64/libdl.so.2");
+    BOOST_REQUIRE (it->library ().address_ranges ().empty ());
+}
+
 void
 test_disassemble ()
 {
@@ -1031,9 +1212,11 @@ init_unit_test_suite (int argc, char **argv)
     suite->add (BOOST_TEST_CASE (&test_str2));
     suite->add (BOOST_TEST_CASE (&test_str3));
     suite->add (BOOST_TEST_CASE (&test_str4));
+    suite->add (BOOST_TEST_CASE (&test_str5));
     suite->add (BOOST_TEST_CASE (&test_attr0));
     suite->add (BOOST_TEST_CASE (&test_stoppped_async_output));
     suite->add (BOOST_TEST_CASE (&test_running_async_output));
+    suite->add (BOOST_TEST_CASE (&test_new_thread_id));
     suite->add (BOOST_TEST_CASE (&test_var_list_children));
     suite->add (BOOST_TEST_CASE (&test_output_record));
     suite->add (BOOST_TEST_CASE (&test_stack0));
@@ -1052,6 +1235,8 @@ init_unit_test_suite (int argc, char **argv)
     suite->add (BOOST_TEST_CASE (&test_gdbmi_result));
     suite->add (BOOST_TEST_CASE (&test_breakpoint_table));
     suite->add (BOOST_TEST_CASE (&test_breakpoint));
+    suite->add (BOOST_TEST_CASE (&test_breakpoint_notifications));
+    suite->add (BOOST_TEST_CASE (&test_library_notifications));
     suite->add (BOOST_TEST_CASE (&test_disassemble));
     suite->add (BOOST_TEST_CASE (&test_file_list));
     return suite;
@@ -0,0 +1,141 @@
+#include "config.h"
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+#include <boost/test/minimal.hpp>
+#include <glibmm.h>
+#include <glib/gstdio.h>
+#include "common/nmv-initializer.h"
+#include "common/nmv-safe-ptr-utils.h"
+#include "nmv-i-debugger.h"
+#include "nmv-debugger-utils.h"
+
+// Drive the engine against fakegdb (see fake-gdb.cc), which answers
+// -exec-run with a burst of library events, in the middle of which
+// GDB resolves a breakpoint again.  Check that the whole burst is
+// notified by a single libraries_changed_signal, and that the
+// breakpoint is notified once, after the libraries.
+
+using namespace nemiver;
+using namespace nemiver::common;
+
+Glib::RefPtr<Glib::MainLoop> loop =
+    Glib::MainLoop::create (Glib::MainContext::get_default ());
+
+static int nb_libraries_changed;
+static int nb_breakpoints_set;
+static bool breakpoint_set_after_libraries;
+
+static const char *SCRIPT =
+"# The burst of library events that follows -exec-run.\n"
+"<- -exec-run\n"
+"^running\n"
+"*running,thread-id=\"all\"\n"
+"(gdb)\n"
+"=library-loaded,id=\"/lib64/libm.so.6\",target-name=\"/lib64/libm.so.6\","
+"host-name=\"/lib64/libm.so.6\",symbols-loaded=\"0\",thread-group=\"i1\","
+"ranges=[{from=\"0x00007ffff7a8f3f0\",to=\"0x00007ffff7b0a6a6\"}]\n"
+"=breakpoint-modified,bkpt={number=\"1\",type=\"breakpoint\","
+"disp=\"keep\",enabled=\"y\",addr=\"0x00007ffff7a90000\",func=\"sin\","
+"file=\"s_sin.c\",fullname=\"/tmp/s_sin.c\",line=\"10\","
+"thread-groups=[\"i1\"],times=\"0\",original-location=\"sin\"}\n"
+"=library-loaded,id=\"/lib64/libc.so.6\",target-name=\"/lib64/libc.so.6\","
+"host-name=\"/lib64/libc.so.6\",symbols-loaded=\"0\",thread-group=\"i1\","
+"ranges=[{from=\"0x00007ffff7838c40\",to=\"0x00007ffff7978fcc\"}]\n"
+"=library-unloaded,id=\"/lib64/libdl.so.2\","
+"target-name=\"/lib64/libdl.so.2\",host-name=\"/lib64/libdl.so.2\","
+"thread-group=\"i1\"\n";
+
+void
+on_engine_died_signal ()
+{
+    MESSAGE ("engine died");
+    loop->quit ();
+}
+
+void
+on_libraries_changed_signal ()
+{
+    MESSAGE ("libraries changed");
+    ++nb_libraries_changed;
+}
+
+void
+on_breakpoints_set_signal
+                (const std::map<string, IDebugger::Breakpoint> &a_breaks,
+                 const UString &/*a_cookie*/)
+{
+    if (a_breaks.find ("1") == a_breaks.end ())
+        return;
+    MESSAGE ("breakpoint 1 set");
+    ++nb_breakpoints_set;
+    breakpoint_set_after_libraries = (nb_libraries_changed == 1);
+}
+
+bool
+on_timeout ()
+{
+    // The burst is long over by now.
+    loop->quit ();
+    return false;
+}
+
+NEMIVER_API int
+test_main (int, char **)
+{
+    string script_path;
+
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    THROW_IF_FAIL (loop);
+
+    int fd = Glib::file_open_tmp (script_path, "nemiver-fake-gdb");
+    close (fd);
+    {
+        std::ofstream out (script_path.c_str ());
+        THROW_IF_FAIL (out.good ());
+        out << SCRIPT;
+    }
+    Glib::setenv ("NEMIVER_FAKE_GDB_SCRIPT", script_path, true);
+
+    IDebuggerSafePtr debugger =
+        debugger_utils::load_debugger_iface_with_confmgr ();
+
+    debugger->set_event_loop_context (loop->get_context ());
+    debugger->set_non_persistent_debugger_path
+                                    (NEMIVER_BUILDDIR "/fakegdb");
+
+    //*****************************
+    //<connect to IDebugger events>
+    //*****************************
+    debugger->engine_died_signal ().connect (&on_engine_died_signal);
+
+    debugger->libraries_changed_signal ().connect
+                                        (&on_libraries_changed_signal);
+
+    debugger->breakpoints_set_signal ().connect
+                                        (&on_breakpoints_set_signal);
+
+    // The inferior is never run for real, so any existing file will
+    // do as far as GDBEngine is concerned.
+    std::vector<UString> args;
+    debugger->load_program (NEMIVER_BUILDDIR "/fakegdb", args, ".");
+    debugger->run ();
+
+    Glib::signal_timeout ().connect (&on_timeout, 2000);
+    loop->run ();
+
+    debugger->exit_engine ();
+
+    NEMIVER_CATCH_NOX
+
+    if (!script_path.empty ())
+        g_unlink (script_path.c_str ());
+
+    BOOST_REQUIRE (nb_libraries_changed == 1);
+    BOOST_REQUIRE (nb_breakpoints_set == 1);
+    BOOST_REQUIRE (breakpoint_set_after_libraries);
+    return 0;
+}
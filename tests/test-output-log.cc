@@ -0,0 +1,130 @@
+#include "config.h"
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <glibmm.h>
+#include "common/nmv-output-log.h"
+#include "common/nmv-initializer.h"
+#include "common/nmv-exception.h"
+
+using namespace std;
+using namespace nemiver;
+using nemiver::common::Initializer;
+using nemiver::common::OutputLog;
+
+void
+test_lines ()
+{
+    OutputLog log;
+    string text;
+
+    BOOST_REQUIRE_EQUAL (log.size (), 0u);
+    BOOST_REQUIRE_EQUAL (log.num_lines (), 1u);
+
+    BOOST_REQUIRE (log.append ("hello\nwor", 9));
+    BOOST_REQUIRE (log.append ("ld!\nfoo bar\n", 12));
+    BOOST_REQUIRE_EQUAL (log.size (), 21u);
+    BOOST_REQUIRE_EQUAL (log.num_lines (), 4u);
+    BOOST_REQUIRE_EQUAL (log.line_offset (1), 6u);
+    BOOST_REQUIRE_EQUAL (log.line_offset (2), 13u);
+    BOOST_REQUIRE_EQUAL (log.line_offset (42), log.size ());
+    BOOST_REQUIRE_EQUAL (log.offset_to_line (0), 0u);
+    BOOST_REQUIRE_EQUAL (log.offset_to_line (8), 1u);
+
+    BOOST_REQUIRE (log.read (6, 6, text));
+    BOOST_REQUIRE_EQUAL (text, "world!");
+    BOOST_REQUIRE (log.read (13, 100, text));
+    BOOST_REQUIRE_EQUAL (text, "foo bar\n");
+
+    log.clear ();
+    BOOST_REQUIRE_EQUAL (log.size (), 0u);
+    BOOST_REQUIRE_EQUAL (log.num_lines (), 1u);
+    BOOST_REQUIRE (log.append ("x\n", 2));
+    BOOST_REQUIRE (log.read (0, 10, text));
+    BOOST_REQUIRE_EQUAL (text, "x\n");
+}
+
+void
+test_find_and_stops ()
+{
+    OutputLog log;
+    size_t line = 0;
+
+    BOOST_REQUIRE (!log.find ("foo", 0, line));
+
+    log.append ("first line\n", 11);
+    size_t stop = log.mark_stop ();
+    BOOST_REQUIRE_EQUAL (stop, 0u);
+    log.append ("second line\nthird foo\n", 22);
+    BOOST_REQUIRE_EQUAL (log.mark_stop (), 1u);
+    BOOST_REQUIRE_EQUAL (log.num_stops (), 2u);
+
+    BOOST_REQUIRE (log.find ("foo", 0, line));
+    BOOST_REQUIRE_EQUAL (line, 2u);
+    BOOST_REQUIRE (log.find ("line", 1, line));
+    BOOST_REQUIRE_EQUAL (line, 1u);
+    BOOST_REQUIRE (!log.find ("first", 1, line));
+    BOOST_REQUIRE (!log.find ("nothing", 0, line));
+
+    BOOST_REQUIRE (log.stop_to_line (0, line));
+    BOOST_REQUIRE_EQUAL (line, 1u);
+    BOOST_REQUIRE (log.stop_to_line (1, line));
+    BOOST_REQUIRE_EQUAL (line, 3u);
+    BOOST_REQUIRE (!log.stop_to_line (2, line));
+}
+
+void
+test_trim ()
+{
+    // Keep at most 32 bytes.  Once past that, only the lines that
+    // fit in the last 16 bytes are kept.
+    OutputLog log (32);
+    std::string text;
+    size_t line = 0;
+
+    log.append ("0123456789\n", 11);
+    BOOST_REQUIRE_EQUAL (log.mark_stop (), 0u);
+    log.append ("abcdefghij\n", 11);
+    BOOST_REQUIRE_EQUAL (log.mark_stop (), 1u);
+    BOOST_REQUIRE_EQUAL (log.num_discarded_bytes (), 0u);
+    log.append ("klmnopqrst\n", 11);
+    BOOST_REQUIRE_EQUAL (log.mark_stop (), 2u);
+
+    BOOST_REQUIRE_EQUAL (log.num_discarded_bytes (), 22u);
+    BOOST_REQUIRE_EQUAL (log.size (), 11u);
+    BOOST_REQUIRE_EQUAL (log.num_lines (), 2u);
+    BOOST_REQUIRE_EQUAL (log.line_offset (1), 11u);
+    BOOST_REQUIRE (log.read (0, 100, text));
+    BOOST_REQUIRE_EQUAL (text, "klmnopqrst\n");
+    BOOST_REQUIRE (!log.find ("abc", 0, line));
+    BOOST_REQUIRE (log.find ("pqr", 0, line));
+    BOOST_REQUIRE_EQUAL (line, 0u);
+
+    // Stop numbers are not rebased.
+    BOOST_REQUIRE_EQUAL (log.num_stops (), 3u);
+    BOOST_REQUIRE (!log.stop_to_line (0, line));
+    BOOST_REQUIRE (log.stop_to_line (2, line));
+    BOOST_REQUIRE_EQUAL (line, 1u);
+    BOOST_REQUIRE_EQUAL (log.mark_stop (), 3u);
+}
+
+using boost::unit_test::test_suite;
+
+NEMIVER_API test_suite*
+init_unit_test_suite (int argc, char** argv)
+{
+    if (argc || argv) {/*keep compiler happy*/}
+
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    test_suite *suite = BOOST_TEST_SUITE ("Output log tests");
+    suite->add (BOOST_TEST_CASE (&test_lines));
+    suite->add (BOOST_TEST_CASE (&test_find_and_stops));
+    suite->add (BOOST_TEST_CASE (&test_trim));
+    return suite;
+
+    NEMIVER_CATCH_NOX
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "config.h"
+#include <set>
+#include <boost/test/unit_test.hpp>
+#include <glibmm.h>
+#include "common/nmv-pool-allocator.h"
+#include "common/nmv-str-utils.h"
+#include "common/nmv-object.h"
+#include "common/nmv-initializer.h"
+#include "common/nmv-exception.h"
+
+using namespace std;
+using namespace nemiver;
+using nemiver::common::Initializer;
+using nemiver::common::PoolAllocator;
+using nemiver::common::Object;
+using nemiver::common::UString;
+
+void
+test_allocate_and_recycle ()
+{
+    PoolAllocator pool (24, 4);
+    BOOST_REQUIRE (pool.block_size () >= 24);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 0u);
+
+    set<void*> blocks;
+    for (int i = 0; i < 6; ++i)
+        blocks.insert (pool.allocate (24));
+    BOOST_REQUIRE_EQUAL (blocks.size (), 6u);
+    BOOST_REQUIRE_EQUAL (pool.num_allocated (), 6u);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 8u);
+
+    // A deallocated block is handed out again.
+    void *block = *blocks.begin ();
+    pool.deallocate (block, 24);
+    BOOST_REQUIRE_EQUAL (pool.num_allocated (), 5u);
+    BOOST_REQUIRE_EQUAL (pool.allocate (24), block);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 8u);
+
+    // Blocks that are too big for the pool come from the heap.
+    void *big = pool.allocate (pool.block_size () + 1);
+    BOOST_REQUIRE (big);
+    BOOST_REQUIRE_EQUAL (pool.num_allocated (), 6u);
+    pool.deallocate (big, pool.block_size () + 1);
+
+    set<void*>::iterator it;
+    for (it = blocks.begin (); it != blocks.end (); ++it)
+        pool.deallocate (*it, 24);
+    BOOST_REQUIRE_EQUAL (pool.num_allocated (), 0u);
+
+    BOOST_REQUIRE_EQUAL (&PoolAllocator::get (40),
+                         &PoolAllocator::get (40));
+}
+
+static int gv_nb_releases = 0;
+
+static void
+on_release ()
+{
+    ++gv_nb_releases;
+}
+
+void
+test_release_when_unused ()
+{
+    PoolAllocator pool (24, 4);
+
+    void *block0 = pool.allocate (24);
+    void *block1 = pool.allocate (24);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 4u);
+
+    // The memory is only released once the last block is given back.
+    pool.release_when_unused (&on_release);
+    BOOST_REQUIRE_EQUAL (gv_nb_releases, 0);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 4u);
+    pool.deallocate (block0, 24);
+    BOOST_REQUIRE_EQUAL (gv_nb_releases, 0);
+    pool.deallocate (block1, 24);
+    BOOST_REQUIRE_EQUAL (gv_nb_releases, 1);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 0u);
+
+    // The pool remains usable, and doesn't release by itself anymore.
+    block0 = pool.allocate (24);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 4u);
+    pool.deallocate (block0, 24);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 4u);
+    BOOST_REQUIRE_EQUAL (gv_nb_releases, 1);
+
+    // An unused pool is released right away.
+    pool.release_when_unused (&on_release);
+    BOOST_REQUIRE_EQUAL (pool.num_reserved (), 0u);
+    BOOST_REQUIRE_EQUAL (gv_nb_releases, 2);
+}
+
+void
+test_intern ()
+{
+    UString type0 ("std::vector<int>"), type1 ("std::vector<int>");
+    const UString &interned0 = str_utils::intern (type0);
+    const UString &interned1 = str_utils::intern (type1);
+    BOOST_REQUIRE_EQUAL (&interned0, &interned1);
+    BOOST_REQUIRE_EQUAL (interned0, type0);
+    BOOST_REQUIRE (&str_utils::intern ("int") != &interned0);
+
+    str_utils::clear_interned_strings ();
+    BOOST_REQUIRE_EQUAL (str_utils::intern (type0), type0);
+}
+
+void
+test_object_attachments ()
+{
+    Object *object = new Object;
+    const Object *attached = 0;
+    BOOST_REQUIRE (!object->get_attached_object ("foo", attached));
+
+    Object other;
+    object->attach_object ("foo", &other);
+    BOOST_REQUIRE (object->get_attached_object ("foo", attached));
+    BOOST_REQUIRE_EQUAL (attached, &other);
+
+    object->ref ();
+    BOOST_REQUIRE_EQUAL (object->get_refcount (), 2);
+    object->unref ();
+    BOOST_REQUIRE_EQUAL (object->get_refcount (), 1);
+    object->unref ();
+}
+
+using boost::unit_test::test_suite;
+
+NEMIVER_API test_suite*
+init_unit_test_suite (int argc, char** argv)
+{
+    if (argc || argv) {/*keep compiler happy*/}
+
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    test_suite *suite = BOOST_TEST_SUITE ("Pool allocator tests");
+    suite->add (BOOST_TEST_CASE (&test_allocate_and_recycle));
+    suite->add (BOOST_TEST_CASE (&test_release_when_unused));
+    suite->add (BOOST_TEST_CASE (&test_intern));
+    suite->add (BOOST_TEST_CASE (&test_object_attachments));
+    return suite;
+
+    NEMIVER_CATCH_NOX
+
+    return 0;
+}
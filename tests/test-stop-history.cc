@@ -0,0 +1,311 @@
+#include "config.h"
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <glibmm.h>
+#include "common/nmv-output-log.h"
+#include "common/nmv-initializer.h"
+#include "common/nmv-exception.h"
+
+using namespace std;
+using namespace nemiver;
+using nemiver::common::Initializer;
+using nemiver::common::OutputLog;
+
+void
+test_lines ()
+{
+    OutputLog log;
+    string text;
+
+    BOOST_REQUIRE_EQUAL (log.size (), 0u);
+    BOOST_REQUIRE_EQUAL (log.num_lines (), 1u);
+
+    BOOST_REQUIRE (log.append ("hello\nwor", 9));
+    BOOST_REQUIRE (log.append ("ld!\nfoo bar\n", 12));
+#include "config.h"
+#include <vector>
+#include <map>
+#include <boost/test/unit_test.hpp>
+#include <glibmm.h>
+#include "common/nmv-initializer.h"
+#include "common/nmv-exception.h"
+#include "nmv-stop-history.h"
+
+using namespace std;
+using namespace nemiver;
+using nemiver::common::Initializer;
+using nemiver::common::Address;
+
+static IDebugger::Frame
+make_frame (const string &a_function, const string &a_address)
+{
+    IDebugger::Frame frame;
+    frame.function_name (a_function);
+    frame.address (Address (a_address));
+    return frame;
+}
+
+/// The scope of the variables of the function foo of thread 1.
+static const StopHistory::VariableScope FOO (1, "foo");
+
+static StopHistory::VariableKey
+key (const StopHistory::VariableScope &a_scope, const string &a_qname)
+{
+    return StopHistory::VariableKey (a_scope, a_qname);
+}
+
+/// \return the call stack main <- a_callee, innermost frame first.
+static vector<IDebugger::Frame>
+make_call_stack (const string &a_callee, const string &a_address)
+{
+    vector<IDebugger::Frame> frames;
+    frames.push_back (make_frame (a_callee, a_address));
+    frames.push_back (make_frame ("main", "0x400500"));
+    return frames;
+}
+
+void
+test_call_stacks ()
+{
+    StopHistory history;
+    StopHistory::Snapshot snapshot;
+
+    BOOST_REQUIRE (!history.get_snapshot (0, snapshot));
+
+    history.record_stop (IDebugger::BREAKPOINT_HIT,
+                         make_frame ("foo", "0x400600"), 1);
+    history.record_call_stack (make_call_stack ("foo", "0x400600"), 1);
+    history.record_stop (IDebugger::END_STEPPING_RANGE,
+                         make_frame ("bar", "0x400700"), 1);
+    history.record_call_stack (make_call_stack ("bar", "0x400700"), 1);
+    // A shorter listing of the same stop must not win.
+    history.record_call_stack
+        (vector<IDebugger::Frame> (1, make_frame ("bar", "0x400700")), 1);
+    // Nor the listing of a thread that did not stop.
+    history.record_call_stack (make_call_stack ("qux", "0x400900"), 2);
+    history.record_stop (IDebugger::END_STEPPING_RANGE,
+                         make_frame ("main", "0x400510"), 1);
+    BOOST_REQUIRE_EQUAL (history.size (), 3u);
+
+    BOOST_REQUIRE (history.get_snapshot (0, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.stop_number, 1u);
+    BOOST_REQUIRE_EQUAL (snapshot.reason, IDebugger::BREAKPOINT_HIT);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack.size (), 2u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[0].function_name (), "foo");
+
+    BOOST_REQUIRE (history.get_snapshot (1, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.frame.function_name (), "bar");
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack.size (), 2u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[0].function_name (), "bar");
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[1].function_name (), "main");
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[1].level (), 1);
+
+    // The call stack was not listed during the last stop.
+    BOOST_REQUIRE (history.get_snapshot (2, snapshot));
+    BOOST_REQUIRE (snapshot.call_stack.empty ());
+    BOOST_REQUIRE (!history.get_snapshot (3, snapshot));
+}
+
+void
+test_values ()
+{
+    StopHistory history;
+    StopHistory::Snapshot snapshot;
+    map<StopHistory::register_id_t, UString> registers;
+
+    // Nothing is recorded before the first stop.
+    history.record_variable_value (FOO, "i", "0");
+
+    history.record_stop (IDebugger::BREAKPOINT_HIT,
+                         make_frame ("foo", "0x400600"), 1);
+    registers[0] = "0x1";
+    registers[1] = "0x2";
+    history.record_register_values (registers);
+    history.record_variable_value (FOO, "i", "1");
+    history.record_variable_value (FOO, "s.len", "3");
+
+    history.record_stop (IDebugger::END_STEPPING_RANGE,
+                         make_frame ("foo", "0x400604"), 1);
+    registers[1] = "0x3";
+    history.record_register_values (registers);
+    history.record_variable_value (FOO, "i", "1");
+    history.record_variable_value (FOO, "s.len", "4");
+
+    BOOST_REQUIRE (history.get_snapshot (0, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.variables.size (), 2u);
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "s.len")], "3");
+    BOOST_REQUIRE_EQUAL (snapshot.changed_registers.size (), 2u);
+
+    BOOST_REQUIRE (history.get_snapshot (1, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.registers[0], "0x1");
+    BOOST_REQUIRE_EQUAL (snapshot.registers[1], "0x3");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "i")], "1");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "s.len")], "4");
+    BOOST_REQUIRE_EQUAL (snapshot.changed_registers.size (), 1u);
+    BOOST_REQUIRE_EQUAL (snapshot.changed_registers.front (), 1u);
+    BOOST_REQUIRE_EQUAL (snapshot.changed_variables.size (), 1u);
+    BOOST_REQUIRE (snapshot.changed_variables.front () == key (FOO, "s.len"));
+
+    history.clear ();
+    BOOST_REQUIRE_EQUAL (history.size (), 0u);
+}
+
+void
+test_capacity ()
+{
+    StopHistory history;
+    StopHistory::Snapshot snapshot;
+    history.capacity (2);
+
+    history.record_stop (IDebugger::BREAKPOINT_HIT,
+                         make_frame ("foo", "0x400600"), 1);
+    history.record_call_stack (make_call_stack ("foo", "0x400600"), 1);
+    history.record_variable_value (FOO, "i", "1");
+    history.record_variable_value (FOO, "j", "1");
+
+    history.record_stop (IDebugger::END_STEPPING_RANGE,
+                         make_frame ("bar", "0x400700"), 1);
+    history.record_call_stack (make_call_stack ("bar", "0x400700"), 1);
+    history.record_variable_value (FOO, "i", "2");
+
+    history.record_stop (IDebugger::END_STEPPING_RANGE,
+                         make_frame ("baz", "0x400800"), 1);
+    history.record_call_stack (make_call_stack ("baz", "0x400800"), 1);
+    history.record_variable_value (FOO, "i", "3");
+
+    // The first stop was dropped, and folded into the second one.
+    BOOST_REQUIRE_EQUAL (history.size (), 2u);
+    BOOST_REQUIRE (history.get_snapshot (0, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.stop_number, 2u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack.size (), 2u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[0].function_name (), "bar");
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[1].function_name (), "main");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "i")], "2");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "j")], "1");
+    BOOST_REQUIRE_EQUAL (snapshot.changed_variables.size (), 1u);
+
+    BOOST_REQUIRE (history.get_snapshot (1, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.stop_number, 3u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack.size (), 2u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[0].function_name (), "baz");
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[1].function_name (), "main");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "i")], "3");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "j")], "1");
+
+    history.capacity (1);
+    BOOST_REQUIRE_EQUAL (history.size (), 1u);
+    BOOST_REQUIRE (history.get_snapshot (0, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.stop_number, 3u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack.size (), 2u);
+    BOOST_REQUIRE_EQUAL (snapshot.call_stack[1].function_name (), "main");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "j")], "1");
+
+    history.capacity (0);
+    history.record_stop (IDebugger::END_STEPPING_RANGE,
+                         make_frame ("baz", "0x400804"), 1);
+    BOOST_REQUIRE_EQUAL (history.size (), 0u);
+}
+
+void
+test_scopes ()
+{
+    StopHistory history;
+    StopHistory::Snapshot snapshot;
+    StopHistory::VariableScope main_scope (1, "main");
+    StopHistory::VariableScope thread2_scope (2, "foo");
+
+    history.record_stop (IDebugger::BREAKPOINT_HIT,
+                         make_frame ("foo", "0x400600"), 1);
+    BOOST_REQUIRE_EQUAL (history.function_name (1, 0), "foo");
+    BOOST_REQUIRE_EQUAL (history.function_name (1, 1), "");
+    history.record_call_stack (make_call_stack ("foo", "0x400600"), 1);
+    BOOST_REQUIRE_EQUAL (history.function_name (1, 1), "main");
+    BOOST_REQUIRE_EQUAL (history.function_name (2, 0), "");
+
+    // The variables named i of foo, of its caller, and of the other
+    // thread are different variables.
+    history.record_variable_value (FOO, "i", "1");
+    history.record_variable_value (main_scope, "i", "10");
+    history.record_variable_value (thread2_scope, "i", "20");
+
+    history.record_stop (IDebugger::END_STEPPING_RANGE,
+                         make_frame ("foo", "0x400604"), 1);
+    history.record_variable_value (main_scope, "i", "10");
+    history.record_variable_value (FOO, "i", "2");
+
+    BOOST_REQUIRE (history.get_snapshot (1, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.variables.size (), 3u);
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "i")], "2");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (main_scope, "i")], "10");
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (thread2_scope, "i")], "20");
+    BOOST_REQUIRE_EQUAL (snapshot.changed_variables.size (), 1u);
+    BOOST_REQUIRE (snapshot.changed_variables.front () == key (FOO, "i"));
+}
+
+void
+test_keyframes ()
+{
+    const unsigned nb_stops = 200;
+    StopHistory history;
+    StopHistory::Snapshot snapshot;
+    history.capacity (150);
+
+    for (unsigned i = 1; i <= nb_stops; ++i) {
+        history.record_stop (IDebugger::END_STEPPING_RANGE,
+                             make_frame ("foo", "0x400600"), 1);
+        if (i % 3 == 0)
+            history.record_call_stack (make_call_stack ("foo", "0x400600"),
+                                       1);
+        history.record_variable_value (FOO, "i", UString::from_int (i));
+        if (i % 7 == 0)
+            history.record_variable_value (FOO, "j", UString::from_int (i));
+    }
+    BOOST_REQUIRE_EQUAL (history.size (), 150u);
+
+    // Look at the stops twice: the second time, the state of some of
+    // the stops is known already.
+    for (unsigned pass = 0; pass < 2; ++pass) {
+        for (unsigned index = 0; index < history.size (); index += 13) {
+            unsigned long stop = nb_stops - history.size () + 1 + index;
+            BOOST_REQUIRE (history.get_snapshot (index, snapshot));
+            BOOST_REQUIRE_EQUAL (snapshot.stop_number, stop);
+            BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "i")],
+                                 UString::from_int (stop));
+            BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "j")],
+                                 UString::from_int (stop - stop % 7));
+            BOOST_REQUIRE_EQUAL (snapshot.call_stack.size (),
+                                 stop % 3 ? 0u : 2u);
+        }
+    }
+
+    // Dropping old stops keeps the state of the other ones right.
+    history.capacity (10);
+    BOOST_REQUIRE (history.get_snapshot (0, snapshot));
+    BOOST_REQUIRE_EQUAL (snapshot.stop_number, nb_stops - 9);
+    BOOST_REQUIRE_EQUAL (snapshot.variables[key (FOO, "j")],
+                         UString::from_int (nb_stops - 9 - (nb_stops - 9) % 7));
+}
+
+using boost::unit_test::test_suite;
+
+NEMIVER_API test_suite*
+init_unit_test_suite (int argc, char** argv)
+{
+    if (argc || argv) {/*keep compiler happy*/}
+
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    test_suite *suite = BOOST_TEST_SUITE ("Stop history tests");
+    suite->add (BOOST_TEST_CASE (&test_call_stacks));
+    suite->add (BOOST_TEST_CASE (&test_values));
+    suite->add (BOOST_TEST_CASE (&test_capacity));
+    suite->add (BOOST_TEST_CASE (&test_scopes));
+    suite->add (BOOST_TEST_CASE (&test_keyframes));
+    return suite;
+
+    NEMIVER_CATCH_NOX
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "config.h"
+#include <iostream>
+#include <unistd.h>
+#include <signal.h>
+#include <boost/test/minimal.hpp>
+#include <glibmm.h>
+#include "common/nmv-initializer.h"
+#include "common/nmv-safe-ptr-utils.h"
+#include "common/nmv-str-utils.h"
+#include "nmv-i-debugger.h"
+#include "nmv-debugger-utils.h"
+
+// Debug fooprog through a local gdbserver, set a conditional
+// breakpoint in it, and check that the condition is evaluated by
+// gdbserver rather than by GDB.  The test is skipped if gdbserver is
+// not installed.
+
+using namespace nemiver;
+using namespace nemiver::common;
+
+Glib::RefPtr<Glib::MainLoop> loop =
+    Glib::MainLoop::create (Glib::MainContext::get_default ());
+
+// This condition is satisfied exactly once; see func4 in fooprog.cc.
+static const char *break_condition = "j == 900";
+static int nb_conditional_breakpoint_hits;
+static bool is_condition_evaluated_by_target;
+static bool program_finished;
+
+void
+on_engine_died_signal ()
+{
+    MESSAGE ("engine died");
+    loop->quit ();
+}
+
+void
+on_program_finished_signal ()
+{
+    MESSAGE ("program finished");
+    program_finished = true;
+    loop->quit ();
+}
+
+void
+on_breakpoints_set_signal (const std::map<string, IDebugger::Breakpoint> &a_breaks,
+                           const UString &/*a_cookie*/)
+{
+    std::map<string, IDebugger::Breakpoint>::const_iterator it;
+    for (it = a_breaks.begin (); it != a_breaks.end () ; ++it) {
+        if (!it->second.has_condition ())
+            continue;
+        MESSAGE ("breakpoint " << it->first
+                 << " has condition '" << it->second.condition ()
+                 << "', evaluated by the target: "
+                 << it->second.is_condition_evaluated_by_target ());
+        if (it->second.is_condition_evaluated_by_target ())
+            is_condition_evaluated_by_target = true;
+    }
+}
+
+void
+on_stopped_signal (IDebugger::StopReason a_reason,
+                   bool /*a_has_frame*/,
+                   const IDebugger::Frame &a_frame,
+                   int /*a_thread_id*/,
+                   const string &/*a_bp_num*/,
+                   const UString &/*a_cookie*/,
+                   IDebuggerSafePtr &a_debugger)
+{
+    MESSAGE ("stopped in: " << a_frame.function_name ());
+
+    // The inferior also stops when GDB connects to gdbserver; it is
+    // resumed by the do_continue queued in test_main.
+    if (a_reason != IDebugger::BREAKPOINT_HIT)
+        return;
+
+    ++nb_conditional_breakpoint_hits;
+    a_debugger->do_continue ();
+}
+
+bool
+on_timeout ()
+{
+    MESSAGE ("timed out");
+    loop->quit ();
+    return false;
+}
+
+NEMIVER_API int
+test_main (int, char **)
+{
+    std::string gdbserver = Glib::find_program_in_path ("gdbserver");
+    if (gdbserver.empty ()) {
+        MESSAGE ("gdbserver not found, skipping");
+        return 0;
+    }
+
+    Glib::Pid gdbserver_pid = 0;
+    int gdbserver_stderr = -1;
+
+    NEMIVER_TRY
+
+    Initializer::do_init ();
+
+    THROW_IF_FAIL (loop);
+
+    // Pick a port that another run of the test is unlikely to use.
+    unsigned port = 20000 + getpid () % 10000;
+    std::vector<std::string> argv;
+    argv.push_back (gdbserver);
+    argv.push_back ("localhost:" + str_utils::int_to_string (port));
+    argv.push_back ("./fooprog");
+    Glib::spawn_async_with_pipes (".", argv,
+                                  Glib::SPAWN_DO_NOT_REAP_CHILD,
+                                  sigc::slot<void> (),
+                                  &gdbserver_pid,
+                                  0, 0, &gdbserver_stderr);
+
+    // Wait for gdbserver to listen before connecting to it.  Its
+    // stderr is kept open until the end, so that it can keep
+    // writing to it.
+    std::string gdbserver_output;
+    char c = 0;
+    while (gdbserver_output.find ("Listening on port")
+           == std::string::npos
+           && read (gdbserver_stderr, &c, 1) == 1)
+        gdbserver_output += c;
+    THROW_IF_FAIL (gdbserver_output.find ("Listening on port")
+                   != std::string::npos);
+
+    IDebuggerSafePtr debugger =
+        debugger_utils::load_debugger_iface_with_confmgr ();
+
+    debugger->set_event_loop_context (loop->get_context ());
+
+    //*****************************
+    //<connect to IDebugger events>
+    //*****************************
+    debugger->engine_died_signal ().connect (&on_engine_died_signal);
+
+    debugger->program_finished_signal ().connect
+                                            (&on_program_finished_signal);
+
+    debugger->breakpoints_set_signal ().connect
+        (&on_breakpoints_set_signal);
+
+    debugger->stopped_signal ().connect
+                            (sigc::bind (&on_stopped_signal, debugger));
+
+    std::vector<UString> args, source_search_dir;
+    source_search_dir.push_back (".");
+    debugger->load_program ("fooprog", args, ".",
+                            source_search_dir, "", false);
+    debugger->attach_to_remote_target ("localhost", port);
+    debugger->set_breakpoint ("fooprog.cc", 89, break_condition);
+    debugger->do_continue ();
+
+    Glib::signal_timeout ().connect_seconds (&on_timeout, 60);
+    loop->run ();
+
+    NEMIVER_CATCH_NOX
+
+    if (gdbserver_pid) {
+        kill (gdbserver_pid, SIGKILL);
+        Glib::spawn_close_pid (gdbserver_pid);
+    }
+    if (gdbserver_stderr >= 0)
+        close (gdbserver_stderr);
+
+    BOOST_REQUIRE (program_finished);
+    BOOST_REQUIRE (is_condition_evaluated_by_target);
+    BOOST_REQUIRE (nb_conditional_breakpoint_hits == 1);
+    return 0;
+}